@@ -0,0 +1,548 @@
+/*
+ * Copyright 2023 Gleb Tolstenev
+ * yonnarge@student.21-school.ru
+ *
+ * s21_basic_matrix.h is the header file for the matrix with a generic
+ * element type of s21_matrix_oop library
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef SRC_S21_BASIC_MATRIX_H_
+#define SRC_S21_BASIC_MATRIX_H_
+
+#include <math.h>
+
+#include <algorithm>
+#include <complex>
+#include <cstddef>
+#include <cstring>
+#include <memory_resource>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "s21_gemm.h"
+#include "s21_matrix_oop.h"
+#include "s21_simd.h"
+
+/**
+ * @brief Properties of the element types of S21BasicMatrix
+ * @details kEps is the largest difference of two elements that still
+ * compare as equal, Abs() is the magnitude the difference is measured by.
+ * Types without a specialization cannot be used as elements.
+ */
+template <typename T>
+struct S21ElementTraits;
+
+template <>
+struct S21ElementTraits<double> {
+  using Real = double;
+  static constexpr Real kEps = EPS;
+  static Real Abs(double value) { return fabs(value); }
+};
+
+/* About as many units in the last place of 1.0f as EPS is of 1.0 */
+template <>
+struct S21ElementTraits<float> {
+  using Real = float;
+  static constexpr Real kEps = 1e-4f;
+  static Real Abs(float value) { return fabsf(value); }
+};
+
+template <typename R>
+struct S21ElementTraits<std::complex<R>> {
+  using Real = R;
+  static constexpr Real kEps = S21ElementTraits<R>::kEps;
+  static Real Abs(const std::complex<R>& value) { return std::abs(value); }
+};
+
+/**
+ * @brief Dense matrix of elements of type T (float, double or complex)
+ * @details The storage follows S21Matrix: one row-major block aligned to
+ * kAlignment and taken from a memory resource. Every operation is compiled
+ * for T: element-wise kernels and the product go to S21Simd and S21Gemm for
+ * float and double, where a float register holds twice the elements and a
+ * float matrix half the bytes, and to portable loops for complex numbers.
+ * Equality uses the tolerance of S21ElementTraits<T>.
+ *
+ * S21Matrix stays the matrix of doubles with the full set of operations;
+ * the conversions below move data between the two. Multiplication uses the
+ * usual rule: the columns of the left operand must match the rows of the
+ * right one.
+ */
+template <typename T>
+class S21BasicMatrix {
+ public:
+  using Traits = S21ElementTraits<T>;
+  static constexpr std::size_t kAlignment = S21Matrix::kAlignment;
+  /* T has kernels in S21Simd and S21Gemm */
+  static constexpr bool kVectorized =
+      std::is_same_v<T, float> || std::is_same_v<T, double>;
+
+ private:
+  int rows_, cols_;
+  std::pmr::memory_resource* resource_;  // Source of the elements buffer
+  T* matrix_;  // Single row-major block of rows_ * cols_ elements
+
+ private:
+  /* Memory management functions -----------------------------------------*/
+  T* NewArrayOfElements() const;
+  void DeleteArrayOfElements();
+  std::size_t Size() const { return static_cast<std::size_t>(rows_) * cols_; }
+
+  /* Help methods --------------------------------------------------------*/
+  template <typename F>
+  void ForEachRange(const F& body) const;
+
+ public:
+  /* Constructors and destructors ----------------------------------------*/
+  S21BasicMatrix(int rows, int cols,
+                 std::pmr::memory_resource* resource =
+                     std::pmr::get_default_resource());
+  S21BasicMatrix(const S21BasicMatrix& other);
+  S21BasicMatrix(S21BasicMatrix&& other) noexcept;
+  explicit S21BasicMatrix(const S21Matrix& other,
+                          std::pmr::memory_resource* resource =
+                              std::pmr::get_default_resource());
+  ~S21BasicMatrix();
+
+  /* Overloads -----------------------------------------------------------*/
+  S21BasicMatrix& operator=(const S21BasicMatrix& other);
+  S21BasicMatrix& operator=(S21BasicMatrix&& other) noexcept;
+  S21BasicMatrix operator+(const S21BasicMatrix& other) const;
+  S21BasicMatrix operator-(const S21BasicMatrix& other) const;
+  S21BasicMatrix operator*(const S21BasicMatrix& other) const;
+  S21BasicMatrix operator*(const T num) const;
+  T& operator()(int row, int col);
+  bool operator==(const S21BasicMatrix& other) const;
+  S21BasicMatrix& operator+=(const S21BasicMatrix& other);
+  S21BasicMatrix& operator-=(const S21BasicMatrix& other);
+  S21BasicMatrix& operator*=(const T num);
+  S21BasicMatrix& operator*=(const S21BasicMatrix& other);
+
+  /* Core methods --------------------------------------------------------*/
+  bool EqMatrix(const S21BasicMatrix& other) const;
+  void SumMatrix(const S21BasicMatrix& other);
+  void SubMatrix(const S21BasicMatrix& other);
+  void MulNumber(const T num);
+  void MulMatrix(const S21BasicMatrix& other);
+  S21BasicMatrix Multiply(const S21BasicMatrix& other,
+                          int accumulation = GEMM_ACCUMULATE_NATIVE) const;
+  S21BasicMatrix Transpose() const;
+  S21Matrix ToMatrix() const;
+
+  /* Accessors and mutators ---------------------------------------------*/
+  int GetRows() const { return rows_; }
+  int GetCols() const { return cols_; }
+  T GetVal(int row, int col) const {
+    return matrix_[static_cast<std::ptrdiff_t>(row) * cols_ + col];
+  }
+  T* data() { return matrix_; }
+  const T* data() const { return matrix_; }
+  std::pmr::memory_resource* GetResource() const { return resource_; }
+};
+
+using S21MatrixF = S21BasicMatrix<float>;
+using S21MatrixD = S21BasicMatrix<double>;
+using S21MatrixC = S21BasicMatrix<std::complex<double>>;
+
+/* Memory management functions --------------------------------------------*/
+
+/**
+ * @brief Allocate zeroed memory for rows_ * cols_ elements
+ */
+template <typename T>
+T* S21BasicMatrix<T>::NewArrayOfElements() const {
+  auto elements =
+      static_cast<T*>(resource_->allocate(Size() * sizeof(T), kAlignment));
+  std::fill(elements, elements + Size(), T(0));
+  return elements;
+}
+
+/**
+ * @brief Delete allocated memory for matrix elements
+ */
+template <typename T>
+void S21BasicMatrix<T>::DeleteArrayOfElements() {
+  if (matrix_) resource_->deallocate(matrix_, Size() * sizeof(T), kAlignment);
+  matrix_ = nullptr;
+}
+
+/* Help methods -----------------------------------------------------------*/
+
+/**
+ * @brief Calls body(offset, count) on element ranges that cover the matrix
+ * @details Whole rows are split between the threads of S21ThreadPool like
+ * the rows of S21Matrix
+ */
+template <typename T>
+template <typename F>
+void S21BasicMatrix<T>::ForEachRange(const F& body) const {
+  S21Matrix::ForEachRow(rows_, cols_, [&](int begin, int end) {
+    body(static_cast<std::size_t>(begin) * cols_,
+         static_cast<std::size_t>(end - begin) * cols_);
+  });
+}
+
+/* Constructors and destructors -------------------------------------------*/
+
+/**
+ * @brief Parameterized constructor, the elements are zeroed
+ * @param rows, cols - sizes of the matrix, at least 1
+ * @param resource - source of the memory for the elements
+ */
+template <typename T>
+S21BasicMatrix<T>::S21BasicMatrix(int rows, int cols,
+                                  std::pmr::memory_resource* resource) {
+  if (rows < 1)
+    throw std::invalid_argument("The number of rows is lower than 1");
+  if (cols < 1)
+    throw std::invalid_argument("The number of columns is lower than 1");
+  if (!resource) throw std::invalid_argument("The memory resource is null");
+  rows_ = rows;
+  cols_ = cols;
+  resource_ = resource;
+  matrix_ = NewArrayOfElements();
+}
+
+/**
+ * @brief Copy constructor
+ * @details Like S21Matrix, the copy takes its storage from the default
+ * resource rather than from the resource of 'other'
+ */
+template <typename T>
+S21BasicMatrix<T>::S21BasicMatrix(const S21BasicMatrix& other)
+    : S21BasicMatrix(other.rows_, other.cols_,
+                     std::pmr::get_default_resource()) {
+  std::memcpy(matrix_, other.matrix_, Size() * sizeof(T));
+}
+
+/**
+ * @brief Move constructor, takes over the storage and its resource
+ */
+template <typename T>
+S21BasicMatrix<T>::S21BasicMatrix(S21BasicMatrix&& other) noexcept
+    : rows_(other.rows_),
+      cols_(other.cols_),
+      resource_(other.resource_),
+      matrix_(other.matrix_) {
+  other.rows_ = 0;
+  other.cols_ = 0;
+  other.resource_ = std::pmr::get_default_resource();
+  other.matrix_ = nullptr;
+}
+
+/**
+ * @brief Converts a matrix of doubles, rounding every element to T
+ * @param other - the matrix that will be converted
+ * @param resource - source of the memory for the elements
+ */
+template <typename T>
+S21BasicMatrix<T>::S21BasicMatrix(const S21Matrix& other,
+                                  std::pmr::memory_resource* resource)
+    : S21BasicMatrix(other.GetRows(), other.GetCols(), resource) {
+  for (int i = 0; i < rows_; ++i) {
+    T* row = matrix_ + static_cast<std::ptrdiff_t>(i) * cols_;
+    for (int j = 0; j < cols_; ++j) row[j] = T(other.GetVal(i, j));
+  }
+}
+
+template <typename T>
+S21BasicMatrix<T>::~S21BasicMatrix() {
+  DeleteArrayOfElements();
+}
+
+/* Overloads --------------------------------------------------------------*/
+
+/**
+ * @brief Copy assignment, the matrix keeps its own resource
+ */
+template <typename T>
+S21BasicMatrix<T>& S21BasicMatrix<T>::operator=(const S21BasicMatrix& other) {
+  if (this != &other) {
+    S21BasicMatrix copy(other.rows_, other.cols_, resource_);
+    std::memcpy(copy.matrix_, other.matrix_, other.Size() * sizeof(T));
+    *this = std::move(copy);
+  }
+  return *this;
+}
+
+template <typename T>
+S21BasicMatrix<T>& S21BasicMatrix<T>::operator=(
+    S21BasicMatrix&& other) noexcept {
+  if (this != &other) {
+    DeleteArrayOfElements();
+    rows_ = other.rows_;
+    cols_ = other.cols_;
+    resource_ = other.resource_;
+    matrix_ = other.matrix_;
+
+    other.rows_ = 0;
+    other.cols_ = 0;
+    other.resource_ = std::pmr::get_default_resource();
+    other.matrix_ = nullptr;
+  }
+  return *this;
+}
+
+/**
+ * @brief Overload of '+' for matrices
+ * @param other - the matrix that will be added
+ * @return Matrix with result of addition
+ */
+template <typename T>
+S21BasicMatrix<T> S21BasicMatrix<T>::operator+(
+    const S21BasicMatrix& other) const {
+  S21BasicMatrix result(*this);
+  result.SumMatrix(other);
+  return result;
+}
+
+/**
+ * @brief Overload of '-' for matrices
+ * @param other - the matrix that will be subtracted
+ * @return Matrix with result of subtraction
+ */
+template <typename T>
+S21BasicMatrix<T> S21BasicMatrix<T>::operator-(
+    const S21BasicMatrix& other) const {
+  S21BasicMatrix result(*this);
+  result.SubMatrix(other);
+  return result;
+}
+
+/**
+ * @brief Overload of '*' for matrices, see Multiply()
+ */
+template <typename T>
+S21BasicMatrix<T> S21BasicMatrix<T>::operator*(
+    const S21BasicMatrix& other) const {
+  return Multiply(other);
+}
+
+/**
+ * @brief Overload of '*' for multiplication by a number
+ */
+template <typename T>
+S21BasicMatrix<T> S21BasicMatrix<T>::operator*(const T num) const {
+  S21BasicMatrix result(*this);
+  result.MulNumber(num);
+  return result;
+}
+
+/**
+ * Overload of '()' for indexation by matrix elements (row, column)
+ * @return The element of matrix with idexes (row, col)
+ */
+template <typename T>
+T& S21BasicMatrix<T>::operator()(int row, int col) {
+  if (row < 0 || row >= rows_ || col < 0 || col >= cols_)
+    throw std::out_of_range(
+        "Attempt to access to element of matrix by index outside of the range");
+  return matrix_[static_cast<std::ptrdiff_t>(row) * cols_ + col];
+}
+
+template <typename T>
+bool S21BasicMatrix<T>::operator==(const S21BasicMatrix& other) const {
+  return EqMatrix(other);
+}
+
+template <typename T>
+S21BasicMatrix<T>& S21BasicMatrix<T>::operator+=(const S21BasicMatrix& other) {
+  SumMatrix(other);
+  return *this;
+}
+
+template <typename T>
+S21BasicMatrix<T>& S21BasicMatrix<T>::operator-=(const S21BasicMatrix& other) {
+  SubMatrix(other);
+  return *this;
+}
+
+template <typename T>
+S21BasicMatrix<T>& S21BasicMatrix<T>::operator*=(const T num) {
+  MulNumber(num);
+  return *this;
+}
+
+template <typename T>
+S21BasicMatrix<T>& S21BasicMatrix<T>::operator*=(const S21BasicMatrix& other) {
+  MulMatrix(other);
+  return *this;
+}
+
+/* Core methods -----------------------------------------------------------*/
+
+/**
+ * Checks for matrices equality within S21ElementTraits<T>::kEps
+ * @param other - the matrix that will be compared
+ * @return true - martices is equal;
+ *         false - martices is different.
+ */
+template <typename T>
+bool S21BasicMatrix<T>::EqMatrix(const S21BasicMatrix& other) const {
+  if (rows_ != other.rows_ || cols_ != other.cols_) return false;
+  if constexpr (kVectorized) {
+    return S21Simd::Equal(matrix_, other.matrix_, Size(), Traits::kEps);
+  } else {
+    for (std::size_t i = 0; i < Size(); ++i) {
+      if (Traits::Abs(matrix_[i] - other.matrix_[i]) > Traits::kEps) {
+        return false;
+      }
+    }
+    return true;
+  }
+}
+
+/**
+ * @brief Adds 'other' to the current matrix
+ */
+template <typename T>
+void S21BasicMatrix<T>::SumMatrix(const S21BasicMatrix& other) {
+  S21Matrix::CheckSizesFor(SUM, rows_, cols_, other.rows_, other.cols_);
+  ForEachRange([&](std::size_t offset, std::size_t count) {
+    if constexpr (kVectorized) {
+      S21Simd::Add(matrix_ + offset, other.matrix_ + offset, count);
+    } else {
+      for (std::size_t i = offset; i < offset + count; ++i) {
+        matrix_[i] += other.matrix_[i];
+      }
+    }
+  });
+}
+
+/**
+ * @brief Subtracts 'other' from the current matrix
+ */
+template <typename T>
+void S21BasicMatrix<T>::SubMatrix(const S21BasicMatrix& other) {
+  S21Matrix::CheckSizesFor(SUB, rows_, cols_, other.rows_, other.cols_);
+  ForEachRange([&](std::size_t offset, std::size_t count) {
+    if constexpr (kVectorized) {
+      S21Simd::Sub(matrix_ + offset, other.matrix_ + offset, count);
+    } else {
+      for (std::size_t i = offset; i < offset + count; ++i) {
+        matrix_[i] -= other.matrix_[i];
+      }
+    }
+  });
+}
+
+/**
+ * @brief Multiplies every element by 'num'
+ */
+template <typename T>
+void S21BasicMatrix<T>::MulNumber(const T num) {
+  ForEachRange([&](std::size_t offset, std::size_t count) {
+    if constexpr (kVectorized) {
+      S21Simd::Scale(matrix_ + offset, num, count);
+    } else {
+      for (std::size_t i = offset; i < offset + count; ++i) matrix_[i] *= num;
+    }
+  });
+}
+
+/**
+ * @brief Replaces the current matrix with its product by 'other'
+ */
+template <typename T>
+void S21BasicMatrix<T>::MulMatrix(const S21BasicMatrix& other) {
+  *this = Multiply(other);
+}
+
+/**
+ * @brief Product of the current matrix and 'other'
+ * @details Float and double products run on S21Gemm. A float product may
+ * accumulate in double (GEMM_ACCUMULATE_DOUBLE) when a long inner dimension
+ * would lose too many digits in float sums; other types ignore the option.
+ * Complex products multiply row by row, each row of the result accumulates
+ * the rows of 'other' scaled by the elements of the current row.
+ * @param other - the right operand, its rows must match the columns of the
+ * current matrix
+ * @param accumulation - value of 'gemm_accumulations'
+ */
+template <typename T>
+S21BasicMatrix<T> S21BasicMatrix<T>::Multiply(const S21BasicMatrix& other,
+                                              int accumulation) const {
+  if (cols_ != other.rows_) {
+    throw std::logic_error(
+        "The multiplication of matrices was rejected. Matrices have "
+        "different sizes");
+  }
+  S21BasicMatrix result(rows_, other.cols_, resource_);
+  if constexpr (std::is_same_v<T, float>) {
+    S21Gemm(rows_, other.cols_, cols_, 1.0f, matrix_, cols_, 1, other.matrix_,
+            other.cols_, 1, 0.0f, result.matrix_, result.cols_, accumulation);
+  } else if constexpr (std::is_same_v<T, double>) {
+    S21Gemm(rows_, other.cols_, cols_, 1.0, matrix_, cols_, 1, other.matrix_,
+            other.cols_, 1, 0.0, result.matrix_, result.cols_);
+  } else {
+    int n = other.cols_;
+    S21Matrix::ForEachRow(rows_, cols_ * n, [&](int begin, int end) {
+      for (int i = begin; i < end; ++i) {
+        T* c_row = result.matrix_ + static_cast<std::ptrdiff_t>(i) * n;
+        for (int p = 0; p < cols_; ++p) {
+          T a_ip = GetVal(i, p);
+          const T* b_row = other.matrix_ + static_cast<std::ptrdiff_t>(p) * n;
+          for (int j = 0; j < n; ++j) c_row[j] += a_ip * b_row[j];
+        }
+      }
+    });
+  }
+  return result;
+}
+
+/**
+ * @brief Transposed copy of the matrix
+ * @details Copied tile by tile, so that both matrices are read and written
+ * along cache lines
+ */
+template <typename T>
+S21BasicMatrix<T> S21BasicMatrix<T>::Transpose() const {
+  constexpr int kTile = 64 / static_cast<int>(sizeof(T)) * 4;
+  S21BasicMatrix result(cols_, rows_, resource_);
+  for (int i0 = 0; i0 < rows_; i0 += kTile) {
+    int i1 = std::min(rows_, i0 + kTile);
+    for (int j0 = 0; j0 < cols_; j0 += kTile) {
+      int j1 = std::min(cols_, j0 + kTile);
+      for (int i = i0; i < i1; ++i) {
+        for (int j = j0; j < j1; ++j) {
+          result.matrix_[static_cast<std::ptrdiff_t>(j) * rows_ + i] =
+              GetVal(i, j);
+        }
+      }
+    }
+  }
+  return result;
+}
+
+/**
+ * @brief Converts the matrix to a S21Matrix of doubles
+ * @details Only real element types convert, a complex matrix would lose
+ * its imaginary parts
+ */
+template <typename T>
+S21Matrix S21BasicMatrix<T>::ToMatrix() const {
+  static_assert(std::is_arithmetic_v<T>,
+                "Only matrices of real numbers convert to S21Matrix");
+  S21Matrix result(rows_, cols_, resource_);
+  for (int i = 0; i < rows_; ++i) {
+    double* row = result.data() + static_cast<std::ptrdiff_t>(i) *
+                                      result.stride();
+    for (int j = 0; j < cols_; ++j) row[j] = static_cast<double>(GetVal(i, j));
+  }
+  return result;
+}
+
+#endif  // SRC_S21_BASIC_MATRIX_H_
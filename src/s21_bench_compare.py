@@ -0,0 +1,107 @@
+#!/usr/bin/env python3
+#
+#  Copyright 2023 Gleb Tolstenev
+#  yonnarge@student.21-school.ru
+#
+#  s21_bench_compare.py compares two Google Benchmark JSON reports of
+#  s21_matrix_oop library and flags regressions
+#
+#  Licensed under the Apache License, Version 2.0 (the "License");
+#  you may not use this file except in compliance with the License.
+#  You may obtain a copy of the License at
+#
+#      http://www.apache.org/licenses/LICENSE-2.0
+#
+#  Unless required by applicable law or agreed to in writing, software
+#  distributed under the License is distributed on an "AS IS" BASIS,
+#  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+#  See the License for the specific language governing permissions and
+#  limitations under the License.
+#
+
+"""Compares a benchmark report with a baseline report.
+
+Usage: s21_bench_compare.py BASELINE CURRENT [--threshold PERCENT]
+
+Both files are written by the benchmark binary with --benchmark_out.
+When the reports contain repetitions, the median of every benchmark is
+compared, otherwise its single run. A benchmark whose real time grew by
+more than the threshold is a regression, and the script then exits with
+status 1. Benchmarks present in only one report are listed and ignored.
+"""
+
+import argparse
+import json
+import sys
+
+TIME_UNITS = {"ns": 1.0, "us": 1e3, "ms": 1e6, "s": 1e9}
+
+
+def load_times(path):
+    """Returns {benchmark name: real time in nanoseconds}."""
+    with open(path, encoding="utf-8") as report:
+        benchmarks = json.load(report)["benchmarks"]
+
+    medians = {}
+    runs = {}
+    for bench in benchmarks:
+        if bench.get("error_occurred"):
+            continue
+        time = bench["real_time"] * TIME_UNITS[bench.get("time_unit", "ns")]
+        name = bench.get("run_name", bench["name"])
+        if bench.get("run_type") == "aggregate":
+            if bench.get("aggregate_name") == "median":
+                medians[name] = time
+        else:
+            runs.setdefault(name, time)
+    runs.update(medians)
+    return runs
+
+
+def format_time(nanoseconds):
+    for unit in ("s", "ms", "us"):
+        if nanoseconds >= TIME_UNITS[unit]:
+            return f"{nanoseconds / TIME_UNITS[unit]:.3g} {unit}"
+    return f"{nanoseconds:.3g} ns"
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("baseline", help="stored baseline report")
+    parser.add_argument("current", help="report of the current build")
+    parser.add_argument("--threshold", type=float, default=10.0,
+                        help="allowed slowdown in percent (default: 10)")
+    args = parser.parse_args()
+
+    baseline = load_times(args.baseline)
+    current = load_times(args.current)
+
+    regressions = 0
+    print(f"{'benchmark':<40}{'baseline':>12}{'current':>12}{'change':>10}")
+    for name, old in baseline.items():
+        if name not in current:
+            continue
+        new = current[name]
+        change = (new - old) / old * 100.0 if old else 0.0
+        flag = ""
+        if change > args.threshold:
+            flag = "  REGRESSION"
+            regressions += 1
+        elif change < -args.threshold:
+            flag = "  improvement"
+        print(f"{name:<40}{format_time(old):>12}{format_time(new):>12}"
+              f"{change:>+9.1f}%{flag}")
+
+    for name in sorted(set(baseline) ^ set(current)):
+        where = "baseline" if name in baseline else "current report"
+        print(f"{name}: only in the {where}")
+
+    if regressions:
+        print(f"{regressions} regression(s) over {args.threshold:g}%")
+        return 1
+    print(f"No regressions over {args.threshold:g}%")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,153 @@
+/*
+ * Copyright 2023 Gleb Tolstenev
+ * yonnarge@student.21-school.ru
+ *
+ * s21_cholesky_decomposition.cc is the source code file for the Cholesky
+ * decomposition of s21_matrix_oop library
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "s21_cholesky_decomposition.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <vector>
+
+#include "s21_gemm.h"
+#include "s21_thread_pool.h"
+
+namespace {
+
+/* Rows of the trailing update given to one call of S21Gemm; the part of
+ * every call above the diagonal is computed and not used */
+constexpr int kUpdateRows = 2 * S21CholeskyDecomposition::kBlock;
+
+/* Panels with fewer elements than this are solved on the caller */
+constexpr long kParallelElements = 1L << 14;
+
+}  // namespace
+
+/* Constructors and destructors ---------------------------------------------*/
+
+/**
+ * @brief Factorizes the matrix
+ * @param matrix - square matrix that will be factorized
+ */
+S21CholeskyDecomposition::S21CholeskyDecomposition(const S21Matrix& matrix)
+    : l_(matrix, matrix.GetResource()), positive_definite_(true) {
+  if (matrix.GetRows() != matrix.GetCols()) {
+    throw std::logic_error(
+        "The Cholesky decomposition was rejected. The matrix is not square");
+  }
+  int n = l_.GetRows();
+  std::ptrdiff_t rs = l_.stride();
+  double* a = l_.data();
+  double tolerance = 0.0;
+  for (int i = 0; i < n; ++i) {
+    tolerance = std::max(tolerance, fabs(a[i * rs + i]));
+  }
+  tolerance *= n * DBL_EPSILON;
+
+  /* Transpose of the rows below the diagonal block, L21^T, which is solved
+   * column by column and is the right operand of the update */
+  std::vector<double> panel(static_cast<std::size_t>(kBlock) * n);
+  for (int j0 = 0; j0 < n && positive_definite_; j0 += kBlock) {
+    int j1 = std::min(j0 + kBlock, n);
+    for (int j = j0; j < j1 && positive_definite_; ++j) {
+      double* a_j = a + j * rs;
+      for (int k = j0; k < j; ++k) a_j[j] -= a_j[k] * a_j[k];
+      if (a_j[j] <= tolerance) {
+        positive_definite_ = false;
+        continue;
+      }
+      a_j[j] = sqrt(a_j[j]);
+      for (int i = j + 1; i < j1; ++i) {
+        double* a_i = a + i * rs;
+        for (int k = j0; k < j; ++k) a_i[j] -= a_i[k] * a_j[k];
+        a_i[j] /= a_j[j];
+      }
+    }
+    if (!positive_definite_ || j1 == n) continue;
+
+    int kb = j1 - j0, m = n - j1;
+    for (int i = 0; i < m; ++i) {
+      const double* a_i = a + (j1 + i) * rs + j0;
+      for (int j = 0; j < kb; ++j) panel[j * m + i] = a_i[j];
+    }
+    S21ThreadPool::Instance().ParallelFor(
+        m, std::max(1L, kParallelElements / kb),
+        [&panel, a, rs, j0, kb, m](long begin, long end) {
+          S21SolveLower(kb, static_cast<int>(end - begin), false,
+                        a + j0 * rs + j0, rs, 1, panel.data() + begin, m);
+        });
+    for (int i = 0; i < m; ++i) {
+      double* a_i = a + (j1 + i) * rs + j0;
+      for (int j = 0; j < kb; ++j) a_i[j] = panel[j * m + i];
+    }
+    for (int ib = j1; ib < n; ib += kUpdateRows) {
+      int ie = std::min(ib + kUpdateRows, n);
+      S21Gemm(ie - ib, ie - j1, kb, -1.0, a + ib * rs + j0, rs, 1,
+              panel.data(), m, 1, 1.0, a + ib * rs + j1, rs);
+    }
+  }
+  for (int i = 0; i < n; ++i) {
+    std::fill(a + i * rs + i + 1, a + i * rs + n, 0.0);
+  }
+}
+
+/* Core methods -------------------------------------------------------------*/
+
+/**
+ * @brief Determinant of the factorized matrix
+ * @return Square of the product of the diagonal of L
+ */
+double S21CholeskyDecomposition::Determinant() const {
+  if (!positive_definite_) {
+    throw std::logic_error(
+        "The calculation of determinant was rejected. The matrix is not "
+        "positive definite");
+  }
+  double result = 1.0;
+  for (int i = 0; i < l_.GetRows(); ++i) {
+    result *= l_.GetVal(i, i);
+  }
+  return result * result;
+}
+
+/**
+ * @brief Solves A * X = B for the factorized A
+ * @details Solves L * L^T * X = B with two blocked triangular solves on a
+ * copy of B, every column of B is a right-hand side
+ * @param other - B, with as many rows as A
+ * @return X, with the sizes of B
+ */
+S21Matrix S21CholeskyDecomposition::Solve(const S21Matrix& other) const {
+  int n = l_.GetRows();
+  if (other.GetRows() != n) {
+    throw std::logic_error(
+        "The solution was rejected. Matrices have different sizes");
+  }
+  if (!positive_definite_) {
+    throw std::logic_error(
+        "The solution was rejected. The matrix is not positive definite");
+  }
+  S21Matrix result(other, l_.GetResource());
+  int m = result.GetCols();
+  S21SolveLower(n, m, false, l_.data(), l_.stride(), 1, result.data(),
+                result.stride());
+  S21SolveUpper(n, m, false, l_.data(), 1, l_.stride(), result.data(),
+                result.stride());
+  return result;
+}
@@ -0,0 +1,61 @@
+/*
+ * Copyright 2023 Gleb Tolstenev
+ * yonnarge@student.21-school.ru
+ *
+ * s21_cholesky_decomposition.h is the header file for the Cholesky
+ * decomposition of s21_matrix_oop library
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef SRC_S21_CHOLESKY_DECOMPOSITION_H_
+#define SRC_S21_CHOLESKY_DECOMPOSITION_H_
+
+#include "s21_matrix_oop.h"
+
+/**
+ * @brief Cholesky decomposition of a symmetric positive definite matrix,
+ * A = L * L^T
+ * @details Only the lower triangle of A is read. The matrix is factorized
+ * in blocks of kBlock columns: the diagonal block is factorized in place,
+ * the rows below it are solved against it on S21ThreadPool and the rest of
+ * the lower triangle is updated by S21Gemm. It takes half the work of the
+ * LU decomposition and needs no pivoting.
+ *
+ * A pivot that is not positive (up to n * DBL_EPSILON of the largest
+ * diagonal element) stops the factorization and marks the matrix as not
+ * positive definite; use S21LuDecomposition for such matrices.
+ */
+class S21CholeskyDecomposition {
+ public:
+  /* Width of the block columns of the factorization */
+  static constexpr int kBlock = 64;
+
+ private:
+  S21Matrix l_;
+  bool positive_definite_;
+
+ public:
+  /* Constructors and destructors ----------------------------------------*/
+  explicit S21CholeskyDecomposition(const S21Matrix& matrix);
+
+  /* Core methods --------------------------------------------------------*/
+  double Determinant() const;
+  S21Matrix Solve(const S21Matrix& other) const;
+
+  /* Accessors and mutators ---------------------------------------------*/
+  bool IsPositiveDefinite() const { return positive_definite_; }
+  const S21Matrix& GetL() const { return l_; }
+};
+
+#endif  // SRC_S21_CHOLESKY_DECOMPOSITION_H_
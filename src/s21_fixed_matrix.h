@@ -0,0 +1,461 @@
+/*
+ * Copyright 2023 Gleb Tolstenev
+ * yonnarge@student.21-school.ru
+ *
+ * s21_fixed_matrix.h is the header file for the fixed-size matrix of
+ * s21_matrix_oop library
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef SRC_S21_FIXED_MATRIX_H_
+#define SRC_S21_FIXED_MATRIX_H_
+
+#include <math.h>
+
+#include <iostream>
+#include <stdexcept>
+#include <utility>
+
+#include "s21_matrix_oop.h"
+#include "s21_matrix_text.h"
+
+/**
+ * @brief Matrix whose sizes are known at compile time
+ * @details The elements are stored inline, so the matrix lives on the stack
+ * (or inside the object that owns it) and never allocates. Loops over
+ * dimensions up to kMaxUnrolled are fully unrolled, and operands of wrong
+ * sizes are rejected by static_assert instead of the std::logic_error of
+ * S21Matrix. Multiplication uses the usual rule: the columns of the left
+ * operand must match the rows of the right one.
+ *
+ * The matrix is a S21MatrixExpr, so it converts to S21Matrix implicitly,
+ * and S21FixedMatrix(const S21Matrix&) converts back with a runtime check.
+ */
+template <int Rows, int Cols>
+class S21FixedMatrix : public S21MatrixExpr<S21FixedMatrix<Rows, Cols>> {
+  static_assert(Rows >= 1, "The number of rows is lower than 1");
+  static_assert(Cols >= 1, "The number of columns is lower than 1");
+
+ public:
+  /* Longest loop over a dimension that is unrolled completely */
+  static constexpr int kMaxUnrolled = 8;
+
+ private:
+  double matrix_[Rows * Cols];  // Row-major elements
+
+ private:
+  /* Help methods --------------------------------------------------------*/
+  template <int N, typename F>
+  static void StaticFor(const F& body);
+  template <typename F, int... I>
+  static void StaticFor(const F& body, std::integer_sequence<int, I...>);
+  template <typename F>
+  static void ForEachElement(const F& body);
+
+  template <int R, int C>
+  friend class S21FixedMatrix;
+
+ public:
+  /* Constructors and destructors ----------------------------------------*/
+  S21FixedMatrix() : matrix_() {}
+  explicit S21FixedMatrix(const S21Matrix& other);
+
+  /* Overloads -----------------------------------------------------------*/
+  template <int R, int C>
+  S21FixedMatrix operator+(const S21FixedMatrix<R, C>& other) const;
+  template <int R, int C>
+  S21FixedMatrix operator-(const S21FixedMatrix<R, C>& other) const;
+  template <int R, int C>
+  S21FixedMatrix<Rows, C> operator*(const S21FixedMatrix<R, C>& other) const;
+  S21FixedMatrix operator*(const double num) const;
+  double& operator()(int row, int col);
+  double operator()(int row, int col) const;
+  template <int R, int C>
+  bool operator==(const S21FixedMatrix<R, C>& other) const;
+  template <int R, int C>
+  S21FixedMatrix& operator+=(const S21FixedMatrix<R, C>& other);
+  template <int R, int C>
+  S21FixedMatrix& operator-=(const S21FixedMatrix<R, C>& other);
+  S21FixedMatrix& operator*=(const double num);
+  template <int R, int C>
+  S21FixedMatrix& operator*=(const S21FixedMatrix<R, C>& other);
+
+  /* Core methods --------------------------------------------------------*/
+  template <int R, int C>
+  bool EqMatrix(const S21FixedMatrix<R, C>& other) const;
+  template <int R, int C>
+  void SumMatrix(const S21FixedMatrix<R, C>& other);
+  template <int R, int C>
+  void SubMatrix(const S21FixedMatrix<R, C>& other);
+  void MulNumber(const double num);
+  template <int R, int C>
+  void MulMatrix(const S21FixedMatrix<R, C>& other);
+  S21FixedMatrix<Cols, Rows> Transpose() const;
+
+  /* Accessors and mutators ---------------------------------------------*/
+  static constexpr int GetRows() { return Rows; }
+  static constexpr int GetCols() { return Cols; }
+  double GetVal(int row, int col) const { return matrix_[row * Cols + col]; }
+  double* data() { return matrix_; }
+  const double* data() const { return matrix_; }
+
+  /* Additional methods for testing -------------------------------------*/
+  void FillByOrder();
+  void FillByEven();
+  void FillWithOne();
+  void FillWithZero();
+  void Print() const;
+};
+
+/**
+ * @brief Fixed matrices are kept by reference inside expressions too
+ */
+template <int Rows, int Cols>
+struct S21ExprOperand<S21FixedMatrix<Rows, Cols>> {
+  using type = const S21FixedMatrix<Rows, Cols>&;
+};
+
+/* Help methods -----------------------------------------------------------*/
+
+/**
+ * @brief Calls body(i) for i from 0 to N - 1
+ * @details Short loops are expanded into N calls, longer ones stay loops
+ */
+template <int Rows, int Cols>
+template <int N, typename F>
+void S21FixedMatrix<Rows, Cols>::StaticFor(const F& body) {
+  if constexpr (N <= kMaxUnrolled) {
+    StaticFor(body, std::make_integer_sequence<int, N>());
+  } else {
+    for (int i = 0; i < N; ++i) body(i);
+  }
+}
+
+template <int Rows, int Cols>
+template <typename F, int... I>
+void S21FixedMatrix<Rows, Cols>::StaticFor(const F& body,
+                                           std::integer_sequence<int, I...>) {
+  (body(I), ...);
+}
+
+/**
+ * @brief Calls body(index) for the index of every element
+ */
+template <int Rows, int Cols>
+template <typename F>
+void S21FixedMatrix<Rows, Cols>::ForEachElement(const F& body) {
+  StaticFor<Rows>([&](int i) {
+    StaticFor<Cols>([&](int j) { body(i * Cols + j); });
+  });
+}
+
+/* Constructors and destructors -------------------------------------------*/
+
+/**
+ * @brief Copies a S21Matrix of the same sizes
+ * @param other - the matrix that will be copied
+ */
+template <int Rows, int Cols>
+S21FixedMatrix<Rows, Cols>::S21FixedMatrix(const S21Matrix& other) {
+  if (other.GetRows() != Rows || other.GetCols() != Cols) {
+    throw std::invalid_argument(
+        "The sizes of the matrix differ from the fixed sizes");
+  }
+  ForEachElement([&](int index) {
+    matrix_[index] = other.GetVal(index / Cols, index % Cols);
+  });
+}
+
+/* Overloads --------------------------------------------------------------*/
+
+/**
+ * @brief Overload of '+' for matrices
+ * @param other - the matrix that will be added
+ * @return Matrix with result of addition
+ */
+template <int Rows, int Cols>
+template <int R, int C>
+S21FixedMatrix<Rows, Cols> S21FixedMatrix<Rows, Cols>::operator+(
+    const S21FixedMatrix<R, C>& other) const {
+  S21FixedMatrix result(*this);
+  result.SumMatrix(other);
+  return result;
+}
+
+/**
+ * @brief Overload of '-' for matrices
+ * @param other - the matrix that will be subtracted
+ * @return Matrix with result of subtraction
+ */
+template <int Rows, int Cols>
+template <int R, int C>
+S21FixedMatrix<Rows, Cols> S21FixedMatrix<Rows, Cols>::operator-(
+    const S21FixedMatrix<R, C>& other) const {
+  S21FixedMatrix result(*this);
+  result.SubMatrix(other);
+  return result;
+}
+
+/**
+ * @brief Overload of '*' for matrices
+ * @details Every row of the result is accumulated as a sum of the rows of
+ * 'other' scaled by the elements of the current row
+ * @param other - the matrix that will be multiplied
+ * @return Matrix with result of multiplication
+ */
+template <int Rows, int Cols>
+template <int R, int C>
+S21FixedMatrix<Rows, C> S21FixedMatrix<Rows, Cols>::operator*(
+    const S21FixedMatrix<R, C>& other) const {
+  static_assert(Cols == R,
+                "The multiplication of matrices was rejected. Matrices have "
+                "different sizes");
+  S21FixedMatrix<Rows, C> result;
+  StaticFor<Rows>([&](int i) {
+    double row[C] = {};  // Kept in registers, 'result' is written once
+    StaticFor<Cols>([&](int k) {
+      double a_ik = matrix_[i * Cols + k];
+      StaticFor<C>([&](int j) { row[j] += a_ik * other.matrix_[k * C + j]; });
+    });
+    StaticFor<C>([&](int j) { result.matrix_[i * C + j] = row[j]; });
+  });
+  return result;
+}
+
+/**
+ * @brief Overload of '*' for multiplication by a number
+ * @param num - the number by which the matrix will be multiplied
+ * @return Matrix with result of multiplication
+ */
+template <int Rows, int Cols>
+S21FixedMatrix<Rows, Cols> S21FixedMatrix<Rows, Cols>::operator*(
+    const double num) const {
+  S21FixedMatrix result(*this);
+  result.MulNumber(num);
+  return result;
+}
+
+/**
+ * Overload of '()' for indexation by matrix elements (row, column)
+ * @param row - index of row
+ * @param col - index of column
+ * @return The element of matrix with idexes (row, col)
+ */
+template <int Rows, int Cols>
+double& S21FixedMatrix<Rows, Cols>::operator()(int row, int col) {
+  if (row < 0 || row >= Rows || col < 0 || col >= Cols)
+    throw std::out_of_range(
+        "Attempt to access to element of matrix by index outside of the range");
+  return matrix_[row * Cols + col];
+}
+
+template <int Rows, int Cols>
+double S21FixedMatrix<Rows, Cols>::operator()(int row, int col) const {
+  if (row < 0 || row >= Rows || col < 0 || col >= Cols)
+    throw std::out_of_range(
+        "Attempt to access to element of matrix by index outside of the range");
+  return matrix_[row * Cols + col];
+}
+
+/**
+ * Checks for matrices equality
+ * @param other - the matrix that will be compared
+ * @return true - martices is equal;
+ *         false - martices is different.
+ */
+template <int Rows, int Cols>
+template <int R, int C>
+bool S21FixedMatrix<Rows, Cols>::operator==(
+    const S21FixedMatrix<R, C>& other) const {
+  return EqMatrix(other);
+}
+
+/**
+ * Addition assignment
+ * @param other - the matrix that will be added
+ * @return reference to the added matrix
+ */
+template <int Rows, int Cols>
+template <int R, int C>
+S21FixedMatrix<Rows, Cols>& S21FixedMatrix<Rows, Cols>::operator+=(
+    const S21FixedMatrix<R, C>& other) {
+  SumMatrix(other);
+  return *this;
+}
+
+/**
+ * Difference assignment
+ * @param other - the matrix that will be subtracted
+ * @return reference to the subtracted matrix
+ */
+template <int Rows, int Cols>
+template <int R, int C>
+S21FixedMatrix<Rows, Cols>& S21FixedMatrix<Rows, Cols>::operator-=(
+    const S21FixedMatrix<R, C>& other) {
+  SubMatrix(other);
+  return *this;
+}
+
+/**
+ * Multiplication assignment by a number
+ * @param num - the number by which the matrix will be multiplied
+ * @return reference to the multiplied matrix
+ */
+template <int Rows, int Cols>
+S21FixedMatrix<Rows, Cols>& S21FixedMatrix<Rows, Cols>::operator*=(
+    const double num) {
+  MulNumber(num);
+  return *this;
+}
+
+/**
+ * Multiplication assignment by a matrix
+ * @param other - the matrix that will be multiplied
+ * @return reference to the multiplied matrix
+ */
+template <int Rows, int Cols>
+template <int R, int C>
+S21FixedMatrix<Rows, Cols>& S21FixedMatrix<Rows, Cols>::operator*=(
+    const S21FixedMatrix<R, C>& other) {
+  MulMatrix(other);
+  return *this;
+}
+
+/* Core methods -----------------------------------------------------------*/
+
+/**
+ * @brief Checks matrices for equality with each other up to EPS
+ * @param other - the matrix that will be compared
+ */
+template <int Rows, int Cols>
+template <int R, int C>
+bool S21FixedMatrix<Rows, Cols>::EqMatrix(
+    const S21FixedMatrix<R, C>& other) const {
+  static_assert(Rows == R && Cols == C,
+                "The comparison was rejected. Matrices have different sizes");
+  bool different = false;
+  ForEachElement([&](int index) {
+    different |= fabs(matrix_[index] - other.matrix_[index]) > EPS;
+  });
+  return !different;
+}
+
+/**
+ * @brief Adds the second matrix to the current one
+ * @param other - the matrix that will be added
+ */
+template <int Rows, int Cols>
+template <int R, int C>
+void S21FixedMatrix<Rows, Cols>::SumMatrix(const S21FixedMatrix<R, C>& other) {
+  static_assert(Rows == R && Cols == C,
+                "The addition was rejected. Matrices have different sizes");
+  ForEachElement([&](int index) { matrix_[index] += other.matrix_[index]; });
+}
+
+/**
+ * @brief Subtracts another matrix from the current one
+ * @param other - the matrix that will be subtracted
+ */
+template <int Rows, int Cols>
+template <int R, int C>
+void S21FixedMatrix<Rows, Cols>::SubMatrix(const S21FixedMatrix<R, C>& other) {
+  static_assert(Rows == R && Cols == C,
+                "The subtraction was rejected. Matrices have different sizes");
+  ForEachElement([&](int index) { matrix_[index] -= other.matrix_[index]; });
+}
+
+/**
+ * @brief Multiplies the current matrix by a number
+ * @param num - the number by which the matrix will be multiplied
+ */
+template <int Rows, int Cols>
+void S21FixedMatrix<Rows, Cols>::MulNumber(const double num) {
+  ForEachElement([&](int index) { matrix_[index] *= num; });
+}
+
+/**
+ * @brief Multiplies the current matrix by the second matrix
+ * @details The result must keep the sizes of the current matrix, so
+ * 'other' has to be a square matrix of Cols x Cols
+ * @param other - the matrix that will be multiplied
+ */
+template <int Rows, int Cols>
+template <int R, int C>
+void S21FixedMatrix<Rows, Cols>::MulMatrix(const S21FixedMatrix<R, C>& other) {
+  static_assert(Cols == R && R == C,
+                "The multiplication of matrices was rejected. The result "
+                "would change the sizes of the matrix");
+  *this = *this * other;
+}
+
+/**
+ * @brief Creates a new transposed matrix from the current one and returns it
+ */
+template <int Rows, int Cols>
+S21FixedMatrix<Cols, Rows> S21FixedMatrix<Rows, Cols>::Transpose() const {
+  S21FixedMatrix<Cols, Rows> result;
+  StaticFor<Rows>([&](int i) {
+    StaticFor<Cols>([&](int j) {
+      result.matrix_[j * Rows + i] = matrix_[i * Cols + j];
+    });
+  });
+  return result;
+}
+
+/* Additional methods -----------------------------------------------------*/
+
+/**
+ * @brief Fills the matrix with numbers in order from 1 to Rows * Cols
+ */
+template <int Rows, int Cols>
+void S21FixedMatrix<Rows, Cols>::FillByOrder() {
+  ForEachElement([&](int index) { matrix_[index] = index + 1.0; });
+}
+
+/**
+ * @brief Fills the matrix with even numbers (2.0, 4.0, 6.0...)
+ */
+template <int Rows, int Cols>
+void S21FixedMatrix<Rows, Cols>::FillByEven() {
+  ForEachElement([&](int index) { matrix_[index] = (index + 1.0) * 2.0; });
+}
+
+/**
+ * @brief Fills the matrix with numbers by 1
+ */
+template <int Rows, int Cols>
+void S21FixedMatrix<Rows, Cols>::FillWithOne() {
+  ForEachElement([&](int index) { matrix_[index] = 1.0; });
+}
+
+/**
+ * @brief Fills the matrix with numbers by 0
+ */
+template <int Rows, int Cols>
+void S21FixedMatrix<Rows, Cols>::FillWithZero() {
+  ForEachElement([&](int index) { matrix_[index] = 0.0; });
+}
+
+/**
+ * @brief Print matrix
+ * @details Same output as S21Matrix::Print: rows of tab separated elements
+ * formatted by S21MatrixText, flushed once at the end
+ */
+template <int Rows, int Cols>
+void S21FixedMatrix<Rows, Cols>::Print() const {
+  S21MatrixText::Write(S21Matrix(*this), std::cout, '\t');
+  std::cout.flush();
+}
+
+#endif  // SRC_S21_FIXED_MATRIX_H_
@@ -0,0 +1,657 @@
+/*
+ * Copyright 2023 Gleb Tolstenev
+ * yonnarge@student.21-school.ru
+ *
+ * s21_gemm.cc is the source code file for the matrix multiplication kernel
+ * of s21_matrix_oop library
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "s21_gemm.h"
+
+#include <algorithm>
+#include <cstring>
+#include <new>
+#include <type_traits>
+
+#include "s21_simd.h"
+#include "s21_thread_pool.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define S21_GEMM_X86 1
+#endif
+
+namespace {
+
+/* Micro-kernels ---------------------------------------------------------*/
+
+/**
+ * @brief Signature of a micro-kernel for elements of type T
+ * @details Multiplies a packed mr x kc panel of A by a packed kc x nr panel
+ * of B and writes alpha * AB + beta * C into a full mr x nr tile of C
+ */
+template <typename T>
+using MicroKernel = void (*)(int kc, const T* a, const T* b, T* c,
+                             std::ptrdiff_t c_rs, T alpha, T beta);
+
+/**
+ * @brief Description of a micro-kernel and the block sizes tuned for it
+ * @details mr x nr is the register tile, kc x nr panels of B stay in L1,
+ * mc x kc blocks of A stay in L2 and kc x nc blocks of B stay in L3
+ */
+template <typename T>
+struct KernelInfo {
+  int mr, nr;
+  int mc, kc, nc;
+  MicroKernel<T> kernel;
+};
+
+/* Largest register tile of all the kernels, in elements */
+constexpr int kMaxTile = 12 * 32;
+
+constexpr int kGenericMr = 4;
+
+/**
+ * @brief Portable micro-kernel, vectorized by the compiler for the baseline
+ * instruction set
+ * @details Nr is chosen so that a row of the tile fills the same number of
+ * bytes for every element type
+ */
+template <typename T, int Nr>
+void KernelGeneric(int kc, const T* a, const T* b, T* c, std::ptrdiff_t c_rs,
+                   T alpha, T beta) {
+  T acc[kGenericMr][Nr] = {};
+  for (int p = 0; p < kc; ++p) {
+    for (int i = 0; i < kGenericMr; ++i) {
+      for (int j = 0; j < Nr; ++j) {
+        acc[i][j] += a[i] * b[j];
+      }
+    }
+    a += kGenericMr;
+    b += Nr;
+  }
+  for (int i = 0; i < kGenericMr; ++i) {
+    T* c_row = c + i * c_rs;
+    for (int j = 0; j < Nr; ++j) {
+      c_row[j] = beta == T(0) ? alpha * acc[i][j]
+                              : alpha * acc[i][j] + beta * c_row[j];
+    }
+  }
+}
+
+#ifdef S21_GEMM_X86
+
+constexpr int kAvx2Mr = 6;
+constexpr int kAvx2Nr = 8;
+
+/**
+ * @brief AVX2/FMA micro-kernel with a 6 x 8 tile held in 12 ymm registers
+ */
+__attribute__((target("avx2,fma"))) void KernelAvx2(
+    int kc, const double* a, const double* b, double* c, std::ptrdiff_t c_rs,
+    double alpha, double beta) {
+  __m256d acc[kAvx2Mr][2];
+  for (int i = 0; i < kAvx2Mr; ++i) {
+    acc[i][0] = _mm256_setzero_pd();
+    acc[i][1] = _mm256_setzero_pd();
+  }
+  for (int p = 0; p < kc; ++p) {
+    __m256d b0 = _mm256_load_pd(b);
+    __m256d b1 = _mm256_load_pd(b + 4);
+    for (int i = 0; i < kAvx2Mr; ++i) {
+      __m256d ai = _mm256_broadcast_sd(a + i);
+      acc[i][0] = _mm256_fmadd_pd(ai, b0, acc[i][0]);
+      acc[i][1] = _mm256_fmadd_pd(ai, b1, acc[i][1]);
+    }
+    a += kAvx2Mr;
+    b += kAvx2Nr;
+  }
+  __m256d va = _mm256_set1_pd(alpha);
+  __m256d vb = _mm256_set1_pd(beta);
+  for (int i = 0; i < kAvx2Mr; ++i) {
+    double* c_row = c + i * c_rs;
+    for (int h = 0; h < 2; ++h) {
+      __m256d r = _mm256_mul_pd(va, acc[i][h]);
+      if (beta != 0.0) {
+        r = _mm256_fmadd_pd(vb, _mm256_loadu_pd(c_row + 4 * h), r);
+      }
+      _mm256_storeu_pd(c_row + 4 * h, r);
+    }
+  }
+}
+
+/**
+ * @brief AVX2/FMA micro-kernel for floats with a 6 x 16 tile held in 12 ymm
+ * registers
+ */
+__attribute__((target("avx2,fma"))) void KernelAvx2Float(
+    int kc, const float* a, const float* b, float* c, std::ptrdiff_t c_rs,
+    float alpha, float beta) {
+  __m256 acc[kAvx2Mr][2];
+  for (int i = 0; i < kAvx2Mr; ++i) {
+    acc[i][0] = _mm256_setzero_ps();
+    acc[i][1] = _mm256_setzero_ps();
+  }
+  for (int p = 0; p < kc; ++p) {
+    __m256 b0 = _mm256_load_ps(b);
+    __m256 b1 = _mm256_load_ps(b + 8);
+    for (int i = 0; i < kAvx2Mr; ++i) {
+      __m256 ai = _mm256_broadcast_ss(a + i);
+      acc[i][0] = _mm256_fmadd_ps(ai, b0, acc[i][0]);
+      acc[i][1] = _mm256_fmadd_ps(ai, b1, acc[i][1]);
+    }
+    a += kAvx2Mr;
+    b += 2 * kAvx2Nr;
+  }
+  __m256 va = _mm256_set1_ps(alpha);
+  __m256 vb = _mm256_set1_ps(beta);
+  for (int i = 0; i < kAvx2Mr; ++i) {
+    float* c_row = c + i * c_rs;
+    for (int h = 0; h < 2; ++h) {
+      __m256 r = _mm256_mul_ps(va, acc[i][h]);
+      if (beta != 0.0f) {
+        r = _mm256_fmadd_ps(vb, _mm256_loadu_ps(c_row + 8 * h), r);
+      }
+      _mm256_storeu_ps(c_row + 8 * h, r);
+    }
+  }
+}
+
+constexpr int kAvx512Mr = 12;
+constexpr int kAvx512Nr = 16;
+
+/**
+ * @brief AVX-512 micro-kernel with a 12 x 16 tile held in 24 zmm registers
+ */
+__attribute__((target("avx512f"))) void KernelAvx512(
+    int kc, const double* a, const double* b, double* c, std::ptrdiff_t c_rs,
+    double alpha, double beta) {
+  __m512d acc[kAvx512Mr][2];
+  for (int i = 0; i < kAvx512Mr; ++i) {
+    acc[i][0] = _mm512_setzero_pd();
+    acc[i][1] = _mm512_setzero_pd();
+  }
+  for (int p = 0; p < kc; ++p) {
+    __m512d b0 = _mm512_load_pd(b);
+    __m512d b1 = _mm512_load_pd(b + 8);
+    for (int i = 0; i < kAvx512Mr; ++i) {
+      __m512d ai = _mm512_set1_pd(a[i]);
+      acc[i][0] = _mm512_fmadd_pd(ai, b0, acc[i][0]);
+      acc[i][1] = _mm512_fmadd_pd(ai, b1, acc[i][1]);
+    }
+    a += kAvx512Mr;
+    b += kAvx512Nr;
+  }
+  __m512d va = _mm512_set1_pd(alpha);
+  __m512d vb = _mm512_set1_pd(beta);
+  for (int i = 0; i < kAvx512Mr; ++i) {
+    double* c_row = c + i * c_rs;
+    for (int h = 0; h < 2; ++h) {
+      __m512d r = _mm512_mul_pd(va, acc[i][h]);
+      if (beta != 0.0) {
+        r = _mm512_fmadd_pd(vb, _mm512_loadu_pd(c_row + 8 * h), r);
+      }
+      _mm512_storeu_pd(c_row + 8 * h, r);
+    }
+  }
+}
+
+/**
+ * @brief AVX-512 micro-kernel for floats with a 12 x 32 tile held in 24 zmm
+ * registers
+ */
+__attribute__((target("avx512f"))) void KernelAvx512Float(
+    int kc, const float* a, const float* b, float* c, std::ptrdiff_t c_rs,
+    float alpha, float beta) {
+  __m512 acc[kAvx512Mr][2];
+  for (int i = 0; i < kAvx512Mr; ++i) {
+    acc[i][0] = _mm512_setzero_ps();
+    acc[i][1] = _mm512_setzero_ps();
+  }
+  for (int p = 0; p < kc; ++p) {
+    __m512 b0 = _mm512_load_ps(b);
+    __m512 b1 = _mm512_load_ps(b + 16);
+    for (int i = 0; i < kAvx512Mr; ++i) {
+      __m512 ai = _mm512_set1_ps(a[i]);
+      acc[i][0] = _mm512_fmadd_ps(ai, b0, acc[i][0]);
+      acc[i][1] = _mm512_fmadd_ps(ai, b1, acc[i][1]);
+    }
+    a += kAvx512Mr;
+    b += 2 * kAvx512Nr;
+  }
+  __m512 va = _mm512_set1_ps(alpha);
+  __m512 vb = _mm512_set1_ps(beta);
+  for (int i = 0; i < kAvx512Mr; ++i) {
+    float* c_row = c + i * c_rs;
+    for (int h = 0; h < 2; ++h) {
+      __m512 r = _mm512_mul_ps(va, acc[i][h]);
+      if (beta != 0.0f) {
+        r = _mm512_fmadd_ps(vb, _mm512_loadu_ps(c_row + 16 * h), r);
+      }
+      _mm512_storeu_ps(c_row + 16 * h, r);
+    }
+  }
+}
+
+#endif  // S21_GEMM_X86
+
+/**
+ * @brief Returns the micro-kernel for elements of type T and the SIMD level
+ * chosen by S21Simd
+ */
+template <typename T>
+const KernelInfo<T>& Kernel();
+
+template <>
+const KernelInfo<double>& Kernel<double>() {
+  static const KernelInfo<double> kGeneric = {
+      kGenericMr, 8, 128, 256, 4096, KernelGeneric<double, 8>};
+#ifdef S21_GEMM_X86
+  static const KernelInfo<double> kAvx2 = {kAvx2Mr, kAvx2Nr, 120,
+                                           256,     4080,    KernelAvx2};
+  static const KernelInfo<double> kAvx512 = {
+      kAvx512Mr, kAvx512Nr, 144, 256, 4080, KernelAvx512};
+  int level = S21Simd::GetLevel();
+  if (level == SIMD_AVX512) return kAvx512;
+  if (level == SIMD_AVX2) return kAvx2;
+#endif
+  return kGeneric;
+}
+
+/* A float tile is as many bytes as a double tile with twice the columns, so
+ * the blocks keep the same footprint in the caches */
+template <>
+const KernelInfo<float>& Kernel<float>() {
+  static const KernelInfo<float> kGeneric = {
+      kGenericMr, 16, 128, 256, 4096, KernelGeneric<float, 16>};
+#ifdef S21_GEMM_X86
+  static const KernelInfo<float> kAvx2 = {
+      kAvx2Mr, 2 * kAvx2Nr, 120, 256, 4096, KernelAvx2Float};
+  static const KernelInfo<float> kAvx512 = {
+      kAvx512Mr, 2 * kAvx512Nr, 144, 256, 4096, KernelAvx512Float};
+  int level = S21Simd::GetLevel();
+  if (level == SIMD_AVX512) return kAvx512;
+  if (level == SIMD_AVX2) return kAvx2;
+#endif
+  return kGeneric;
+}
+
+/* Packing ---------------------------------------------------------------*/
+
+/**
+ * @brief Growable aligned scratch buffer owned by one thread
+ */
+template <typename T>
+class PackBuffer {
+ public:
+  PackBuffer() = default;
+  PackBuffer(const PackBuffer&) = delete;
+  PackBuffer& operator=(const PackBuffer&) = delete;
+  ~PackBuffer() { Release(); }
+
+  T* Reserve(std::size_t count) {
+    if (count > capacity_) {
+      Release();
+      data_ = static_cast<T*>(
+          ::operator new(count * sizeof(T), std::align_val_t(kAlign)));
+      capacity_ = count;
+    }
+    return data_;
+  }
+
+ private:
+  static constexpr std::size_t kAlign = 64;
+
+  void Release() {
+    if (data_) ::operator delete(data_, std::align_val_t(kAlign));
+    data_ = nullptr;
+    capacity_ = 0;
+  }
+
+  T* data_ = nullptr;
+  std::size_t capacity_ = 0;
+};
+
+/**
+ * @brief Packs an mc x kc block of A into consecutive mr-row panels
+ * @details Inside a panel the mr elements of one column are adjacent, rows
+ * past the end of the block are padded with zeros. Elements are converted
+ * to the type of the kernel on the way.
+ */
+template <typename Acc, typename T>
+void PackA(int mc, int kc, const T* a, std::ptrdiff_t rs, std::ptrdiff_t cs,
+           int mr, Acc* packed) {
+  for (int ir = 0; ir < mc; ir += mr) {
+    int rows = std::min(mr, mc - ir);
+    const T* panel = a + ir * rs;
+    for (int p = 0; p < kc; ++p) {
+      const T* col = panel + p * cs;
+      int i = 0;
+      for (; i < rows; ++i) packed[i] = col[i * rs];
+      for (; i < mr; ++i) packed[i] = Acc(0);
+      packed += mr;
+    }
+  }
+}
+
+/**
+ * @brief Packs a kc x nc block of B into consecutive nr-column panels
+ * @details Inside a panel the nr elements of one row are adjacent, columns
+ * past the end of the block are padded with zeros. Elements are converted
+ * to the type of the kernel on the way.
+ */
+template <typename Acc, typename T>
+void PackB(int kc, int nc, const T* b, std::ptrdiff_t rs, std::ptrdiff_t cs,
+           int nr, Acc* packed) {
+  for (int jr = 0; jr < nc; jr += nr) {
+    int cols = std::min(nr, nc - jr);
+    const T* panel = b + jr * cs;
+    for (int p = 0; p < kc; ++p) {
+      const T* row = panel + p * rs;
+      int j = 0;
+      if constexpr (std::is_same_v<Acc, T>) {
+        if (cs == 1) {
+          std::memcpy(packed, row, cols * sizeof(T));
+          j = cols;
+        }
+      }
+      for (; j < cols; ++j) packed[j] = row[j * cs];
+      for (; j < nr; ++j) packed[j] = Acc(0);
+      packed += nr;
+    }
+  }
+}
+
+/* Drivers ---------------------------------------------------------------*/
+
+/**
+ * @brief Multiplies packed mc x kc block of A by packed kc x nc block of B
+ * @details Full tiles are written straight into C, tiles cut by the edge of
+ * the matrix go through a scratch tile first
+ */
+template <typename T>
+void MacroKernel(const KernelInfo<T>& info, int mc, int nc, int kc, T alpha,
+                 const T* a_packed, const T* b_packed, T beta, T* c,
+                 std::ptrdiff_t c_rs) {
+  alignas(64) T edge[kMaxTile];
+  for (int jr = 0; jr < nc; jr += info.nr) {
+    int cols = std::min(info.nr, nc - jr);
+    const T* b_panel = b_packed + static_cast<std::ptrdiff_t>(jr) * kc;
+    for (int ir = 0; ir < mc; ir += info.mr) {
+      int rows = std::min(info.mr, mc - ir);
+      const T* a_panel = a_packed + static_cast<std::ptrdiff_t>(ir) * kc;
+      T* c_tile = c + ir * c_rs + jr;
+      if (rows == info.mr && cols == info.nr) {
+        info.kernel(kc, a_panel, b_panel, c_tile, c_rs, alpha, beta);
+      } else {
+        info.kernel(kc, a_panel, b_panel, edge, info.nr, alpha, T(0));
+        for (int i = 0; i < rows; ++i) {
+          T* c_row = c_tile + i * c_rs;
+          const T* e_row = edge + i * info.nr;
+          for (int j = 0; j < cols; ++j) {
+            c_row[j] = beta == T(0) ? e_row[j] : e_row[j] + beta * c_row[j];
+          }
+        }
+      }
+    }
+  }
+}
+
+/**
+ * @brief Straightforward product for operands too small to amortize packing
+ * @details With a wider accumulator every element of C is one dot product
+ * summed in Acc
+ */
+template <typename Acc, typename T>
+void SmallGemm(int m, int n, int k, Acc alpha, const T* a, std::ptrdiff_t a_rs,
+               std::ptrdiff_t a_cs, const T* b, std::ptrdiff_t b_rs,
+               std::ptrdiff_t b_cs, Acc beta, T* c, std::ptrdiff_t c_rs) {
+  for (int i = 0; i < m; ++i) {
+    T* c_row = c + i * c_rs;
+    if constexpr (std::is_same_v<Acc, T>) {
+      if (beta == T(0)) {
+        for (int j = 0; j < n; ++j) c_row[j] = T(0);
+      } else if (beta != T(1)) {
+        for (int j = 0; j < n; ++j) c_row[j] *= beta;
+      }
+      for (int p = 0; p < k; ++p) {
+        T a_ip = alpha * a[i * a_rs + p * a_cs];
+        const T* b_row = b + p * b_rs;
+        for (int j = 0; j < n; ++j) c_row[j] += a_ip * b_row[j * b_cs];
+      }
+    } else {
+      for (int j = 0; j < n; ++j) {
+        Acc sum = 0;
+        for (int p = 0; p < k; ++p) {
+          sum += Acc(a[i * a_rs + p * a_cs]) * Acc(b[p * b_rs + j * b_cs]);
+        }
+        Acc value =
+            beta == Acc(0) ? alpha * sum : alpha * sum + beta * c_row[j];
+        c_row[j] = static_cast<T>(value);
+      }
+    }
+  }
+}
+
+/* Products with fewer multiply-adds than this skip packing */
+constexpr long kSmallGemmVolume = 16 * 16 * 16;
+
+/* Products with fewer multiply-adds than this stay on one thread */
+constexpr long kParallelGemmVolume = 128 * 128 * 128;
+
+/**
+ * @brief Cache-blocked product of one block of C on the calling thread
+ * @details When the kernel works on a wider type than the elements (Acc is
+ * not T) every mc x nc block of C is summed over the whole of k in a
+ * scratch block of Acc and rounded to T once. The panels of B are packed
+ * again for every block of A in that case, which costs a 1 / mc share of
+ * the multiply-adds.
+ */
+template <typename Acc, typename T>
+void GemmBlocked(const KernelInfo<Acc>& info, int m, int n, int k, Acc alpha,
+                 const T* a, std::ptrdiff_t a_rs, std::ptrdiff_t a_cs,
+                 const T* b, std::ptrdiff_t b_rs, std::ptrdiff_t b_cs,
+                 Acc beta, T* c, std::ptrdiff_t c_rs) {
+  thread_local PackBuffer<Acc> a_buffer;
+  thread_local PackBuffer<Acc> b_buffer;
+  int nc_max = std::min(info.nc, (n + info.nr - 1) / info.nr * info.nr);
+  int kc_max = std::min(info.kc, k);
+  int mc_max = std::min(info.mc, (m + info.mr - 1) / info.mr * info.mr);
+  Acc* a_packed = a_buffer.Reserve(static_cast<std::size_t>(mc_max) * kc_max);
+  Acc* b_packed = b_buffer.Reserve(static_cast<std::size_t>(nc_max) * kc_max);
+
+  if constexpr (std::is_same_v<Acc, T>) {
+    for (int jc = 0; jc < n; jc += info.nc) {
+      int nc = std::min(info.nc, n - jc);
+      for (int pc = 0; pc < k; pc += info.kc) {
+        int kc = std::min(info.kc, k - pc);
+        T beta_block = pc == 0 ? beta : T(1);
+        PackB(kc, nc, b + pc * b_rs + jc * b_cs, b_rs, b_cs, info.nr,
+              b_packed);
+        for (int ic = 0; ic < m; ic += info.mc) {
+          int mc = std::min(info.mc, m - ic);
+          PackA(mc, kc, a + ic * a_rs + pc * a_cs, a_rs, a_cs, info.mr,
+                a_packed);
+          MacroKernel(info, mc, nc, kc, alpha, a_packed, b_packed, beta_block,
+                      c + ic * c_rs + jc, c_rs);
+        }
+      }
+    }
+  } else {
+    thread_local PackBuffer<Acc> c_buffer;
+    Acc* c_wide = c_buffer.Reserve(static_cast<std::size_t>(mc_max) * nc_max);
+    for (int jc = 0; jc < n; jc += info.nc) {
+      int nc = std::min(info.nc, n - jc);
+      for (int ic = 0; ic < m; ic += info.mc) {
+        int mc = std::min(info.mc, m - ic);
+        for (int pc = 0; pc < k; pc += info.kc) {
+          int kc = std::min(info.kc, k - pc);
+          PackB(kc, nc, b + pc * b_rs + jc * b_cs, b_rs, b_cs, info.nr,
+                b_packed);
+          PackA(mc, kc, a + ic * a_rs + pc * a_cs, a_rs, a_cs, info.mr,
+                a_packed);
+          MacroKernel(info, mc, nc, kc, alpha, a_packed, b_packed,
+                      pc == 0 ? Acc(0) : Acc(1), c_wide, nc_max);
+        }
+        for (int i = 0; i < mc; ++i) {
+          T* c_row = c + (ic + i) * c_rs + jc;
+          const Acc* w_row = c_wide + static_cast<std::ptrdiff_t>(i) * nc_max;
+          for (int j = 0; j < nc; ++j) {
+            Acc value =
+                beta == Acc(0) ? w_row[j] : w_row[j] + beta * c_row[j];
+            c_row[j] = static_cast<T>(value);
+          }
+        }
+      }
+    }
+  }
+}
+
+/**
+ * @brief Splits C into a grid of tiles and multiplies them in parallel
+ * @details Tiles are multiples of the register tile and are shrunk until
+ * there are several tiles per thread, so that stealing can even out the
+ * load. Every tile packs its own panels of A and B.
+ */
+template <typename Acc, typename T>
+void GemmParallel(const KernelInfo<Acc>& info, int m, int n, int k, Acc alpha,
+                  const T* a, std::ptrdiff_t a_rs, std::ptrdiff_t a_cs,
+                  const T* b, std::ptrdiff_t b_rs, std::ptrdiff_t b_cs,
+                  Acc beta, T* c, std::ptrdiff_t c_rs) {
+  S21ThreadPool& pool = S21ThreadPool::Instance();
+  long target = 4L * pool.GetNumThreads();
+  auto round_up = [](int value, int step) {
+    return (value + step - 1) / step * step;
+  };
+  int tile_m = std::min(info.mc, round_up(m, info.mr));
+  int tile_n = std::min(info.nc, round_up(n, info.nr));
+  auto tiles = [&] {
+    return static_cast<long>((m + tile_m - 1) / tile_m) *
+           ((n + tile_n - 1) / tile_n);
+  };
+  while (tiles() < target && tile_n > 4 * info.nr) {
+    tile_n = round_up(tile_n / 2, info.nr);
+  }
+  while (tiles() < target && tile_m > info.mr) {
+    tile_m = round_up(tile_m / 2, info.mr);
+  }
+  int tiles_n = (n + tile_n - 1) / tile_n;
+  pool.ParallelFor(tiles(), 1, [&](long begin, long end) {
+    for (long t = begin; t < end; ++t) {
+      int i0 = static_cast<int>(t / tiles_n) * tile_m;
+      int j0 = static_cast<int>(t % tiles_n) * tile_n;
+      GemmBlocked(info, std::min(tile_m, m - i0), std::min(tile_n, n - j0), k,
+                  alpha, a + i0 * a_rs, a_rs, a_cs, b + j0 * b_cs, b_rs, b_cs,
+                  beta, c + i0 * c_rs + j0, c_rs);
+    }
+  });
+}
+
+/**
+ * @brief Picks the path of the product by its volume
+ * @details Elements are stored as T and multiplied by the kernels for Acc
+ */
+template <typename Acc, typename T>
+void Gemm(int m, int n, int k, Acc alpha, const T* a, std::ptrdiff_t a_rs,
+          std::ptrdiff_t a_cs, const T* b, std::ptrdiff_t b_rs,
+          std::ptrdiff_t b_cs, Acc beta, T* c, std::ptrdiff_t c_rs) {
+  if (m <= 0 || n <= 0) return;
+  if (k <= 0 || alpha == Acc(0)) {
+    SmallGemm(m, n, 0, alpha, a, a_rs, a_cs, b, b_rs, b_cs, beta, c, c_rs);
+    return;
+  }
+  long volume = static_cast<long>(m) * n * k;
+  if (volume <= kSmallGemmVolume) {
+    SmallGemm(m, n, k, alpha, a, a_rs, a_cs, b, b_rs, b_cs, beta, c, c_rs);
+  } else if (volume < kParallelGemmVolume ||
+             S21ThreadPool::Instance().GetNumThreads() < 2) {
+    GemmBlocked(Kernel<Acc>(), m, n, k, alpha, a, a_rs, a_cs, b, b_rs, b_cs,
+                beta, c, c_rs);
+  } else {
+    GemmParallel(Kernel<Acc>(), m, n, k, alpha, a, a_rs, a_cs, b, b_rs, b_cs,
+                 beta, c, c_rs);
+  }
+}
+
+/* Side of the diagonal blocks of the triangular solves */
+constexpr int kTriangularBlock = 64;
+
+}  // namespace
+
+void S21Gemm(int m, int n, int k, double alpha, const double* a,
+             std::ptrdiff_t a_rs, std::ptrdiff_t a_cs, const double* b,
+             std::ptrdiff_t b_rs, std::ptrdiff_t b_cs, double beta, double* c,
+             std::ptrdiff_t c_rs) {
+  Gemm(m, n, k, alpha, a, a_rs, a_cs, b, b_rs, b_cs, beta, c, c_rs);
+}
+
+void S21Gemm(int m, int n, int k, float alpha, const float* a,
+             std::ptrdiff_t a_rs, std::ptrdiff_t a_cs, const float* b,
+             std::ptrdiff_t b_rs, std::ptrdiff_t b_cs, float beta, float* c,
+             std::ptrdiff_t c_rs, int accumulation) {
+  if (accumulation == GEMM_ACCUMULATE_DOUBLE) {
+    Gemm<double>(m, n, k, alpha, a, a_rs, a_cs, b, b_rs, b_cs, beta, c, c_rs);
+  } else {
+    Gemm<float>(m, n, k, alpha, a, a_rs, a_cs, b, b_rs, b_cs, beta, c, c_rs);
+  }
+}
+
+void S21SolveLower(int n, int m, bool unit_diagonal, const double* l,
+                   std::ptrdiff_t l_rs, std::ptrdiff_t l_cs, double* b,
+                   std::ptrdiff_t b_rs) {
+  for (int ib = 0; ib < n; ib += kTriangularBlock) {
+    int ie = std::min(ib + kTriangularBlock, n);
+    for (int i = ib; i < ie; ++i) {
+      double* b_i = b + i * b_rs;
+      for (int k = ib; k < i; ++k) {
+        double l_ik = l[i * l_rs + k * l_cs];
+        const double* b_k = b + k * b_rs;
+        for (int j = 0; j < m; ++j) b_i[j] -= l_ik * b_k[j];
+      }
+      if (!unit_diagonal) {
+        double l_ii = l[i * l_rs + i * l_cs];
+        for (int j = 0; j < m; ++j) b_i[j] /= l_ii;
+      }
+    }
+    if (ie < n) {
+      S21Gemm(n - ie, m, ie - ib, -1.0, l + ie * l_rs + ib * l_cs, l_rs, l_cs,
+              b + ib * b_rs, b_rs, 1, 1.0, b + ie * b_rs, b_rs);
+    }
+  }
+}
+
+void S21SolveUpper(int n, int m, bool unit_diagonal, const double* u,
+                   std::ptrdiff_t u_rs, std::ptrdiff_t u_cs, double* b,
+                   std::ptrdiff_t b_rs) {
+  for (int ie = n; ie > 0; ie -= kTriangularBlock) {
+    int ib = std::max(ie - kTriangularBlock, 0);
+    for (int i = ie - 1; i >= ib; --i) {
+      double* b_i = b + i * b_rs;
+      for (int k = i + 1; k < ie; ++k) {
+        double u_ik = u[i * u_rs + k * u_cs];
+        const double* b_k = b + k * b_rs;
+        for (int j = 0; j < m; ++j) b_i[j] -= u_ik * b_k[j];
+      }
+      if (!unit_diagonal) {
+        double u_ii = u[i * u_rs + i * u_cs];
+        for (int j = 0; j < m; ++j) b_i[j] /= u_ii;
+      }
+    }
+    if (ib > 0) {
+      S21Gemm(ib, m, ie - ib, -1.0, u + ib * u_cs, u_rs, u_cs, b + ib * b_rs,
+              b_rs, 1, 1.0, b, b_rs);
+    }
+  }
+}
@@ -0,0 +1,93 @@
+/*
+ * Copyright 2023 Gleb Tolstenev
+ * yonnarge@student.21-school.ru
+ *
+ * s21_gemm.h is the header file for the matrix multiplication kernel of
+ * s21_matrix_oop library
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef SRC_S21_GEMM_H_
+#define SRC_S21_GEMM_H_
+
+#include <cstddef>
+
+/**
+ * @brief Precision of the sums of the float product
+ */
+enum gemm_accumulations {
+  GEMM_ACCUMULATE_NATIVE = 0,  // Sums in the type of the elements
+  GEMM_ACCUMULATE_DOUBLE = 1,  // Sums in double, rounded once per element
+  NUMBER_OF_GEMM_ACCUMULATIONS  // To get amount of elements of enum
+};
+
+/**
+ * @brief Computes C = alpha * A * B + beta * C
+ * @details A is m x k, B is k x n and C is m x n. Every operand is
+ * addressed through its own row and column strides (in elements), so
+ * transposed operands are passed by swapping the strides of A or B.
+ * Operands are packed into cache-sized panels and multiplied by a register
+ * tiled micro-kernel for the SIMD level chosen by S21Simd. Large products
+ * are split into tiles of C that run on the threads of S21ThreadPool. When
+ * beta is 0 the previous contents of C are never read.
+ * @param m, n, k - dimensions of the product
+ * @param alpha - scale of the product A * B
+ * @param a, a_rs, a_cs - first element, row and column strides of A
+ * @param b, b_rs, b_cs - first element, row and column strides of B
+ * @param beta - scale of the previous contents of C
+ * @param c, c_rs - first element and row stride of the row-major C
+ */
+void S21Gemm(int m, int n, int k, double alpha, const double* a,
+             std::ptrdiff_t a_rs, std::ptrdiff_t a_cs, const double* b,
+             std::ptrdiff_t b_rs, std::ptrdiff_t b_cs, double beta, double* c,
+             std::ptrdiff_t c_rs);
+
+/**
+ * @brief Computes C = alpha * A * B + beta * C for floats
+ * @details Same as the product of doubles with kernels that hold twice as
+ * many elements per register. With GEMM_ACCUMULATE_DOUBLE the panels are
+ * widened to double while they are packed and multiplied by the kernels for
+ * doubles, so the operands keep half the memory traffic while the sums lose
+ * no more than one rounding per element of C.
+ * @param accumulation - value of 'gemm_accumulations'
+ */
+void S21Gemm(int m, int n, int k, float alpha, const float* a,
+             std::ptrdiff_t a_rs, std::ptrdiff_t a_cs, const float* b,
+             std::ptrdiff_t b_rs, std::ptrdiff_t b_cs, float beta, float* c,
+             std::ptrdiff_t c_rs, int accumulation = GEMM_ACCUMULATE_NATIVE);
+
+/**
+ * @brief Replaces B with L^-1 * B, L is lower triangular
+ * @details L is solved in diagonal blocks, the rows below every block are
+ * updated by S21Gemm, so the cost of large solves is in the product
+ * @param n - size of L and number of rows of B
+ * @param m - number of columns of B
+ * @param unit_diagonal - the diagonal of L is taken as 1 and is not read
+ * @param l, l_rs, l_cs - first element, row and column strides of L
+ * @param b, b_rs - first element and row stride of the row-major B
+ */
+void S21SolveLower(int n, int m, bool unit_diagonal, const double* l,
+                   std::ptrdiff_t l_rs, std::ptrdiff_t l_cs, double* b,
+                   std::ptrdiff_t b_rs);
+
+/**
+ * @brief Replaces B with U^-1 * B, U is upper triangular
+ * @details Same as S21SolveLower() from the last row up
+ * @param u, u_rs, u_cs - first element, row and column strides of U
+ */
+void S21SolveUpper(int n, int m, bool unit_diagonal, const double* u,
+                   std::ptrdiff_t u_rs, std::ptrdiff_t u_cs, double* b,
+                   std::ptrdiff_t b_rs);
+
+#endif  // SRC_S21_GEMM_H_
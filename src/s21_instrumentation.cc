@@ -0,0 +1,238 @@
+/*
+ * Copyright 2023 Gleb Tolstenev
+ * yonnarge@student.21-school.ru
+ *
+ * s21_instrumentation.cc is the source code file for the operation counters
+ * of s21_matrix_oop library
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "s21_instrumentation.h"
+
+#include <atomic>
+#include <stdexcept>
+
+namespace {
+
+struct Counters {
+  std::atomic<std::uint64_t> calls;
+  std::atomic<std::uint64_t> nanoseconds;
+  std::atomic<std::uint64_t> flops;
+  std::atomic<std::uint64_t> bytes;
+  std::atomic<std::uint64_t> allocations;
+  std::atomic<std::uint64_t> allocated_bytes;
+  std::atomic<std::uint64_t> histogram[kInstrumentationBuckets];
+};
+
+/* Zero-initialized before any constructor runs, so matrices with static
+ * storage duration may be recorded too */
+Counters counters[NUMBER_OF_INSTRUMENTED_OPERATIONS];
+
+/* Innermost operation running on this thread */
+thread_local S21InstrumentationScope* current_scope = nullptr;
+
+const char* const kNames[NUMBER_OF_INSTRUMENTED_OPERATIONS] = {
+    "Other",           "Construct",         "Copy",
+    "CopyAssignment",  "Expression",        "EqMatrix",
+    "SumMatrix",       "SubMatrix",         "MulNumber",
+    "MulMatrix",       "MulMatrixStrassen", "Product",
+    "Transpose",       "TransposeInPlace",  "CalcComplements",
+    "Determinant",     "InverseMatrix",     "Gemm",
+    "Solve",           "Gemv",              "Ger"};
+
+void Add(std::atomic<std::uint64_t>* counter, std::uint64_t value) {
+  counter->fetch_add(value, std::memory_order_relaxed);
+}
+
+std::uint64_t Load(const std::atomic<std::uint64_t>& counter) {
+  return counter.load(std::memory_order_relaxed);
+}
+
+int BucketOf(std::uint64_t nanoseconds) {
+  int bucket = 0;
+  while (nanoseconds >>= 1) ++bucket;
+  return bucket < kInstrumentationBuckets ? bucket
+                                          : kInstrumentationBuckets - 1;
+}
+
+void AppendField(std::string* json, const char* name, std::uint64_t value) {
+  *json += "\"";
+  *json += name;
+  *json += "\": ";
+  *json += std::to_string(value);
+  *json += ", ";
+}
+
+}  // namespace
+
+/* S21Instrumentation -------------------------------------------------------*/
+
+/**
+ * @brief Tells whether the library was compiled with S21_INSTRUMENTATION
+ */
+bool S21Instrumentation::Enabled() {
+#ifdef S21_INSTRUMENTATION
+  return true;
+#else
+  return false;
+#endif
+}
+
+/**
+ * @brief Copies the counters of every operation
+ * @return Counters indexed by 'instrumented_operations'
+ */
+S21InstrumentationSnapshot S21Instrumentation::Snapshot() {
+  S21InstrumentationSnapshot snapshot{};
+  for (int i = 0; i < NUMBER_OF_INSTRUMENTED_OPERATIONS; ++i) {
+    const Counters& source = counters[i];
+    S21OperationStats& stats = snapshot[i];
+    stats.calls = Load(source.calls);
+    stats.nanoseconds = Load(source.nanoseconds);
+    stats.flops = Load(source.flops);
+    stats.bytes = Load(source.bytes);
+    stats.allocations = Load(source.allocations);
+    stats.allocated_bytes = Load(source.allocated_bytes);
+    for (int j = 0; j < kInstrumentationBuckets; ++j) {
+      stats.histogram[j] = Load(source.histogram[j]);
+    }
+  }
+  return snapshot;
+}
+
+/**
+ * @brief Sets all counters to zero
+ * @details Operations that run meanwhile may be recorded partly
+ */
+void S21Instrumentation::Reset() {
+  for (Counters& target : counters) {
+    target.calls.store(0, std::memory_order_relaxed);
+    target.nanoseconds.store(0, std::memory_order_relaxed);
+    target.flops.store(0, std::memory_order_relaxed);
+    target.bytes.store(0, std::memory_order_relaxed);
+    target.allocations.store(0, std::memory_order_relaxed);
+    target.allocated_bytes.store(0, std::memory_order_relaxed);
+    for (auto& bucket : target.histogram) {
+      bucket.store(0, std::memory_order_relaxed);
+    }
+  }
+}
+
+/**
+ * @brief Writes a snapshot of the counters as a JSON object
+ * @details The object has the fields "enabled" and "operations", the
+ * latter maps the name of every operation to its counters. The histograms
+ * always have kInstrumentationBuckets buckets.
+ * @return The JSON text
+ */
+std::string S21Instrumentation::ToJson() {
+  S21InstrumentationSnapshot snapshot = Snapshot();
+  std::string json = "{\n  \"enabled\": ";
+  json += Enabled() ? "true" : "false";
+  json += ",\n  \"operations\": {";
+  for (int i = 0; i < NUMBER_OF_INSTRUMENTED_OPERATIONS; ++i) {
+    const S21OperationStats& stats = snapshot[i];
+    json += i ? ",\n    \"" : "\n    \"";
+    json += kNames[i];
+    json += "\": {";
+    AppendField(&json, "calls", stats.calls);
+    AppendField(&json, "nanoseconds", stats.nanoseconds);
+    AppendField(&json, "flops", stats.flops);
+    AppendField(&json, "bytes", stats.bytes);
+    AppendField(&json, "allocations", stats.allocations);
+    AppendField(&json, "allocated_bytes", stats.allocated_bytes);
+    json += "\"histogram\": [";
+    for (int j = 0; j < kInstrumentationBuckets; ++j) {
+      if (j) json += ", ";
+      json += std::to_string(stats.histogram[j]);
+    }
+    json += "]}";
+  }
+  json += "\n  }\n}\n";
+  return json;
+}
+
+/**
+ * @brief Returns the name of an operation as used by ToJson()
+ * @param operation - one of 'instrumented_operations'
+ */
+const char* S21Instrumentation::Name(int operation) {
+  if (operation < 0 || operation >= NUMBER_OF_INSTRUMENTED_OPERATIONS) {
+    throw std::out_of_range("The operation is not instrumented");
+  }
+  return kNames[operation];
+}
+
+/**
+ * @brief Adds one call of an operation to its counters
+ * @param operation - one of 'instrumented_operations'
+ * @param nanoseconds - wall time of the call
+ * @param flops, bytes - estimated costs of the call
+ */
+void S21Instrumentation::Record(int operation, std::uint64_t nanoseconds,
+                                std::uint64_t flops, std::uint64_t bytes) {
+  Counters& target = counters[operation];
+  Add(&target.calls, 1);
+  Add(&target.nanoseconds, nanoseconds);
+  Add(&target.flops, flops);
+  Add(&target.bytes, bytes);
+  Add(&target.histogram[BucketOf(nanoseconds)], 1);
+}
+
+/**
+ * @brief Charges an allocation to the innermost operation of this thread
+ * @param bytes - size of the allocated block
+ */
+void S21Instrumentation::RecordAllocation(std::size_t bytes) {
+  Counters& target = counters[S21InstrumentationScope::Current()];
+  Add(&target.allocations, 1);
+  Add(&target.allocated_bytes, bytes);
+}
+
+/* S21InstrumentationScope --------------------------------------------------*/
+
+/**
+ * @brief Starts the timer of an operation
+ * @param operation - one of 'instrumented_operations'
+ * @param flops, bytes - estimated costs of the operation
+ */
+S21InstrumentationScope::S21InstrumentationScope(int operation, double flops,
+                                                 double bytes)
+    : operation_(operation),
+      flops_(static_cast<std::uint64_t>(flops)),
+      bytes_(static_cast<std::uint64_t>(bytes)),
+      start_(std::chrono::steady_clock::now()),
+      parent_(current_scope) {
+  current_scope = this;
+}
+
+/**
+ * @brief Records the operation, exceptions included
+ */
+S21InstrumentationScope::~S21InstrumentationScope() {
+  auto elapsed = std::chrono::steady_clock::now() - start_;
+  current_scope = parent_;
+  S21Instrumentation::Record(
+      operation_,
+      std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count(),
+      flops_, bytes_);
+}
+
+/**
+ * @brief Returns the innermost operation running on this thread,
+ * INSTRUMENT_OTHER outside of any
+ */
+int S21InstrumentationScope::Current() {
+  return current_scope ? current_scope->operation_ : INSTRUMENT_OTHER;
+}
@@ -0,0 +1,134 @@
+/*
+ * Copyright 2023 Gleb Tolstenev
+ * yonnarge@student.21-school.ru
+ *
+ * s21_instrumentation.h is the header file for the operation counters of
+ * s21_matrix_oop library
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef SRC_S21_INSTRUMENTATION_H_
+#define SRC_S21_INSTRUMENTATION_H_
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/**
+ * @brief Operations of S21Matrix that are counted by S21Instrumentation
+ */
+enum instrumented_operations {
+  INSTRUMENT_OTHER = 0,  // Allocations outside of the operations below
+  INSTRUMENT_CONSTRUCT = 1,
+  INSTRUMENT_COPY = 2,
+  INSTRUMENT_COPY_ASSIGNMENT = 3,
+  INSTRUMENT_EXPRESSION = 4,
+  INSTRUMENT_EQ_MATRIX = 5,
+  INSTRUMENT_SUM_MATRIX = 6,
+  INSTRUMENT_SUB_MATRIX = 7,
+  INSTRUMENT_MUL_NUMBER = 8,
+  INSTRUMENT_MUL_MATRIX = 9,
+  INSTRUMENT_MUL_MATRIX_STRASSEN = 10,
+  INSTRUMENT_PRODUCT = 11,
+  INSTRUMENT_TRANSPOSE = 12,
+  INSTRUMENT_TRANSPOSE_IN_PLACE = 13,
+  INSTRUMENT_CALC_COMPLEMENTS = 14,
+  INSTRUMENT_DETERMINANT = 15,
+  INSTRUMENT_INVERSE_MATRIX = 16,
+  INSTRUMENT_GEMM = 17,
+  INSTRUMENT_SOLVE = 18,
+  INSTRUMENT_GEMV = 19,
+  INSTRUMENT_GER = 20,
+  NUMBER_OF_INSTRUMENTED_OPERATIONS  // To get amount of elements of enum
+};
+
+/* Bucket i of the histograms counts calls of [2^i, 2^(i+1)) nanoseconds,
+ * the last one everything longer */
+constexpr int kInstrumentationBuckets = 40;
+
+/**
+ * @brief Counters of one operation
+ * @details The time of an operation includes the time of the operations it
+ * calls, every one of which is counted by its own counters as well.
+ * Allocations are charged to the innermost operation only.
+ */
+struct S21OperationStats {
+  std::uint64_t calls;
+  std::uint64_t nanoseconds;  // Wall time of all calls
+  std::uint64_t flops;        // Floating-point operations
+  std::uint64_t bytes;        // Elements read and written, in bytes
+  std::uint64_t allocations;
+  std::uint64_t allocated_bytes;
+  std::array<std::uint64_t, kInstrumentationBuckets> histogram;
+};
+
+using S21InstrumentationSnapshot =
+    std::array<S21OperationStats, NUMBER_OF_INSTRUMENTED_OPERATIONS>;
+
+/**
+ * @brief Process-wide counters of the S21Matrix operations
+ * @details The library records them only when it is compiled with
+ * S21_INSTRUMENTATION defined ('make INSTRUMENTATION=1'), otherwise the
+ * recording macros expand to nothing and the counters stay zero. The
+ * counters are relaxed atomics, so operations on several threads may be
+ * recorded at once; a snapshot taken meanwhile may see a call in some
+ * counters and not yet in others.
+ */
+class S21Instrumentation {
+ public:
+  static bool Enabled();
+  static S21InstrumentationSnapshot Snapshot();
+  static void Reset();
+  static std::string ToJson();
+  static const char* Name(int operation);
+
+  static void Record(int operation, std::uint64_t nanoseconds,
+                     std::uint64_t flops, std::uint64_t bytes);
+  static void RecordAllocation(std::size_t bytes);
+};
+
+/**
+ * @brief Records the operation it lives in when it goes out of scope
+ * @details Use it through S21_INSTRUMENT. The costs are estimates from
+ * the sizes of the operands, given when the operation starts.
+ */
+class S21InstrumentationScope {
+ public:
+  S21InstrumentationScope(int operation, double flops, double bytes);
+  S21InstrumentationScope(const S21InstrumentationScope&) = delete;
+  S21InstrumentationScope& operator=(const S21InstrumentationScope&) = delete;
+  ~S21InstrumentationScope();
+
+  static int Current();
+
+ private:
+  int operation_;
+  std::uint64_t flops_, bytes_;
+  std::chrono::steady_clock::time_point start_;
+  S21InstrumentationScope* parent_;
+};
+
+#ifdef S21_INSTRUMENTATION
+#define S21_INSTRUMENT(operation, flops, bytes) \
+  S21InstrumentationScope s21_instrumentation_scope(operation, flops, bytes)
+#define S21_INSTRUMENT_ALLOCATION(bytes) \
+  S21Instrumentation::RecordAllocation(bytes)
+#else
+#define S21_INSTRUMENT(operation, flops, bytes) static_cast<void>(0)
+#define S21_INSTRUMENT_ALLOCATION(bytes) static_cast<void>(0)
+#endif
+
+#endif  // SRC_S21_INSTRUMENTATION_H_
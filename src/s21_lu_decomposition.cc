@@ -0,0 +1,164 @@
+/*
+ * Copyright 2023 Gleb Tolstenev
+ * yonnarge@student.21-school.ru
+ *
+ * s21_lu_decomposition.cc is the source code file for the LU decomposition
+ * of s21_matrix_oop library
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "s21_lu_decomposition.h"
+
+#include <algorithm>
+#include <cfloat>
+
+#include "s21_gemm.h"
+
+/* Constructors and destructors ---------------------------------------------*/
+
+/**
+ * @brief Factorizes the matrix
+ * @details A pivot that is zero up to rounding (n * DBL_EPSILON of the
+ * largest element) does not stop the factorization: the matrix is marked
+ * as singular and the column is left as it is
+ * @param matrix - square matrix that will be factorized
+ */
+S21LuDecomposition::S21LuDecomposition(const S21Matrix& matrix)
+    : lu_(matrix, matrix.GetResource()),
+      pivots_(matrix.GetRows()),
+      sign_(1),
+      singular_(false) {
+  if (matrix.GetRows() != matrix.GetCols()) {
+    throw std::logic_error(
+        "The LU decomposition was rejected. The matrix is not square");
+  }
+  int n = lu_.GetRows();
+  std::ptrdiff_t rs = lu_.stride();
+  double* a = lu_.data();
+  double tolerance = 0.0;
+  for (int i = 0; i < n; ++i) {
+    for (int j = 0; j < n; ++j) {
+      tolerance = std::max(tolerance, fabs(a[i * rs + j]));
+    }
+  }
+  tolerance *= n * DBL_EPSILON;
+
+  for (int j0 = 0; j0 < n; j0 += kBlock) {
+    int j1 = std::min(j0 + kBlock, n);
+    for (int j = j0; j < j1; ++j) {
+      int pivot_row = j;
+      double max = fabs(a[j * rs + j]);
+      for (int i = j + 1; i < n; ++i) {
+        if (fabs(a[i * rs + j]) > max) {
+          max = fabs(a[i * rs + j]);
+          pivot_row = i;
+        }
+      }
+      pivots_[j] = pivot_row;
+      if (pivot_row != j) {
+        std::swap_ranges(a + j * rs, a + j * rs + n, a + pivot_row * rs);
+        sign_ = -sign_;
+      }
+
+      const double* a_j = a + j * rs;
+      if (fabs(a_j[j]) <= tolerance) {
+        singular_ = true;
+        continue;
+      }
+      for (int i = j + 1; i < n; ++i) {
+        double* a_i = a + i * rs;
+        double l_ij = a_i[j] /= a_j[j];
+        for (int c = j + 1; c < j1; ++c) a_i[c] -= l_ij * a_j[c];
+      }
+    }
+    if (j1 < n) {
+      S21SolveLower(j1 - j0, n - j1, true, a + j0 * rs + j0, rs, 1,
+                    a + j0 * rs + j1, rs);
+      S21Gemm(n - j1, n - j1, j1 - j0, -1.0, a + j1 * rs + j0, rs, 1,
+              a + j0 * rs + j1, rs, 1, 1.0, a + j1 * rs + j1, rs);
+    }
+  }
+}
+
+/* Core methods -------------------------------------------------------------*/
+
+/**
+ * @brief Determinant of the factorized matrix
+ * @return sign(P) * product of the diagonal of U
+ */
+double S21LuDecomposition::Determinant() const {
+  if (singular_) return 0.0;
+  double result = sign_;
+  for (int i = 0; i < lu_.GetRows(); ++i) {
+    result *= lu_.GetVal(i, i);
+  }
+  return result;
+}
+
+/**
+ * @brief Inverse of the factorized matrix
+ * @details Solves L * U * X = P with two blocked triangular solves
+ * @return The inverse matrix
+ */
+S21Matrix S21LuDecomposition::InverseMatrix() const {
+  if (singular_) {
+    throw std::logic_error(
+        "The matrix inversion was rejected. The matrix is singular");
+  }
+  int n = lu_.GetRows();
+  S21Matrix result(n, n, lu_.GetResource());
+  for (int i = 0; i < n; ++i) {
+    result(i, i) = 1.0;
+  }
+  double* x = result.data();
+  std::ptrdiff_t x_rs = result.stride();
+  for (int i = 0; i < n; ++i) {
+    if (pivots_[i] != i) {
+      std::swap_ranges(x + i * x_rs, x + i * x_rs + n, x + pivots_[i] * x_rs);
+    }
+  }
+  S21SolveLower(n, n, true, lu_.data(), lu_.stride(), 1, x, x_rs);
+  S21SolveUpper(n, n, false, lu_.data(), lu_.stride(), 1, x, x_rs);
+  return result;
+}
+
+/**
+ * @brief Solves A * X = B for the factorized A
+ * @details Applies the row swaps to a copy of B and solves L * U * X = P * B
+ * with two blocked triangular solves, every column of B is a right-hand side
+ * @param other - B, with as many rows as A
+ * @return X, with the sizes of B
+ */
+S21Matrix S21LuDecomposition::Solve(const S21Matrix& other) const {
+  int n = lu_.GetRows();
+  if (other.GetRows() != n) {
+    throw std::logic_error(
+        "The solution was rejected. Matrices have different sizes");
+  }
+  if (singular_) {
+    throw std::logic_error("The solution was rejected. The matrix is singular");
+  }
+  S21Matrix result(other, lu_.GetResource());
+  int m = result.GetCols();
+  double* x = result.data();
+  std::ptrdiff_t x_rs = result.stride();
+  for (int i = 0; i < n; ++i) {
+    if (pivots_[i] != i) {
+      std::swap_ranges(x + i * x_rs, x + i * x_rs + m, x + pivots_[i] * x_rs);
+    }
+  }
+  S21SolveLower(n, m, true, lu_.data(), lu_.stride(), 1, x, x_rs);
+  S21SolveUpper(n, m, false, lu_.data(), lu_.stride(), 1, x, x_rs);
+  return result;
+}
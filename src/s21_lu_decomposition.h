@@ -0,0 +1,67 @@
+/*
+ * Copyright 2023 Gleb Tolstenev
+ * yonnarge@student.21-school.ru
+ *
+ * s21_lu_decomposition.h is the header file for the LU decomposition of
+ * s21_matrix_oop library
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef SRC_S21_LU_DECOMPOSITION_H_
+#define SRC_S21_LU_DECOMPOSITION_H_
+
+#include <vector>
+
+#include "s21_matrix_oop.h"
+
+/**
+ * @brief LU decomposition with partial pivoting, P * A = L * U
+ * @details The matrix is factorized once in blocks of kBlock columns: each
+ * block column is eliminated with row pivoting and the rest of the matrix
+ * is updated by S21Gemm, so the cost is O(n^3) and most of it runs in the
+ * packed multiplication kernel. The object keeps the factors, so any
+ * number of determinants, inverses and solutions can be taken from one
+ * factorization.
+ *
+ * L (unit diagonal, not stored) and U share one matrix, as in LAPACK.
+ * The permutation is stored as a sequence of swaps: row i was exchanged
+ * with row GetPivots()[i] at step i.
+ */
+class S21LuDecomposition {
+ public:
+  /* Width of the block columns of the factorization */
+  static constexpr int kBlock = 64;
+
+ private:
+  S21Matrix lu_;
+  std::vector<int> pivots_;
+  int sign_;  // Determinant of P, +1 or -1
+  bool singular_;
+
+ public:
+  /* Constructors and destructors ----------------------------------------*/
+  explicit S21LuDecomposition(const S21Matrix& matrix);
+
+  /* Core methods --------------------------------------------------------*/
+  double Determinant() const;
+  S21Matrix InverseMatrix() const;
+  S21Matrix Solve(const S21Matrix& other) const;
+
+  /* Accessors and mutators ---------------------------------------------*/
+  bool IsSingular() const { return singular_; }
+  const S21Matrix& GetLu() const { return lu_; }
+  const std::vector<int>& GetPivots() const { return pivots_; }
+};
+
+#endif  // SRC_S21_LU_DECOMPOSITION_H_
@@ -0,0 +1,633 @@
+/*
+ * Copyright 2023 Gleb Tolstenev
+ * yonnarge@student.21-school.ru
+ *
+ * s21_matrix_batch.cc is the source code file for the batch of same-shaped
+ * matrices of s21_matrix_oop library
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "s21_matrix_batch.h"
+
+#include <algorithm>
+#include <cfloat>
+
+#include "s21_simd.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#define S21_SIMD_X86 1
+#endif
+
+namespace {
+
+constexpr int kBlock = S21MatrixBatch::kBatchBlock;
+
+/* Kernels -----------------------------------------------------------------*/
+
+/*
+ * The kernels are written once for a block of kBlock matrices, every
+ * statement being a loop over the block, and inlined into a function per
+ * SIMD level, so the compiler vectorizes the same code with the widest
+ * registers of that level.
+ */
+
+/**
+ * @brief C = A * B for a block of matrices, A is m x k and B is k x n
+ * @param a, b, c - arrays of element (0, 0) of the block
+ * @param stride - distance in elements between the arrays of the batches
+ */
+inline __attribute__((always_inline)) void MulBlock(int m, int n, int k,
+                                                    const double* a,
+                                                    const double* b, double* c,
+                                                    std::ptrdiff_t stride) {
+  for (int i = 0; i < m; ++i) {
+    for (int j = 0; j < n; ++j) {
+      double acc[kBlock];
+      const double* a_il = a + i * k * stride;
+      const double* b_lj = b + j * stride;
+      for (int t = 0; t < kBlock; ++t) acc[t] = a_il[t] * b_lj[t];
+      for (int l = 1; l < k; ++l) {
+        a_il += stride;
+        b_lj += n * stride;
+        for (int t = 0; t < kBlock; ++t) acc[t] += a_il[t] * b_lj[t];
+      }
+      double* c_ij = c + (i * n + j) * stride;
+      for (int t = 0; t < kBlock; ++t) c_ij[t] = acc[t];
+    }
+  }
+}
+
+/**
+ * @brief Gauss-Jordan elimination with partial pivoting for a block of
+ * n x n matrices
+ * @details Every matrix picks its own pivot rows: the row exchanges are
+ * made with per-matrix selects, so no matrix leaves the SIMD lanes. A
+ * pivot not above n * DBL_EPSILON of the largest element of its matrix
+ * marks the matrix as singular and is replaced by 1 to keep the other
+ * lanes going. Without kInverse only the rows below the pivot are
+ * eliminated, which is enough for the determinant.
+ * @param a, stride - arrays of element (0, 0) of the block and their
+ * distance
+ * @param work - room for n * n * kBlock elements
+ * @param inv - arrays of the inverse matrices, 'stride' apart
+ * @param det, singular - kBlock results
+ */
+template <bool kInverse>
+inline __attribute__((always_inline)) void EliminateBlock(
+    int n, const double* a, std::ptrdiff_t stride, double* work, double* inv,
+    double* det, double* singular) {
+  auto w = [work, n](int row, int col) {
+    return work + (row * n + col) * kBlock;
+  };
+  auto x = [inv, n, stride](int row, int col) {
+    return inv + (row * n + col) * stride;
+  };
+  double tolerance[kBlock] = {}, pivot_row[kBlock], scale[kBlock];
+  for (int p = 0; p < n * n; ++p) {
+    const double* a_p = a + p * stride;
+    double* w_p = work + p * kBlock;
+    for (int t = 0; t < kBlock; ++t) {
+      w_p[t] = a_p[t];
+      tolerance[t] = std::max(tolerance[t], fabs(a_p[t]));
+    }
+  }
+  for (int t = 0; t < kBlock; ++t) {
+    tolerance[t] *= n * DBL_EPSILON;
+    det[t] = 1.0;
+    singular[t] = 0.0;
+  }
+  if (kInverse) {
+    for (int i = 0; i < n; ++i) {
+      for (int j = 0; j < n; ++j) {
+        double value = i == j ? 1.0 : 0.0;
+        double* x_ij = x(i, j);
+        for (int t = 0; t < kBlock; ++t) x_ij[t] = value;
+      }
+    }
+  }
+
+  for (int c = 0; c < n; ++c) {
+    double* w_cc = w(c, c);
+    for (int t = 0; t < kBlock; ++t) {
+      scale[t] = fabs(w_cc[t]);
+      pivot_row[t] = c;
+    }
+    for (int r = c + 1; r < n; ++r) {
+      const double* w_rc = w(r, c);
+      for (int t = 0; t < kBlock; ++t) {
+        bool larger = fabs(w_rc[t]) > scale[t];
+        scale[t] = larger ? fabs(w_rc[t]) : scale[t];
+        pivot_row[t] = larger ? r : pivot_row[t];
+      }
+    }
+    for (int r = c + 1; r < n; ++r) {
+      auto exchange = [&pivot_row, r](double* row_c, double* row_r) {
+        for (int t = 0; t < kBlock; ++t) {
+          bool swap = pivot_row[t] == r;
+          double value_c = row_c[t], value_r = row_r[t];
+          row_c[t] = swap ? value_r : value_c;
+          row_r[t] = swap ? value_c : value_r;
+        }
+      };
+      for (int j = c; j < n; ++j) exchange(w(c, j), w(r, j));
+      if (kInverse) {
+        for (int j = 0; j < n; ++j) exchange(x(c, j), x(r, j));
+      }
+      for (int t = 0; t < kBlock; ++t) {
+        det[t] = pivot_row[t] == r ? -det[t] : det[t];
+      }
+    }
+    for (int t = 0; t < kBlock; ++t) {
+      bool zero = fabs(w_cc[t]) <= tolerance[t];
+      singular[t] = zero ? 1.0 : singular[t];
+      double pivot = zero ? 1.0 : w_cc[t];
+      det[t] *= pivot;
+      scale[t] = 1.0 / pivot;
+    }
+    if (kInverse) {
+      for (int j = c + 1; j < n; ++j) {
+        double* w_cj = w(c, j);
+        for (int t = 0; t < kBlock; ++t) w_cj[t] *= scale[t];
+      }
+      for (int j = 0; j < n; ++j) {
+        double* x_cj = x(c, j);
+        for (int t = 0; t < kBlock; ++t) x_cj[t] *= scale[t];
+      }
+    }
+    for (int r = kInverse ? 0 : c + 1; r < n; ++r) {
+      if (r == c) continue;
+      double* w_rc = w(r, c);
+      double factor[kBlock];
+      for (int t = 0; t < kBlock; ++t) {
+        factor[t] = kInverse ? w_rc[t] : w_rc[t] * scale[t];
+      }
+      for (int j = c + 1; j < n; ++j) {
+        double* w_rj = w(r, j);
+        const double* w_cj = w(c, j);
+        for (int t = 0; t < kBlock; ++t) w_rj[t] -= factor[t] * w_cj[t];
+      }
+      if (kInverse) {
+        for (int j = 0; j < n; ++j) {
+          double* x_rj = x(r, j);
+          const double* x_cj = x(c, j);
+          for (int t = 0; t < kBlock; ++t) x_rj[t] -= factor[t] * x_cj[t];
+        }
+      }
+    }
+  }
+  for (int t = 0; t < kBlock; ++t) {
+    det[t] = singular[t] != 0.0 ? 0.0 : det[t];
+  }
+}
+
+using MulKernel = void (*)(int, int, int, const double*, const double*,
+                           double*, std::ptrdiff_t);
+using EliminateKernel = void (*)(int, const double*, std::ptrdiff_t, double*,
+                                 double*, double*, double*);
+
+void MulGeneric(int m, int n, int k, const double* a, const double* b,
+                double* c, std::ptrdiff_t stride) {
+  MulBlock(m, n, k, a, b, c, stride);
+}
+
+template <bool kInverse>
+void EliminateGeneric(int n, const double* a, std::ptrdiff_t stride,
+                      double* work, double* inv, double* det,
+                      double* singular) {
+  EliminateBlock<kInverse>(n, a, stride, work, inv, det, singular);
+}
+
+#ifdef S21_SIMD_X86
+
+__attribute__((target("avx2,fma"))) void MulAvx2(int m, int n, int k,
+                                                 const double* a,
+                                                 const double* b, double* c,
+                                                 std::ptrdiff_t stride) {
+  MulBlock(m, n, k, a, b, c, stride);
+}
+
+template <bool kInverse>
+__attribute__((target("avx2,fma"))) void EliminateAvx2(
+    int n, const double* a, std::ptrdiff_t stride, double* work, double* inv,
+    double* det, double* singular) {
+  EliminateBlock<kInverse>(n, a, stride, work, inv, det, singular);
+}
+
+__attribute__((target("avx512f"))) void MulAvx512(int m, int n, int k,
+                                                  const double* a,
+                                                  const double* b, double* c,
+                                                  std::ptrdiff_t stride) {
+  MulBlock(m, n, k, a, b, c, stride);
+}
+
+template <bool kInverse>
+__attribute__((target("avx512f"))) void EliminateAvx512(
+    int n, const double* a, std::ptrdiff_t stride, double* work, double* inv,
+    double* det, double* singular) {
+  EliminateBlock<kInverse>(n, a, stride, work, inv, det, singular);
+}
+
+#endif  // S21_SIMD_X86
+
+MulKernel MulFor(int level) {
+#ifdef S21_SIMD_X86
+  if (level >= SIMD_AVX512) return MulAvx512;
+  if (level >= SIMD_AVX2) return MulAvx2;
+#endif
+  (void)level;
+  return MulGeneric;
+}
+
+template <bool kInverse>
+EliminateKernel EliminateFor(int level) {
+#ifdef S21_SIMD_X86
+  if (level >= SIMD_AVX512) return EliminateAvx512<kInverse>;
+  if (level >= SIMD_AVX2) return EliminateAvx2<kInverse>;
+#endif
+  (void)level;
+  return EliminateGeneric<kInverse>;
+}
+
+}  // namespace
+
+/* Constructors and destructors ---------------------------------------------*/
+
+/**
+ * @brief Parameterized constructor, all the matrices are zero
+ * @param count - number of matrices
+ * @param rows, cols - size of every matrix
+ * @param resource - memory resource for the elements
+ */
+S21MatrixBatch::S21MatrixBatch(int count, int rows, int cols,
+                               std::pmr::memory_resource* resource) {
+  if (count < 1) {
+    throw std::invalid_argument("The number of matrices is lower than 1");
+  } else if (rows < 1) {
+    throw std::invalid_argument("The number of rows is lower than 1");
+  } else if (cols < 1) {
+    throw std::invalid_argument("The number of columns is lower than 1");
+  } else if (!resource) {
+    throw std::invalid_argument("The memory resource is null");
+  }
+  count_ = count;
+  rows_ = rows;
+  cols_ = cols;
+  batch_stride_ = (count + kBatchBlock - 1) / kBatchBlock * kBatchBlock;
+  resource_ = resource;
+  data_ = NewArrayOfElements();
+}
+
+/**
+ * @brief Copy constructor, the copy uses the default resource
+ * @details A copy of a moved-from batch is empty as well
+ */
+S21MatrixBatch::S21MatrixBatch(const S21MatrixBatch& other)
+    : count_(other.count_),
+      rows_(other.rows_),
+      cols_(other.cols_),
+      batch_stride_(other.batch_stride_),
+      resource_(std::pmr::get_default_resource()),
+      data_(other.data_ ? NewArrayOfElements() : nullptr) {
+  if (data_) {
+    std::memcpy(data_, other.data_,
+                static_cast<std::size_t>(rows_) * cols_ * batch_stride_ *
+                    sizeof(double));
+  }
+}
+
+/**
+ * @brief Move constructor, takes over the storage and its resource
+ */
+S21MatrixBatch::S21MatrixBatch(S21MatrixBatch&& other) noexcept
+    : count_(other.count_),
+      rows_(other.rows_),
+      cols_(other.cols_),
+      batch_stride_(other.batch_stride_),
+      resource_(other.resource_),
+      data_(other.data_) {
+  other.count_ = 0;
+  other.rows_ = 0;
+  other.cols_ = 0;
+  other.batch_stride_ = 0;
+  other.resource_ = std::pmr::get_default_resource();
+  other.data_ = nullptr;
+}
+
+S21MatrixBatch::~S21MatrixBatch() { DeleteArrayOfElements(); }
+
+/* Memory management functions ----------------------------------------------*/
+
+/**
+ * @brief Allocates one zero-initialized, aligned block for all arrays
+ */
+double* S21MatrixBatch::NewArrayOfElements() const {
+  std::size_t bytes = static_cast<std::size_t>(rows_) * cols_ *
+                      batch_stride_ * sizeof(double);
+  auto elements = static_cast<double*>(
+      resource_->allocate(bytes, S21Matrix::kAlignment));
+  std::memset(elements, 0, bytes);
+  return elements;
+}
+
+void S21MatrixBatch::DeleteArrayOfElements() {
+  if (data_) {
+    resource_->deallocate(data_,
+                          static_cast<std::size_t>(rows_) * cols_ *
+                              batch_stride_ * sizeof(double),
+                          S21Matrix::kAlignment);
+  }
+}
+
+/* Overloads ----------------------------------------------------------------*/
+
+S21MatrixBatch& S21MatrixBatch::operator=(const S21MatrixBatch& other) {
+  if (this != &other) {
+    S21MatrixBatch copy(other);
+    *this = std::move(copy);
+  }
+  return *this;
+}
+
+S21MatrixBatch& S21MatrixBatch::operator=(S21MatrixBatch&& other) noexcept {
+  if (this != &other) {
+    DeleteArrayOfElements();
+    count_ = other.count_;
+    rows_ = other.rows_;
+    cols_ = other.cols_;
+    batch_stride_ = other.batch_stride_;
+    resource_ = other.resource_;
+    data_ = other.data_;
+
+    other.count_ = 0;
+    other.rows_ = 0;
+    other.cols_ = 0;
+    other.batch_stride_ = 0;
+    other.resource_ = std::pmr::get_default_resource();
+    other.data_ = nullptr;
+  }
+  return *this;
+}
+
+/**
+ * @brief Multiplies every matrix by the matrix of 'other' with its index
+ * @param other - the batch of as many matrices with as many rows as these
+ * matrices have columns
+ * @return New batch with the products
+ */
+S21MatrixBatch S21MatrixBatch::operator*(const S21MatrixBatch& other) const {
+  if (count_ != other.count_ || cols_ != other.rows_) {
+    throw std::logic_error(
+        "The multiplication of matrices was rejected. Matrices have "
+        "different sizes");
+  }
+  S21MatrixBatch result(count_, rows_, other.cols_, resource_);
+  MulKernel kernel = MulFor(S21Simd::GetLevel());
+  ForEachBlock([&](int begin, int end) {
+    for (int b = begin; b < end; b += kBatchBlock) {
+      kernel(rows_, other.cols_, cols_, data_ + b, other.data_ + b,
+             result.data_ + b, batch_stride_);
+    }
+  });
+  return result;
+}
+
+/**
+ * @brief Element (row, col) of the matrix 'index'
+ */
+double& S21MatrixBatch::operator()(int index, int row, int col) {
+  CheckIndex(index);
+  if (row < 0 || row >= rows_ || col < 0 || col >= cols_)
+    throw std::out_of_range(
+        "Attempt to access to element of matrix by index outside of the range");
+  return Array(row, col)[index];
+}
+
+bool S21MatrixBatch::operator==(const S21MatrixBatch& other) const {
+  return EqMatrix(other);
+}
+
+S21MatrixBatch& S21MatrixBatch::operator+=(const S21MatrixBatch& other) {
+  SumMatrix(other);
+  return *this;
+}
+
+S21MatrixBatch& S21MatrixBatch::operator-=(const S21MatrixBatch& other) {
+  SubMatrix(other);
+  return *this;
+}
+
+S21MatrixBatch& S21MatrixBatch::operator*=(const double num) {
+  MulNumber(num);
+  return *this;
+}
+
+S21MatrixBatch& S21MatrixBatch::operator*=(const S21MatrixBatch& other) {
+  MulMatrix(other);
+  return *this;
+}
+
+/* Core methods -------------------------------------------------------------*/
+
+/**
+ * @brief Checks every pair of matrices for equality up to EPS
+ * @return true when the batches have the same shape and all pairs are equal
+ */
+bool S21MatrixBatch::EqMatrix(const S21MatrixBatch& other) const {
+  if (count_ != other.count_ || rows_ != other.rows_ ||
+      cols_ != other.cols_) {
+    return false;
+  }
+  for (int p = 0; p < rows_ * cols_; ++p) {
+    std::ptrdiff_t offset = static_cast<std::ptrdiff_t>(p) * batch_stride_;
+    if (!S21Simd::Equal(data_ + offset, other.data_ + offset, count_, EPS)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/**
+ * @brief Adds the matrices of 'other' to the matrices with the same index
+ */
+void S21MatrixBatch::SumMatrix(const S21MatrixBatch& other) {
+  if (count_ != other.count_) {
+    throw std::logic_error(
+        "The addition was rejected. Batches have different sizes");
+  }
+  S21Matrix::CheckSizesFor(SUM, rows_, cols_, other.rows_, other.cols_);
+  ForEachBlock([&](int begin, int end) {
+    for (int p = 0; p < rows_ * cols_; ++p) {
+      std::ptrdiff_t offset = static_cast<std::ptrdiff_t>(p) * batch_stride_;
+      S21Simd::Add(data_ + offset + begin, other.data_ + offset + begin,
+                   end - begin);
+    }
+  });
+}
+
+/**
+ * @brief Subtracts the matrices of 'other' from the matrices with the same
+ * index
+ */
+void S21MatrixBatch::SubMatrix(const S21MatrixBatch& other) {
+  if (count_ != other.count_) {
+    throw std::logic_error(
+        "The subtraction was rejected. Batches have different sizes");
+  }
+  S21Matrix::CheckSizesFor(SUB, rows_, cols_, other.rows_, other.cols_);
+  ForEachBlock([&](int begin, int end) {
+    for (int p = 0; p < rows_ * cols_; ++p) {
+      std::ptrdiff_t offset = static_cast<std::ptrdiff_t>(p) * batch_stride_;
+      S21Simd::Sub(data_ + offset + begin, other.data_ + offset + begin,
+                   end - begin);
+    }
+  });
+}
+
+/**
+ * @brief Multiplies every matrix by a number 'num'
+ */
+void S21MatrixBatch::MulNumber(const double num) {
+  ForEachBlock([&](int begin, int end) {
+    for (int p = 0; p < rows_ * cols_; ++p) {
+      std::ptrdiff_t offset = static_cast<std::ptrdiff_t>(p) * batch_stride_;
+      S21Simd::Scale(data_ + offset + begin, num, end - begin);
+    }
+  });
+}
+
+/**
+ * @brief Replaces every matrix with its product by the matrix of 'other'
+ * with the same index
+ */
+void S21MatrixBatch::MulMatrix(const S21MatrixBatch& other) {
+  *this = *this * other;
+}
+
+/**
+ * @brief Transposes every matrix
+ * @details The arrays of the batch are moved as a whole, a memcpy each
+ */
+S21MatrixBatch S21MatrixBatch::Transpose() const {
+  S21MatrixBatch result(count_, cols_, rows_, resource_);
+  for (int i = 0; i < rows_; ++i) {
+    for (int j = 0; j < cols_; ++j) {
+      std::memcpy(result.Array(j, i), Array(i, j),
+                  batch_stride_ * sizeof(double));
+    }
+  }
+  return result;
+}
+
+/**
+ * @brief Determinants of all the matrices
+ * @return The determinant of matrix 'index' at 'index'
+ */
+std::vector<double> S21MatrixBatch::Determinant() const {
+  S21Matrix::CheckSizesFor(DETERMINANT, rows_, cols_, rows_, cols_);
+  std::vector<double> determinant(batch_stride_), singular(batch_stride_);
+  Eliminate(nullptr, determinant.data(), singular.data());
+  determinant.resize(count_);
+  return determinant;
+}
+
+/**
+ * @brief Inverses of all the matrices
+ * @details Throws std::logic_error if any of the matrices is singular
+ * @return New batch with the inverse matrices
+ */
+S21MatrixBatch S21MatrixBatch::InverseMatrix() const {
+  S21Matrix::CheckSizesFor(INVERSE_MATRIX, rows_, cols_, rows_, cols_);
+  S21MatrixBatch result(count_, rows_, cols_, resource_);
+  std::vector<double> determinant(batch_stride_), singular(batch_stride_);
+  Eliminate(result.data_, determinant.data(), singular.data());
+  for (int index = 0; index < count_; ++index) {
+    if (singular[index] != 0.0) {
+      throw std::logic_error(
+          "The matrix inversion was rejected. The matrix " +
+          std::to_string(index) + " of the batch is singular");
+    }
+  }
+  return result;
+}
+
+/* Accessors and mutators ---------------------------------------------------*/
+
+/**
+ * @brief Copy of the matrix 'index'
+ */
+S21Matrix S21MatrixBatch::GetMatrix(int index) const {
+  CheckIndex(index);
+  S21Matrix result(rows_, cols_);
+  for (int i = 0; i < rows_; ++i) {
+    for (int j = 0; j < cols_; ++j) {
+      result(i, j) = Array(i, j)[index];
+    }
+  }
+  return result;
+}
+
+/**
+ * @brief Copies a matrix into the place 'index' of the batch
+ */
+void S21MatrixBatch::SetMatrix(int index, const S21Matrix& matrix) {
+  CheckIndex(index);
+  S21Matrix::CheckSizesFor(ASSIGNMENT, rows_, cols_, matrix.GetRows(),
+                           matrix.GetCols());
+  for (int i = 0; i < rows_; ++i) {
+    for (int j = 0; j < cols_; ++j) {
+      Array(i, j)[index] = matrix.GetVal(i, j);
+    }
+  }
+}
+
+/* Help methods -------------------------------------------------------------*/
+
+void S21MatrixBatch::CheckIndex(int index) const {
+  if (index < 0 || index >= count_)
+    throw std::out_of_range(
+        "Attempt to access to matrix of batch by index outside of the range");
+}
+
+/**
+ * @brief Calls body(begin, end) on ranges of whole blocks of matrices that
+ * cover the batch stride, large batches on S21ThreadPool
+ */
+void S21MatrixBatch::ForEachBlock(
+    const std::function<void(int, int)>& body) const {
+  int blocks = batch_stride_ / kBatchBlock;
+  S21Matrix::ForEachRow(blocks, kBatchBlock * rows_ * cols_,
+                        [&body](int begin, int end) {
+                          body(begin * kBatchBlock, end * kBatchBlock);
+                        });
+}
+
+/**
+ * @brief Eliminates every square matrix of the batch
+ * @param inverse - arrays of the inverse matrices, nullptr when only the
+ * determinants are needed
+ * @param determinant, singular - batch_stride_ results
+ */
+void S21MatrixBatch::Eliminate(double* inverse, double* determinant,
+                               double* singular) const {
+  EliminateKernel kernel = inverse ? EliminateFor<true>(S21Simd::GetLevel())
+                                   : EliminateFor<false>(S21Simd::GetLevel());
+  ForEachBlock([&](int begin, int end) {
+    std::vector<double> work(static_cast<std::size_t>(rows_) * cols_ *
+                             kBatchBlock);
+    for (int b = begin; b < end; b += kBatchBlock) {
+      kernel(rows_, data_ + b, batch_stride_, work.data(),
+             inverse ? inverse + b : nullptr, determinant + b, singular + b);
+    }
+  });
+}
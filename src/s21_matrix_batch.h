@@ -0,0 +1,113 @@
+/*
+ * Copyright 2023 Gleb Tolstenev
+ * yonnarge@student.21-school.ru
+ *
+ * s21_matrix_batch.h is the header file for the batch of same-shaped
+ * matrices of s21_matrix_oop library
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef SRC_S21_MATRIX_BATCH_H_
+#define SRC_S21_MATRIX_BATCH_H_
+
+#include <cstddef>
+#include <functional>
+#include <memory_resource>
+#include <vector>
+
+#include "s21_matrix_oop.h"
+
+/**
+ * @brief Many matrices of the same shape stored element by element
+ * @details Element (row, col) of all the matrices is one contiguous array
+ * of the batch, so element (row, col) of matrix 'index' is at
+ * data()[(row * cols + col) * batch_stride() + index]. Every kernel works on
+ * whole arrays: it runs the scalar algorithm for one matrix with each
+ * operation applied to kBatchBlock matrices at once, which the compiler
+ * turns into full-width SIMD at the level chosen by S21Simd. Blocks of the
+ * batch run on S21ThreadPool. Sizes are checked once per call, not once
+ * per matrix.
+ *
+ * The batch stride is the count rounded up to kBatchBlock; the matrices in
+ * the padding take part in the computations, their elements are
+ * unspecified.
+ */
+class S21MatrixBatch {
+ public:
+  /* Matrices processed together by one call of a kernel, a multiple of
+   * the 8 lanes of AVX-512 */
+  static constexpr int kBatchBlock = 64;
+
+ private:
+  int count_, rows_, cols_;
+  int batch_stride_;  // Distance in elements between adjacent arrays
+  std::pmr::memory_resource* resource_;
+  double* data_;  // rows_ * cols_ arrays of batch_stride_ elements
+
+ private:
+  /* Memory management functions -----------------------------------------*/
+  double* NewArrayOfElements() const;
+  void DeleteArrayOfElements();
+  double* Array(int row, int col) const {
+    return data_ + static_cast<std::ptrdiff_t>(row * cols_ + col) *
+                       batch_stride_;
+  }
+
+  /* Help methods --------------------------------------------------------*/
+  void CheckIndex(int index) const;
+  void ForEachBlock(const std::function<void(int, int)>& body) const;
+  void Eliminate(double* inverse, double* determinant, double* singular) const;
+
+ public:
+  /* Constructors and destructors ----------------------------------------*/
+  S21MatrixBatch(int count, int rows, int cols,
+                 std::pmr::memory_resource* resource =
+                     std::pmr::get_default_resource());
+  S21MatrixBatch(const S21MatrixBatch& other);
+  S21MatrixBatch(S21MatrixBatch&& other) noexcept;
+  ~S21MatrixBatch();
+
+  /* Overloads -----------------------------------------------------------*/
+  S21MatrixBatch& operator=(const S21MatrixBatch& other);
+  S21MatrixBatch& operator=(S21MatrixBatch&& other) noexcept;
+  S21MatrixBatch operator*(const S21MatrixBatch& other) const;
+  double& operator()(int index, int row, int col);
+  bool operator==(const S21MatrixBatch& other) const;
+  S21MatrixBatch& operator+=(const S21MatrixBatch& other);
+  S21MatrixBatch& operator-=(const S21MatrixBatch& other);
+  S21MatrixBatch& operator*=(const double num);
+  S21MatrixBatch& operator*=(const S21MatrixBatch& other);
+
+  /* Core methods --------------------------------------------------------*/
+  bool EqMatrix(const S21MatrixBatch& other) const;
+  void SumMatrix(const S21MatrixBatch& other);
+  void SubMatrix(const S21MatrixBatch& other);
+  void MulNumber(const double num);
+  void MulMatrix(const S21MatrixBatch& other);
+  S21MatrixBatch Transpose() const;
+  std::vector<double> Determinant() const;
+  S21MatrixBatch InverseMatrix() const;
+
+  /* Accessors and mutators ---------------------------------------------*/
+  int GetCount() const { return count_; }
+  int GetRows() const { return rows_; }
+  int GetCols() const { return cols_; }
+  S21Matrix GetMatrix(int index) const;
+  void SetMatrix(int index, const S21Matrix& matrix);
+  double* data() { return data_; }
+  const double* data() const { return data_; }
+  int batch_stride() const { return batch_stride_; }
+};
+
+#endif  // SRC_S21_MATRIX_BATCH_H_
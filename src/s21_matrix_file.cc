@@ -0,0 +1,518 @@
+/*
+ * Copyright 2023 Gleb Tolstenev
+ * yonnarge@student.21-school.ru
+ *
+ * s21_matrix_file.cc is the source code file for the binary file format of
+ * s21_matrix_oop library
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "s21_matrix_file.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <climits>
+#include <cmath>
+#include <future>
+#include <stdexcept>
+
+#include "s21_gemm.h"
+
+namespace {
+
+/* Largest single read() or write(), Linux moves at most about 2 GB */
+constexpr std::size_t kMaxChunkBytes = 1UL << 30;
+
+constexpr std::uint64_t kPrime1 = 0x9E3779B185EBCA87ULL;
+constexpr std::uint64_t kPrime2 = 0xC2B2AE3D27D4EB4FULL;
+constexpr std::uint64_t kPrime3 = 0x165667B19E3779F9ULL;
+
+std::uint64_t RotateLeft(std::uint64_t value, int bits) {
+  return (value << bits) | (value >> (64 - bits));
+}
+
+std::uint64_t Round(std::uint64_t acc, std::uint64_t word) {
+  return RotateLeft(acc + word * kPrime2, 31) * kPrime1;
+}
+
+/**
+ * @brief Closes a file descriptor when it goes out of scope
+ */
+class FileDescriptor {
+ public:
+  explicit FileDescriptor(int fd) : fd_(fd) {}
+  FileDescriptor(const FileDescriptor&) = delete;
+  FileDescriptor& operator=(const FileDescriptor&) = delete;
+  ~FileDescriptor() {
+    if (fd_ >= 0) close(fd_);
+  }
+  int Get() const { return fd_; }
+  int Release() {
+    int fd = fd_;
+    fd_ = -1;
+    return fd;
+  }
+
+ private:
+  int fd_;
+};
+
+[[noreturn]] void ThrowFileError(const std::string& what,
+                                 const std::string& path) {
+  throw std::runtime_error(what + " '" + path + "': " + std::strerror(errno));
+}
+
+[[noreturn]] void ThrowFormatError(const std::string& what,
+                                   const std::string& path) {
+  throw std::invalid_argument("The file '" + path + "' was rejected. " + what);
+}
+
+void WriteAt(int fd, const void* data, std::size_t bytes, std::size_t offset,
+             const std::string& path) {
+  auto cursor = static_cast<const char*>(data);
+  while (bytes > 0) {
+    ssize_t written = pwrite(fd, cursor, std::min(bytes, kMaxChunkBytes),
+                             static_cast<off_t>(offset));
+    if (written < 0) {
+      if (errno == EINTR) continue;
+      ThrowFileError("Cannot write the file", path);
+    }
+    cursor += written;
+    offset += static_cast<std::size_t>(written);
+    bytes -= static_cast<std::size_t>(written);
+  }
+}
+
+void ReadAt(int fd, void* data, std::size_t bytes, std::size_t offset,
+            const std::string& path) {
+  auto cursor = static_cast<char*>(data);
+  while (bytes > 0) {
+    ssize_t got = pread(fd, cursor, std::min(bytes, kMaxChunkBytes),
+                        static_cast<off_t>(offset));
+    if (got < 0) {
+      if (errno == EINTR) continue;
+      ThrowFileError("Cannot read the file", path);
+    }
+    if (got == 0) ThrowFormatError("The file is truncated", path);
+    cursor += got;
+    offset += static_cast<std::size_t>(got);
+    bytes -= static_cast<std::size_t>(got);
+  }
+}
+
+/**
+ * @brief Checksum of the elements fed in consecutive pieces
+ * @details Every piece but the last must hold a multiple of four elements,
+ * then the result does not depend on how the elements were split
+ */
+class ChecksumStream {
+ public:
+  void Update(const double* elements, std::size_t count) {
+    std::size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+      for (int lane = 0; lane < 4; ++lane) {
+        lanes_[lane] = Round(lanes_[lane], Word(elements + i + lane));
+      }
+    }
+    for (; i < count; ++i) tail_[tail_count_++] = Word(elements + i);
+    count_ += count;
+  }
+
+  std::uint64_t Finish() const {
+    std::uint64_t hash = RotateLeft(lanes_[0], 1) + RotateLeft(lanes_[1], 7) +
+                         RotateLeft(lanes_[2], 12) + RotateLeft(lanes_[3], 18);
+    for (int i = 0; i < tail_count_; ++i) {
+      hash = RotateLeft(hash ^ Round(0, tail_[i]), 27) * kPrime1 + kPrime3;
+    }
+    hash ^= count_;
+    hash ^= hash >> 33;
+    hash *= kPrime2;
+    hash ^= hash >> 29;
+    hash *= kPrime3;
+    hash ^= hash >> 32;
+    return hash;
+  }
+
+ private:
+  static std::uint64_t Word(const double* element) {
+    std::uint64_t word;
+    std::memcpy(&word, element, sizeof(word));
+    return word;
+  }
+
+  std::uint64_t lanes_[4] = {kPrime1 + kPrime2, kPrime2, 0, 0 - kPrime1};
+  std::uint64_t tail_[3] = {};
+  int tail_count_ = 0;
+  std::uint64_t count_ = 0;
+};
+
+S21MatrixFile::Header MakeHeader(std::uint64_t rows, std::uint64_t cols,
+                                 std::uint64_t checksum) {
+  S21MatrixFile::Header header = {};
+  std::memcpy(header.magic, S21MatrixFile::kMagic, sizeof(header.magic));
+  header.version = S21MatrixFile::kVersion;
+  header.dtype = S21MatrixFile::kFloat64;
+  header.byte_order = S21MatrixFile::kByteOrder;
+  header.alignment = S21MatrixFile::kHeaderBytes;
+  header.rows = rows;
+  header.cols = cols;
+  header.checksum = checksum;
+  return header;
+}
+
+/**
+ * @brief Block of a matrix stored in a file
+ */
+struct Tile {
+  int row, col;    // First element
+  int rows, cols;  // Size
+};
+
+/**
+ * @brief Reads a tile of a file with 'file_cols' columns into a packed
+ * buffer of tile.rows x tile.cols elements
+ */
+void ReadTile(int fd, int file_cols, const Tile& tile, double* buffer,
+              const std::string& path) {
+  for (int i = 0; i < tile.rows; ++i) {
+    std::size_t element =
+        static_cast<std::size_t>(tile.row + i) * file_cols + tile.col;
+    ReadAt(fd, buffer + static_cast<std::ptrdiff_t>(i) * tile.cols,
+           tile.cols * sizeof(double),
+           S21MatrixFile::kHeaderBytes + element * sizeof(double), path);
+  }
+}
+
+/**
+ * @brief Writes a packed buffer into a tile of a file with 'file_cols'
+ * columns
+ */
+void WriteTile(int fd, int file_cols, const Tile& tile, const double* buffer,
+               const std::string& path) {
+  for (int i = 0; i < tile.rows; ++i) {
+    std::size_t element =
+        static_cast<std::size_t>(tile.row + i) * file_cols + tile.col;
+    WriteAt(fd, buffer + static_cast<std::ptrdiff_t>(i) * tile.cols,
+            tile.cols * sizeof(double),
+            S21MatrixFile::kHeaderBytes + element * sizeof(double), path);
+  }
+}
+
+/**
+ * @brief Opens the file and checks its header against its size
+ * @param header - receives the header of the file
+ * @param file_bytes - receives the size of the file
+ * @return The open file
+ */
+int OpenMatrixFile(const std::string& path, S21MatrixFile::Header* header,
+                   std::size_t* file_bytes) {
+  int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+  if (fd < 0) ThrowFileError("Cannot open the file", path);
+  FileDescriptor guard(fd);
+
+  struct stat info;
+  if (fstat(fd, &info) < 0) ThrowFileError("Cannot stat the file", path);
+  *file_bytes = static_cast<std::size_t>(info.st_size);
+  if (*file_bytes < S21MatrixFile::kHeaderBytes) {
+    ThrowFormatError("The file is too short for a header", path);
+  }
+  ReadAt(fd, header, sizeof(*header), 0, path);
+
+  if (std::memcmp(header->magic, S21MatrixFile::kMagic,
+                  sizeof(header->magic)) != 0) {
+    ThrowFormatError("The file is not a matrix file", path);
+  } else if (header->byte_order != S21MatrixFile::kByteOrder) {
+    ThrowFormatError("The byte order differs from this machine", path);
+  } else if (header->version != S21MatrixFile::kVersion) {
+    ThrowFormatError("The format version is not supported", path);
+  } else if (header->dtype != S21MatrixFile::kFloat64) {
+    ThrowFormatError("The element type is not supported", path);
+  } else if (header->alignment != S21MatrixFile::kHeaderBytes) {
+    ThrowFormatError("The alignment is not supported", path);
+  } else if (header->rows < 1 || header->rows > INT_MAX || header->cols < 1 ||
+             header->cols > INT_MAX) {
+    ThrowFormatError("The sizes of the matrix are out of range", path);
+  } else if ((*file_bytes - S21MatrixFile::kHeaderBytes) / sizeof(double) /
+                     header->cols !=
+                 header->rows ||
+             (*file_bytes - S21MatrixFile::kHeaderBytes) %
+                     (header->cols * sizeof(double)) !=
+                 0) {
+    ThrowFormatError("The file size does not match the header", path);
+  }
+  return guard.Release();
+}
+
+}  // namespace
+
+/* Core methods -------------------------------------------------------------*/
+
+/**
+ * @brief Writes the matrix to a file
+ * @details The file is written under a temporary name and then renamed, so
+ * a matrix mapped from the old file keeps its pages and readers never see
+ * a half-written file
+ * @param matrix - the matrix that will be saved
+ * @param path - name of the file
+ */
+void S21MatrixFile::Save(const S21Matrix& matrix, const std::string& path) {
+  if (matrix.stride() != matrix.GetCols()) {
+    Save(S21Matrix(matrix), path);  // The copy has no spare columns
+    return;
+  }
+  std::size_t count =
+      static_cast<std::size_t>(matrix.GetRows()) * matrix.GetCols();
+  Header header = MakeHeader(matrix.GetRows(), matrix.GetCols(),
+                             Checksum(matrix.data(), count));
+
+  std::string temporary = path + ".tmp";
+  int fd = open(temporary.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC,
+                0644);
+  if (fd < 0) ThrowFileError("Cannot create the file", temporary);
+  try {
+    FileDescriptor guard(fd);
+    WriteAt(fd, &header, sizeof(header), 0, temporary);
+    WriteAt(fd, matrix.data(), count * sizeof(double), kHeaderBytes,
+            temporary);
+  } catch (...) {
+    unlink(temporary.c_str());
+    throw;
+  }
+  if (rename(temporary.c_str(), path.c_str()) < 0) {
+    unlink(temporary.c_str());
+    ThrowFileError("Cannot replace the file", path);
+  }
+}
+
+/**
+ * @brief Reads a matrix from a file and verifies its checksum
+ * @param path - name of the file
+ * @param resource - memory resource for the elements
+ * @return The matrix from the file
+ */
+S21Matrix S21MatrixFile::Load(const std::string& path,
+                              std::pmr::memory_resource* resource) {
+  if (!resource) {
+    throw std::invalid_argument("The memory resource is null");
+  }
+  Header header;
+  std::size_t file_bytes;
+  FileDescriptor guard(OpenMatrixFile(path, &header, &file_bytes));
+  int fd = guard.Get();
+
+  std::size_t bytes = file_bytes - kHeaderBytes;
+  auto elements =
+      static_cast<double*>(resource->allocate(bytes, S21Matrix::kAlignment));
+  S21Matrix result(static_cast<int>(header.rows), static_cast<int>(header.cols),
+                   elements, resource);
+  ReadAt(fd, elements, bytes, kHeaderBytes, path);
+  if (Checksum(elements, bytes / sizeof(double)) != header.checksum) {
+    ThrowFormatError("The checksum does not match", path);
+  }
+  return result;
+}
+
+/**
+ * @brief Maps a file as the storage of a matrix
+ * @details Nothing is read but the header: the elements are paged in by the
+ * kernel when they are first touched, so the checksum is not verified.
+ * The mapping is private, changes of the matrix never reach the file.
+ * @param path - name of the file
+ * @return The matrix that uses the mapped elements
+ */
+S21Matrix S21MatrixFile::Map(const std::string& path) {
+  Header header;
+  std::size_t file_bytes;
+  FileDescriptor guard(OpenMatrixFile(path, &header, &file_bytes));
+
+  void* base = mmap(nullptr, file_bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE,
+                    guard.Get(), 0);
+  if (base == MAP_FAILED) ThrowFileError("Cannot map the file", path);
+  auto elements = reinterpret_cast<double*>(static_cast<char*>(base) +
+                                            header.alignment);
+  auto resource = new S21MappedResource(base, file_bytes, elements);
+  return S21Matrix(static_cast<int>(header.rows),
+                   static_cast<int>(header.cols), elements, resource);
+}
+
+/**
+ * @brief Multiplies two matrix files into a third one, C = A * B
+ * @details The operands are never loaded whole. C is computed tile by tile:
+ * every tile of C is accumulated in memory from the products of a row of
+ * tiles of A and a column of tiles of B, and written to the file when it
+ * is complete. While S21Gemm multiplies the current pair of tiles, a
+ * second thread reads the next pair into the other half of a double
+ * buffer. Five square tiles (two of A, two of B, one of C) of the largest
+ * size that fits 'memory_bytes' are all the elements ever held, so the
+ * resident memory does not grow with the matrices. The file of C is
+ * written under a temporary name, its checksum is computed by reading it
+ * back in pieces of the same budget, and it is renamed at the end.
+ * @param a_path, b_path - files of A (m x k) and B (k x n)
+ * @param c_path - file of C (m x n), replaced if it exists
+ * @param memory_bytes - memory for the elements of the tiles
+ */
+void S21MatrixFile::Multiply(const std::string& a_path,
+                             const std::string& b_path,
+                             const std::string& c_path,
+                             std::size_t memory_bytes) {
+  Header a_header, b_header;
+  std::size_t a_bytes, b_bytes;
+  FileDescriptor a_file(OpenMatrixFile(a_path, &a_header, &a_bytes));
+  FileDescriptor b_file(OpenMatrixFile(b_path, &b_header, &b_bytes));
+  if (a_header.cols != b_header.rows) {
+    throw std::logic_error(
+        "The multiplication of matrices was rejected. Matrices have "
+        "different sizes");
+  }
+  int tile = static_cast<int>(std::min<double>(
+      std::sqrt(static_cast<double>(memory_bytes) / (5 * sizeof(double))),
+      INT_MAX));
+  if (tile < kMinTile) {
+    throw std::invalid_argument(
+        "The multiplication of matrices was rejected. The memory limit is "
+        "too small");
+  }
+  int m = static_cast<int>(a_header.rows);
+  int n = static_cast<int>(b_header.cols);
+  int k = static_cast<int>(a_header.cols);
+  int tile_m = std::min(tile, m), tile_n = std::min(tile, n);
+  int tile_k = std::min(tile, k);
+  long tiles_n = (n + tile_n - 1) / tile_n;
+  long tiles_k = (k + tile_k - 1) / tile_k;
+  long steps = (m + tile_m - 1) / tile_m * tiles_n * tiles_k;
+
+  // Step s multiplies A(i, l) by B(l, j) for the tile (i, j) of C
+  auto a_tile = [&](long s) {
+    int row = static_cast<int>(s / (tiles_n * tiles_k)) * tile_m;
+    int col = static_cast<int>(s % tiles_k) * tile_k;
+    return Tile{row, col, std::min(tile_m, m - row), std::min(tile_k, k - col)};
+  };
+  auto b_tile = [&](long s) {
+    int row = static_cast<int>(s % tiles_k) * tile_k;
+    int col = static_cast<int>(s / tiles_k % tiles_n) * tile_n;
+    return Tile{row, col, std::min(tile_k, k - row), std::min(tile_n, n - col)};
+  };
+
+  std::string temporary = c_path + ".tmp";
+  int fd = open(temporary.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC,
+                0644);
+  if (fd < 0) ThrowFileError("Cannot create the file", temporary);
+  FileDescriptor c_file(fd);
+  try {
+    std::size_t count = static_cast<std::size_t>(m) * n;
+    if (ftruncate(fd, static_cast<off_t>(kHeaderBytes +
+                                         count * sizeof(double))) < 0) {
+      ThrowFileError("Cannot resize the file", temporary);
+    }
+    {
+      S21Matrix a_buffers[2] = {S21Matrix(tile_m, tile_k),
+                                S21Matrix(tile_m, tile_k)};
+      S21Matrix b_buffers[2] = {S21Matrix(tile_k, tile_n),
+                                S21Matrix(tile_k, tile_n)};
+      S21Matrix c_buffer(tile_m, tile_n);
+      auto load = [&](long s) {
+        ReadTile(a_file.Get(), k, a_tile(s), a_buffers[s % 2].data(), a_path);
+        ReadTile(b_file.Get(), n, b_tile(s), b_buffers[s % 2].data(), b_path);
+      };
+      std::future<void> next = std::async(std::launch::async, load, 0);
+      for (long s = 0; s < steps; ++s) {
+        next.get();
+        if (s + 1 < steps) next = std::async(std::launch::async, load, s + 1);
+        Tile a = a_tile(s), b = b_tile(s);
+        S21Gemm(a.rows, b.cols, a.cols, 1.0, a_buffers[s % 2].data(), a.cols,
+                1, b_buffers[s % 2].data(), b.cols, 1,
+                s % tiles_k == 0 ? 0.0 : 1.0, c_buffer.data(), b.cols);
+        if (s % tiles_k == tiles_k - 1) {
+          WriteTile(fd, n, Tile{a.row, b.col, a.rows, b.cols},
+                    c_buffer.data(), temporary);
+        }
+      }
+    }
+
+    ChecksumStream checksum;
+    std::size_t piece = std::min({count, memory_bytes / sizeof(double) / 4 * 4,
+                                  std::size_t{INT_MAX} / 4 * 4});
+    S21Matrix buffer(1, static_cast<int>(piece));
+    for (std::size_t done = 0; done < count; done += piece) {
+      std::size_t size = std::min(piece, count - done);
+      ReadAt(fd, buffer.data(), size * sizeof(double),
+             kHeaderBytes + done * sizeof(double), temporary);
+      checksum.Update(buffer.data(), size);
+    }
+    Header header = MakeHeader(m, n, checksum.Finish());
+    WriteAt(fd, &header, sizeof(header), 0, temporary);
+  } catch (...) {
+    unlink(temporary.c_str());
+    throw;
+  }
+  if (rename(temporary.c_str(), c_path.c_str()) < 0) {
+    unlink(temporary.c_str());
+    ThrowFileError("Cannot replace the file", c_path);
+  }
+}
+
+/**
+ * @brief 64-bit checksum of the elements
+ * @details Four independent multiply-rotate lanes in the manner of xxHash64,
+ * fast enough to keep up with reading the file from disk
+ * @param elements - the first element
+ * @param count - number of elements
+ */
+std::uint64_t S21MatrixFile::Checksum(const double* elements,
+                                      std::size_t count) {
+  ChecksumStream stream;
+  stream.Update(elements, count);
+  return stream.Finish();
+}
+
+/* Mapped resource ----------------------------------------------------------*/
+
+S21MappedResource::S21MappedResource(void* base, std::size_t length,
+                                     double* elements)
+    : base_(base), length_(length), elements_(elements), live_blocks_(1) {}
+
+void* S21MappedResource::do_allocate(std::size_t bytes,
+                                     std::size_t alignment) {
+  void* ptr = std::pmr::new_delete_resource()->allocate(bytes, alignment);
+  live_blocks_.fetch_add(1, std::memory_order_relaxed);
+  return ptr;
+}
+
+void S21MappedResource::do_deallocate(void* ptr, std::size_t bytes,
+                                      std::size_t alignment) {
+  if (ptr == elements_) {
+    munmap(base_, length_);
+    elements_ = nullptr;
+  } else {
+    std::pmr::new_delete_resource()->deallocate(ptr, bytes, alignment);
+  }
+  Release();
+}
+
+bool S21MappedResource::do_is_equal(
+    const std::pmr::memory_resource& other) const noexcept {
+  return this == &other;
+}
+
+/**
+ * @brief Deletes the resource after its last block has been released
+ */
+void S21MappedResource::Release() {
+  if (live_blocks_.fetch_sub(1, std::memory_order_acq_rel) == 1) delete this;
+}
@@ -0,0 +1,107 @@
+/*
+ * Copyright 2023 Gleb Tolstenev
+ * yonnarge@student.21-school.ru
+ *
+ * s21_matrix_file.h is the header file for the binary file format of
+ * s21_matrix_oop library
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef SRC_S21_MATRIX_FILE_H_
+#define SRC_S21_MATRIX_FILE_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <string>
+
+#include "s21_matrix_oop.h"
+
+/**
+ * @brief Binary file format of a matrix
+ * @details A file is a header of kHeaderBytes followed by the elements,
+ * row after row, as native doubles. The header is as long as the alignment
+ * of S21Matrix, so the elements of a mapped file are aligned like the
+ * elements of any other matrix and can be used in place.
+ *
+ * The checksum covers the elements only, the sizes in the header are
+ * checked against the size of the file.
+ */
+class S21MatrixFile {
+ public:
+  static constexpr char kMagic[8] = {'S', '2', '1', 'M', 'T', 'R', 'X', '\n'};
+  static constexpr std::uint32_t kVersion = 1;
+  static constexpr std::uint32_t kFloat64 = 1;  // Element type code
+  static constexpr std::uint32_t kByteOrder = 0x01020304;
+  static constexpr std::size_t kHeaderBytes = S21Matrix::kAlignment;
+  /* Memory for the tiles of Multiply() when no limit is given */
+  static constexpr std::size_t kMultiplyBytes = std::size_t{256} << 20;
+  /* Smallest side of a tile of Multiply() */
+  static constexpr int kMinTile = 8;
+
+  /**
+   * @brief Header of the file, all fields are in the byte order of the
+   * machine that wrote it
+   */
+  struct Header {
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t dtype;
+    std::uint32_t byte_order;
+    std::uint32_t alignment;  // Offset of the first element in bytes
+    std::uint64_t rows;
+    std::uint64_t cols;
+    std::uint64_t checksum;
+    char reserved[16];
+  };
+  static_assert(sizeof(Header) == kHeaderBytes, "Header must fill one line");
+
+  static void Save(const S21Matrix& matrix, const std::string& path);
+  static S21Matrix Load(const std::string& path,
+                        std::pmr::memory_resource* resource);
+  static S21Matrix Map(const std::string& path);
+  static void Multiply(const std::string& a_path, const std::string& b_path,
+                       const std::string& c_path,
+                       std::size_t memory_bytes = kMultiplyBytes);
+  static std::uint64_t Checksum(const double* elements, std::size_t count);
+};
+
+/**
+ * @brief Memory resource that owns the mapping of a matrix file
+ * @details The elements of the mapping are handed to a S21Matrix directly
+ * and the file is unmapped when the matrix releases them. Any other
+ * request (a mapped matrix that is resized or copied with its resource)
+ * goes to new and delete. The resource deletes itself when the mapping and
+ * every block it handed out have been released.
+ */
+class S21MappedResource : public std::pmr::memory_resource {
+ public:
+  S21MappedResource(void* base, std::size_t length, double* elements);
+
+ private:
+  void* base_;  // Start of the mapping, the header included
+  std::size_t length_;
+  double* elements_;
+  std::atomic<long> live_blocks_;
+
+  void* do_allocate(std::size_t bytes, std::size_t alignment) override;
+  void do_deallocate(void* ptr, std::size_t bytes,
+                     std::size_t alignment) override;
+  bool do_is_equal(
+      const std::pmr::memory_resource& other) const noexcept override;
+  void Release();
+};
+
+#endif  // SRC_S21_MATRIX_FILE_H_
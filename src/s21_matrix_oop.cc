@@ -19,55 +19,193 @@
 
 #include "s21_matrix_oop.h"
 
+#include <algorithm>
+#include <cfloat>
+#include <climits>
+#include <vector>
+
+#include "s21_cholesky_decomposition.h"
+#include "s21_gemm.h"
+#include "s21_lu_decomposition.h"
+#include "s21_matrix_file.h"
+#include "s21_matrix_text.h"
+#include "s21_simd.h"
+#include "s21_thread_pool.h"
+#include "s21_vector.h"
+
+namespace {
+
+/* Element-wise operations on fewer elements than this stay serial */
+constexpr long kParallelElements = 1L << 16;
+
+/* Side of the square blocks of Transpose(), two blocks fit into L1 */
+constexpr int kTransposeBlock = 32;
+
+/* Odd constant that mixes the sizes into Fingerprint() */
+constexpr std::uint64_t kFingerprintPrime = 0x9E3779B97F4A7C15ULL;
+
+/**
+ * @brief Calls body(begin, end) on row ranges that cover [0, rows)
+ * @details Matrices of at least kParallelElements elements are split into
+ * row ranges that run on S21ThreadPool, smaller ones run on the caller
+ */
+template <typename Body>
+void ForEachRowRange(int rows, int cols, const Body &body) {
+  if (static_cast<long>(rows) * cols < kParallelElements) {
+    body(0, rows);
+    return;
+  }
+  long grain = std::max(1L, kParallelElements / cols);
+  S21ThreadPool::Instance().ParallelFor(
+      rows, grain, [&body](long begin, long end) {
+        body(static_cast<int>(begin), static_cast<int>(end));
+      });
+}
+
+/**
+ * @brief Tells whether the square matrix equals its transpose up to
+ * rounding: n * DBL_EPSILON of its largest element, like the pivots of
+ * S21LuDecomposition
+ */
+bool IsSymmetric(const S21Matrix &matrix) {
+  int n = matrix.GetRows();
+  double tolerance = 0.0;
+  for (int i = 0; i < n; ++i) {
+    for (int j = 0; j < n; ++j) {
+      tolerance = std::max(tolerance, fabs(matrix.GetVal(i, j)));
+    }
+  }
+  tolerance *= n * DBL_EPSILON;
+  for (int i = 0; i < n; ++i) {
+    for (int j = 0; j < i; ++j) {
+      if (fabs(matrix.GetVal(i, j) - matrix.GetVal(j, i)) > tolerance) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+}  // namespace
+
 /* Constructors and destructors ---------------------------------------------*/
 
 /**
  * @brief Default constructor
  */
 S21Matrix::S21Matrix()
-    : rows_(3), cols_(3), matrix_(NewArrayOfElements(3, 3)) {}
+    : rows_(3),
+      cols_(3),
+      stride_(3),
+      capacity_(9),
+      resource_(std::pmr::get_default_resource()),
+      matrix_(NewArrayOfElements(3, 3)) {}
 
 /**
  * @brief Parameterized constructor
  * @param rows - number of rows
  * @param cols - number of colomns
+ * @param resource - memory resource for the elements, the default resource
+ * of the program (plain new and delete unless changed) when omitted
  */
-S21Matrix::S21Matrix(int rows, int cols) {
+S21Matrix::S21Matrix(int rows, int cols, std::pmr::memory_resource *resource) {
   if (rows < 1) {
     throw std::invalid_argument("The number of rows is lower than 1");
   } else if (cols < 1) {
     throw std::invalid_argument("The number of columns is lower than 1");
+  } else if (!resource) {
+    throw std::invalid_argument("The memory resource is null");
   } else {
+    S21_INSTRUMENT(INSTRUMENT_CONSTRUCT, 0, 8.0 * rows * cols);
     rows_ = rows;
     cols_ = cols;
+    stride_ = cols;
+    capacity_ = static_cast<std::size_t>(rows) * cols;
+    resource_ = resource;
     matrix_ = NewArrayOfElements(rows, cols);
   }
 }
 
 /**
  * @brief Copy constructor
+ * @details Like the std::pmr containers, the copy takes its storage from
+ * the default resource rather than from the resource of 'other'
  * @param other - reference to the matrix that will be copied
  */
 S21Matrix::S21Matrix(const S21Matrix &other)
-    : rows_(other.rows_), cols_(other.cols_) {
+    : S21Matrix(other, std::pmr::get_default_resource()) {}
+
+/**
+ * @brief Copy constructor with a memory resource
+ * @param other - reference to the matrix that will be copied
+ * @param resource - memory resource for the elements of the copy
+ */
+S21Matrix::S21Matrix(const S21Matrix &other,
+                     std::pmr::memory_resource *resource)
+    : rows_(other.rows_),
+      cols_(other.cols_),
+      stride_(other.cols_),
+      capacity_(static_cast<std::size_t>(other.rows_) * other.cols_),
+      resource_(resource),
+      fingerprint_(other.fingerprint_.load(std::memory_order_relaxed)) {
+  if (!resource) {
+    throw std::invalid_argument("The memory resource is null");
+  }
+  S21_INSTRUMENT(INSTRUMENT_COPY, 0, 16.0 * rows_ * cols_);
   matrix_ = NewArrayOfElements(other.rows_, other.cols_);
   CopyArrayOfElements(other);
 }
 
 /**
  * @brief Move constructor
+ * @details The storage is taken over together with its memory resource.
+ * 'other' falls back to the default resource, which outlives it in any
+ * case.
  * @param other
  */
 S21Matrix::S21Matrix(S21Matrix &&other) noexcept {
   rows_ = other.rows_;
   cols_ = other.cols_;
+  stride_ = other.stride_;
+  capacity_ = other.capacity_;
+  resource_ = other.resource_;
   matrix_ = other.matrix_;
+  fingerprint_.store(other.fingerprint_.load(std::memory_order_relaxed),
+                     std::memory_order_relaxed);
 
   other.rows_ = 0;
   other.cols_ = 0;
+  other.stride_ = 0;
+  other.capacity_ = 0;
+  other.resource_ = std::pmr::get_default_resource();
   other.matrix_ = nullptr;
+  other.InvalidateFingerprint();
 }
 
+/**
+ * @brief Maps a matrix file as the storage of the matrix
+ * @details The file is not read: opening a matrix of any size takes the
+ * same time and its pages are loaded when they are first touched. Changes
+ * of the matrix stay in memory, use Save() to write them. The checksum is
+ * not verified, use Load() for that. See S21MatrixFile for the format.
+ * @param path - name of a file written by Save()
+ */
+S21Matrix::S21Matrix(const std::string &path)
+    : S21Matrix(S21MatrixFile::Map(path)) {}
+
+/**
+ * @brief Takes over a block of rows * cols elements allocated from
+ * 'resource'
+ */
+S21Matrix::S21Matrix(int rows, int cols, double *elements,
+                     std::pmr::memory_resource *resource) noexcept
+    : rows_(rows),
+      cols_(cols),
+      stride_(cols),
+      capacity_(static_cast<std::size_t>(rows) * cols),
+      resource_(resource),
+      matrix_(elements) {}
+
 /**
  * @brief Destructor
  */
@@ -76,14 +214,17 @@ S21Matrix::~S21Matrix() { DeleteArrayOfElements(); }
 /* Memory management functions ----------------------------------------*/
 
 /**
- * @brief Allocate memory for matrix elements
+ * @brief Allocate one zero-initialized block for all matrix elements
+ * @details The block is aligned to kAlignment bytes and stores the rows
+ * one after another, so a matrix of any shape costs a single allocation
+ * from resource_
  * @return Pointer to the allocated memory
  */
-double **S21Matrix::NewArrayOfElements(int rows, int cols) const {
-  auto elements = new double *[rows]();
-  for (int i = 0; i < rows; ++i) {
-    elements[i] = new double[cols]();
-  }
+double *S21Matrix::NewArrayOfElements(int rows, int cols) const {
+  std::size_t bytes = static_cast<std::size_t>(rows) * cols * sizeof(double);
+  auto elements = static_cast<double *>(resource_->allocate(bytes, kAlignment));
+  S21_INSTRUMENT_ALLOCATION(bytes);
+  std::memset(elements, 0, bytes);
   return elements;
 }
 
@@ -92,22 +233,24 @@ double **S21Matrix::NewArrayOfElements(int rows, int cols) const {
  * @param other - reference to the matrix whose elements will be copied
  */
 void S21Matrix::CopyArrayOfElements(const S21Matrix &other) {
-  for (int i = 0; i < rows_; ++i) {
-    for (int j = 0; j < cols_; ++j) {
-      matrix_[i][j] = other.matrix_[i][j];
+  if (stride_ == cols_ && other.stride_ == cols_) {
+    std::memcpy(matrix_, other.matrix_,
+                static_cast<std::size_t>(rows_) * cols_ * sizeof(double));
+  } else {
+    for (int i = 0; i < rows_; ++i) {
+      std::memcpy(Row(i), other.Row(i), cols_ * sizeof(double));
     }
   }
 }
 
 /**
  * @brief Delete allocated memory for matrix elements
+ * @details Must be called before capacity_ changes, because the resource
+ * is told the size of the block
  */
 void S21Matrix::DeleteArrayOfElements() {
   if (matrix_) {
-    for (int i = 0; i < rows_; ++i) {
-      delete[] matrix_[i];
-    }
-    delete[] matrix_;
+    resource_->deallocate(matrix_, capacity_ * sizeof(double), kAlignment);
   }
 }
 
@@ -115,50 +258,90 @@ void S21Matrix::DeleteArrayOfElements() {
 
 /**
  * @brief Overload of '=' for matrices
+ * @details The current storage is reused when the sizes match, otherwise
+ * the new storage is allocated before the old one is released
  * @param other - the matrix that will be assigned
  * @return reference to the new matrix
  */
-S21Matrix &S21Matrix::operator=(
-    const S21Matrix &other) {  // TODO: Add self-assignment properly
-  DeleteArrayOfElements();
-  rows_ = other.rows_;
-  cols_ = other.cols_;
-  matrix_ = NewArrayOfElements(other.rows_, other.cols_);
-  CopyArrayOfElements(other);
+S21Matrix &S21Matrix::operator=(const S21Matrix &other) {
+  if (this != &other) {
+    S21_INSTRUMENT(INSTRUMENT_COPY_ASSIGNMENT, 0,
+                   16.0 * other.rows_ * other.cols_);
+    if (rows_ == other.rows_ && cols_ == other.cols_ && matrix_) {
+      CopyArrayOfElements(other);
+    } else {
+      double *elements = NewArrayOfElements(other.rows_, other.cols_);
+      DeleteArrayOfElements();
+      rows_ = other.rows_;
+      cols_ = other.cols_;
+      stride_ = other.cols_;
+      capacity_ = static_cast<std::size_t>(rows_) * cols_;
+      matrix_ = elements;
+      CopyArrayOfElements(other);
+    }
+    fingerprint_.store(other.fingerprint_.load(std::memory_order_relaxed),
+                       std::memory_order_relaxed);
+  }
   return *this;
 }
 
 /**
- * @brief Overload of '+' for matrices
- * @param other - the matrix that will be added
- * @return Matrix with result of addition
+ * @brief Move assignment, takes over the storage of 'other'
+ * @details The memory resource of 'other' is taken over as well, so the
+ * storage is always released to the resource it came from
+ * @param other - the matrix that will be moved, it is left empty (0 x 0)
+ * @return reference to the current matrix
  */
-S21Matrix S21Matrix::operator+(const S21Matrix &other) const {
-  S21Matrix result(*this);
-  result.SumMatrix(other);
-  return result;
+S21Matrix &S21Matrix::operator=(S21Matrix &&other) noexcept {
+  if (this != &other) {
+    DeleteArrayOfElements();
+    rows_ = other.rows_;
+    cols_ = other.cols_;
+    stride_ = other.stride_;
+    capacity_ = other.capacity_;
+    resource_ = other.resource_;
+    matrix_ = other.matrix_;
+    fingerprint_.store(other.fingerprint_.load(std::memory_order_relaxed),
+                       std::memory_order_relaxed);
+
+    other.rows_ = 0;
+    other.cols_ = 0;
+    other.stride_ = 0;
+    other.capacity_ = 0;
+    other.resource_ = std::pmr::get_default_resource();
+    other.matrix_ = nullptr;
+    other.InvalidateFingerprint();
+  }
+  return *this;
 }
 
 /**
- * @brief Overload of '-' for matrices
- * @param other - the matrix that will be subtract
- * @return Matrix with result of subtraction
+ * @brief Overload of '+' for two temporary matrices
+ * @return Matrix with result of addition in the storage of 'lhs'
  */
-S21Matrix S21Matrix::operator-(const S21Matrix &other) const {
-  S21Matrix result(*this);
-  result.SubMatrix(other);
-  return result;
+S21Matrix operator+(S21Matrix &&lhs, S21Matrix &&rhs) {
+  lhs.SumMatrix(rhs);
+  return std::move(lhs);
+}
+
+/**
+ * @brief Overload of '-' for two temporary matrices
+ * @return Matrix with result of subtraction in the storage of 'lhs'
+ */
+S21Matrix operator-(S21Matrix &&lhs, S21Matrix &&rhs) {
+  lhs.SubMatrix(rhs);
+  return std::move(lhs);
 }
 
 /**
- * @brief Overload of '*' for matrices that will be multiply by a number 'num'
+ * @brief Overload of '*' that reuses the storage of a temporary matrix
+ * @param matrix - the temporary matrix, receives the result
  * @param num - the number by which the matrix will be multiplied
  * @return Matrix with result of multiplication
  */
-S21Matrix S21Matrix::operator*(const double num) const {
-  S21Matrix result(*this);
-  result.MulNumber(num);
-  return result;
+S21Matrix operator*(S21Matrix &&matrix, const double num) {
+  matrix.MulNumber(num);
+  return std::move(matrix);
 }
 
 /**
@@ -167,8 +350,13 @@ S21Matrix S21Matrix::operator*(const double num) const {
  * @return Matrix with result of multiplication
  */
 S21Matrix S21Matrix::operator*(const S21Matrix &other) const {
-  S21Matrix result(*this);
-  result.MulMatrix(other);
+  S21_INSTRUMENT(INSTRUMENT_PRODUCT, 2.0 * rows_ * cols_ * other.cols_,
+                 8.0 * (rows_ * (cols_ + other.cols_) +
+                        static_cast<double>(cols_) * other.cols_));
+  CheckSizesFor(MUL_MATRIX, other);
+  S21Matrix result(rows_, other.cols_, resource_);
+  S21Gemm(rows_, other.cols_, cols_, 1.0, matrix_, stride_, 1, other.matrix_,
+          other.stride_, 1, 0.0, result.matrix_, result.stride_);
   return result;
 }
 
@@ -182,7 +370,8 @@ double &S21Matrix::operator()(int row, int col) {
   if (row < 0 || row >= rows_ || col < 0 || col >= cols_)
     throw std::out_of_range(
         "Attempt to access to element of matrix by index outside of the range");
-  return matrix_[row][col];
+  InvalidateFingerprint();
+  return Row(row)[col];
 }
 
 /**
@@ -191,7 +380,7 @@ double &S21Matrix::operator()(int row, int col) {
  * @return true - martices is equal;
  *         false - martices is different.
  */
-bool S21Matrix::operator==(const S21Matrix &other) {
+bool S21Matrix::operator==(const S21Matrix &other) const {
   return this->EqMatrix(other);
 }
 
@@ -243,17 +432,18 @@ S21Matrix &S21Matrix::operator*=(const S21Matrix &other) {
  * @return true - martices is equal;
  *         false - martices is different.
  */
-bool S21Matrix::EqMatrix(const S21Matrix &other) {
+bool S21Matrix::EqMatrix(const S21Matrix &other) const {
+  S21_INSTRUMENT(INSTRUMENT_EQ_MATRIX, 1.0 * rows_ * cols_,
+                 16.0 * rows_ * cols_);
   bool is_equal = true;
   if (rows_ != other.rows_ || cols_ != other.cols_) {
     is_equal = false;
+  } else if (stride_ == cols_ && other.stride_ == cols_) {
+    is_equal = S21Simd::Equal(matrix_, other.matrix_,
+                              static_cast<std::size_t>(rows_) * cols_, EPS);
   } else {
     for (int i = 0; (i < rows_) && is_equal; ++i) {
-      for (int j = 0; (j < cols_) && is_equal; ++j) {
-        if (fabs(matrix_[i][j] - other.matrix_[i][j]) > EPS) {
-          is_equal = false;
-        }
-      }
+      is_equal = S21Simd::Equal(Row(i), other.Row(i), cols_, EPS);
     }
   }
   return is_equal;
@@ -264,13 +454,22 @@ bool S21Matrix::EqMatrix(const S21Matrix &other) {
  * @param other - the matrix that will be added
  */
 void S21Matrix::SumMatrix(const S21Matrix &other) {
+  S21_INSTRUMENT(INSTRUMENT_SUM_MATRIX, 1.0 * rows_ * cols_,
+                 24.0 * rows_ * cols_);
   CheckSizesFor(SUM, other);
+  InvalidateFingerprint();
 
-  for (int i = 0; i < rows_; ++i) {
-    for (int j = 0; j < cols_; ++j) {
-      matrix_[i][j] = matrix_[i][j] + other.matrix_[i][j];
+  bool contiguous = stride_ == cols_ && other.stride_ == cols_;
+  ForEachRowRange(rows_, cols_, [&](int begin, int end) {
+    if (contiguous) {
+      S21Simd::Add(Row(begin), other.Row(begin),
+                   static_cast<std::size_t>(end - begin) * cols_);
+    } else {
+      for (int i = begin; i < end; ++i) {
+        S21Simd::Add(Row(i), other.Row(i), cols_);
+      }
     }
-  }
+  });
 }
 
 /**
@@ -278,13 +477,22 @@ void S21Matrix::SumMatrix(const S21Matrix &other) {
  * @param other - the matrix that will be subtract
  */
 void S21Matrix::SubMatrix(const S21Matrix &other) {
+  S21_INSTRUMENT(INSTRUMENT_SUB_MATRIX, 1.0 * rows_ * cols_,
+                 24.0 * rows_ * cols_);
   CheckSizesFor(SUB, other);
+  InvalidateFingerprint();
 
-  for (int i = 0; i < rows_; ++i) {
-    for (int j = 0; j < cols_; ++j) {
-      matrix_[i][j] = matrix_[i][j] - other.matrix_[i][j];
+  bool contiguous = stride_ == cols_ && other.stride_ == cols_;
+  ForEachRowRange(rows_, cols_, [&](int begin, int end) {
+    if (contiguous) {
+      S21Simd::Sub(Row(begin), other.Row(begin),
+                   static_cast<std::size_t>(end - begin) * cols_);
+    } else {
+      for (int i = begin; i < end; ++i) {
+        S21Simd::Sub(Row(i), other.Row(i), cols_);
+      }
     }
-  }
+  });
 }
 
 /**
@@ -292,53 +500,398 @@ void S21Matrix::SubMatrix(const S21Matrix &other) {
  * @param num - the number by which the matrix will be multiplied
  */
 void S21Matrix::MulNumber(const double num) {
-  for (int i = 0; i < rows_; ++i) {
-    for (int j = 0; j < cols_; ++j) {
-      matrix_[i][j] *= num;
+  S21_INSTRUMENT(INSTRUMENT_MUL_NUMBER, 1.0 * rows_ * cols_,
+                 16.0 * rows_ * cols_);
+  InvalidateFingerprint();
+  bool contiguous = stride_ == cols_;
+  ForEachRowRange(rows_, cols_, [&](int begin, int end) {
+    if (contiguous) {
+      S21Simd::Scale(Row(begin), num,
+                     static_cast<std::size_t>(end - begin) * cols_);
+    } else {
+      for (int i = begin; i < end; ++i) S21Simd::Scale(Row(i), num, cols_);
     }
-  }
+  });
 }
 
 /**
  * @brief Multiplies a matrix by the other one
+ * @details The product is computed by the cache-blocked kernel from
+ * s21_gemm.h
  * @param other - the matrix that will be multiplied
  */
 void S21Matrix::MulMatrix(const S21Matrix &other) {
+  S21_INSTRUMENT(INSTRUMENT_MUL_MATRIX, 2.0 * rows_ * cols_ * other.cols_,
+                 8.0 * (rows_ * (cols_ + other.cols_) +
+                        static_cast<double>(cols_) * other.cols_));
   CheckSizesFor(MUL_MATRIX, other);
 
-  double **tmp = NewArrayOfElements(rows_, other.cols_);
-  for (int i = 0; i < rows_; ++i) {
-    for (int j = 0; j < other.cols_; ++j) {
-      for (int k = 0; k < cols_; ++k) {
-        tmp[i][j] += matrix_[i][k] * other.matrix_[k][j];
-      }
-    }
+  double *tmp = NewArrayOfElements(rows_, other.cols_);
+  try {
+    S21Gemm(rows_, other.cols_, cols_, 1.0, matrix_, stride_, 1,
+            other.matrix_, other.stride_, 1, 0.0, tmp, other.cols_);
+  } catch (...) {
+    resource_->deallocate(
+        tmp, static_cast<std::size_t>(rows_) * other.cols_ * sizeof(double),
+        kAlignment);
+    throw;
   }
 
+  InvalidateFingerprint();
   DeleteArrayOfElements();
   cols_ = other.cols_;
+  stride_ = other.cols_;
+  capacity_ = static_cast<std::size_t>(rows_) * cols_;
   matrix_ = tmp;
 }
 
+/**
+ * @brief Multiplies the current matrix by 'other' with the Strassen-Winograd
+ * recursion
+ * @details Same as MulMatrix() for products with a dimension up to
+ * 'crossover'. Larger products need about 7/8 of the multiply-adds per
+ * level of recursion, at the cost of a workspace and of a few digits of
+ * accuracy, see S21Strassen().
+ * @param other - the matrix that will be multiplied
+ * @param crossover - largest dimension multiplied by the classical product
+ */
+void S21Matrix::MulMatrixStrassen(const S21Matrix &other, int crossover) {
+  S21_INSTRUMENT(INSTRUMENT_MUL_MATRIX_STRASSEN,
+                 2.0 * rows_ * cols_ * other.cols_,
+                 8.0 * (rows_ * (cols_ + other.cols_) +
+                        static_cast<double>(cols_) * other.cols_));
+  CheckSizesFor(MUL_MATRIX, other);
+
+  double *tmp = NewArrayOfElements(rows_, other.cols_);
+  try {
+    S21Strassen(rows_, other.cols_, cols_, matrix_, stride_, other.matrix_,
+                other.stride_, tmp, other.cols_, crossover);
+  } catch (...) {
+    resource_->deallocate(
+        tmp, static_cast<std::size_t>(rows_) * other.cols_ * sizeof(double),
+        kAlignment);
+    throw;
+  }
+
+  InvalidateFingerprint();
+  DeleteArrayOfElements();
+  cols_ = other.cols_;
+  stride_ = other.cols_;
+  capacity_ = static_cast<std::size_t>(rows_) * cols_;
+  matrix_ = tmp;
+}
+
+/**
+ * @brief Computes the current matrix as alpha * op(A) * op(B) + beta * it
+ * @details op(X) is X or, when 'transpose_x' is set, X transposed. The
+ * product is written straight into the current storage by S21Gemm and a
+ * transposed operand is read through swapped strides, so nothing is
+ * allocated. The only exception is an operand that is the current matrix
+ * itself: it is copied first. When beta is 0 the previous elements are
+ * never read.
+ * @param alpha - scale of the product
+ * @param a, transpose_a - first operand, op(A) has as many rows as the
+ * current matrix
+ * @param b, transpose_b - second operand, op(B) has as many columns as the
+ * current matrix and as many rows as op(A) has columns
+ * @param beta - scale of the current elements
+ */
+void S21Matrix::Gemm(double alpha, const S21Matrix &a, bool transpose_a,
+                     const S21Matrix &b, bool transpose_b, double beta) {
+  int m = transpose_a ? a.cols_ : a.rows_;
+  int k = transpose_a ? a.rows_ : a.cols_;
+  int n = transpose_b ? b.rows_ : b.cols_;
+  if ((transpose_b ? b.cols_ : b.rows_) != k || m != rows_ || n != cols_) {
+    throw std::logic_error(
+        "The multiplication of matrices was rejected. Matrices have "
+        "different sizes");
+  }
+  if (&a == this || &b == this) {
+    S21Matrix copy(*this, resource_);
+    Gemm(alpha, &a == this ? copy : a, transpose_a, &b == this ? copy : b,
+         transpose_b, beta);
+    return;
+  }
+
+  S21_INSTRUMENT(INSTRUMENT_GEMM, 2.0 * m * n * k,
+                 8.0 * (m * (k + 2.0 * n) + static_cast<double>(k) * n));
+  InvalidateFingerprint();
+  S21Gemm(m, n, k, alpha, a.matrix_, transpose_a ? 1 : a.stride_,
+          transpose_a ? a.stride_ : 1, b.matrix_, transpose_b ? 1 : b.stride_,
+          transpose_b ? b.stride_ : 1, beta, matrix_, stride_);
+}
+
+/**
+ * @brief Adds the rank-1 matrix alpha * x * y^T to the current matrix
+ * @details Every row gets y scaled by alpha and its element of x, one
+ * SIMD pass per row; large matrices are split between threads by rows
+ * @param alpha - scale of the update
+ * @param x - vector with as many elements as the matrix has rows
+ * @param y - vector with as many elements as the matrix has columns
+ */
+void S21Matrix::Ger(double alpha, const S21Vector &x, const S21Vector &y) {
+  if (x.GetSize() != rows_ || y.GetSize() != cols_) {
+    throw std::logic_error(
+        "The rank-1 update was rejected. Sizes do not match");
+  }
+  S21_INSTRUMENT(INSTRUMENT_GER, 2.0 * rows_ * cols_,
+                 8.0 * (2.0 * rows_ * cols_ + rows_ + cols_));
+  InvalidateFingerprint();
+  const double *x_data = x.data();
+  ForEachRowRange(rows_, cols_, [&](int begin, int end) {
+    for (int i = begin; i < end; ++i) {
+      S21Simd::Axpy(Row(i), alpha * x_data[i], y.data(), cols_);
+    }
+  });
+}
+
 /**
  * @brief Creates a new transposed matrix from the current one and returns it
+ * @details The matrix is transposed in kTransposeBlock x kTransposeBlock
+ * blocks, so both the reads and the writes of a block stay in L1 and touch
+ * few pages. Each block is transposed in SIMD registers by S21Simd.
  * @return transposed matrix
  */
-S21Matrix S21Matrix::Transpose() {
-  S21Matrix tmp(cols_, rows_);
-  for (int i = 0; i < tmp.rows_; ++i) {
-    for (int j = 0; j < tmp.cols_; ++j) {
-      tmp.matrix_[i][j] = matrix_[j][i];
+S21Matrix S21Matrix::Transpose() const {
+  S21_INSTRUMENT(INSTRUMENT_TRANSPOSE, 0, 16.0 * rows_ * cols_);
+  S21Matrix tmp(cols_, rows_, resource_);
+  ForEachRowRange(tmp.rows_, tmp.cols_, [&](int begin, int end) {
+    for (int jb = begin; jb < end; jb += kTransposeBlock) {
+      int block_cols = std::min(kTransposeBlock, end - jb);
+      for (int ib = 0; ib < rows_; ib += kTransposeBlock) {
+        int block_rows = std::min(kTransposeBlock, rows_ - ib);
+        S21Simd::Transpose(Row(ib) + jb, stride_, tmp.Row(jb) + ib,
+                           tmp.stride_, block_rows, block_cols);
+      }
     }
-  }
+  });
   return tmp;
 }
 
-// S21Matrix S21Matrix::CalcComplements() {}
+/**
+ * @brief Transposes the current matrix without a second matrix
+ * @details Square matrices exchange pairs of blocks across the diagonal
+ * through a small buffer on the stack. Other shapes move every element
+ * along the cycles of the permutation, which needs only one bit of extra
+ * memory per element but reads the memory in a scattered order.
+ */
+void S21Matrix::TransposeInPlace() {
+  S21_INSTRUMENT(INSTRUMENT_TRANSPOSE_IN_PLACE, 0, 16.0 * rows_ * cols_);
+  InvalidateFingerprint();
+  if (rows_ == cols_) {
+    TransposeSquareInPlace();
+  } else {
+    TransposeByCycles();
+  }
+}
+
+/* Accessors and mutators ------------------------------------------------*/
 
-// double S21Matrix::Determinant() {}
+/**
+ * @brief Sets the number of threads used by the matrix operations
+ * @details 1 makes every operation serial. Operations on small matrices
+ * stay on the calling thread whatever the setting is.
+ * @param num_threads - number of threads including the calling one
+ */
+void S21Matrix::SetNumThreads(int num_threads) {
+  S21ThreadPool::Instance().SetNumThreads(num_threads);
+}
 
-// S21Matrix S21Matrix::InverseMatrix() {}
+/**
+ * @brief Returns the number of threads used by the matrix operations
+ */
+int S21Matrix::GetNumThreads() {
+  return S21ThreadPool::Instance().GetNumThreads();
+}
+
+/**
+ * @brief Changes the number of rows, new rows are filled with zeros
+ * @details Like std::vector, the storage keeps room for GetRowCapacity()
+ * rows: shrinking and growing within it never reallocate. Growing past it
+ * at least doubles the capacity, so adding rows one by one costs amortized
+ * O(1) copies per row.
+ * @param new_rows - number of rows, at least 1
+ */
+void S21Matrix::SetRows(int new_rows) {
+  if (new_rows < 1) {
+    throw std::invalid_argument("The number of rows is lower than 1");
+  }
+  InvalidateFingerprint();
+  int row_capacity = GetRowCapacity();
+  if (new_rows > row_capacity) {
+    long doubled = std::min(2L * row_capacity, static_cast<long>(INT_MAX));
+    Reallocate(std::max(new_rows, static_cast<int>(doubled)), cols_);
+  } else if (new_rows > rows_) {
+    for (int i = rows_; i < new_rows; ++i) {
+      std::memset(Row(i), 0, cols_ * sizeof(double));
+    }
+  }
+  rows_ = new_rows;
+}
+
+/**
+ * @brief Changes the number of columns, new columns are filled with zeros
+ * @details Rows keep their place in the storage as long as they fit into
+ * the stride, so shrinking never reallocates and leaves spare columns at
+ * the end of every row, which the operations skip. Growing past the
+ * stride moves the rows into a block without spare columns.
+ * @param new_cols - number of columns, at least 1
+ */
+void S21Matrix::SetCols(int new_cols) {
+  if (new_cols < 1) {
+    throw std::invalid_argument("The number of columns is lower than 1");
+  }
+  InvalidateFingerprint();
+  if (new_cols > stride_) {
+    Reallocate(GetRowCapacity(), new_cols);
+  } else if (new_cols > cols_) {
+    for (int i = 0; i < rows_; ++i) {
+      std::memset(Row(i) + cols_, 0, (new_cols - cols_) * sizeof(double));
+    }
+  }
+  cols_ = new_cols;
+}
+
+/**
+ * @brief Makes room for 'row_capacity' rows without changing the matrix
+ * @details Never shrinks the storage
+ * @param row_capacity - number of rows that fit without a reallocation
+ */
+void S21Matrix::ReserveRows(int row_capacity) {
+  if (row_capacity > GetRowCapacity()) Reallocate(row_capacity, cols_);
+}
+
+/**
+ * @brief Adds a row of zeros after the last row
+ */
+void S21Matrix::AppendRow() { SetRows(rows_ + 1); }
+
+/**
+ * @brief Adds a copy of a 1 x cols matrix after the last row
+ * @param row - the row that will be appended, may be the matrix itself
+ */
+void S21Matrix::AppendRow(const S21Matrix &row) {
+  CheckSizesFor(APPEND_ROW, 1, cols_, row.rows_, row.cols_);
+  SetRows(rows_ + 1);
+  std::memcpy(Row(rows_ - 1), row.Row(0), cols_ * sizeof(double));
+}
+
+/**
+ * @brief Returns a hash of the sizes and of the bits of the elements
+ * @details The hash is computed by the first call and kept until a method
+ * that may change the elements is called, operator() and data() included.
+ * Writes through a pointer, reference or view taken before that call are
+ * not noticed. Copies inherit the fingerprint of the original.
+ *
+ * Equal fingerprints mean equal elements bit for bit, but for a collision
+ * chance of about 2^-64 per pair. Unlike EqMatrix() there is no tolerance,
+ * and 0.0 differs from -0.0.
+ * @return The fingerprint, never 0
+ */
+std::uint64_t S21Matrix::Fingerprint() const {
+  std::uint64_t fingerprint = fingerprint_.load(std::memory_order_relaxed);
+  if (fingerprint) return fingerprint;
+  if (stride_ != cols_) {
+    fingerprint = S21Matrix(*this).Fingerprint();  // Hash the packed rows
+  } else {
+    fingerprint = S21MatrixFile::Checksum(
+        matrix_, static_cast<std::size_t>(rows_) * cols_);
+    fingerprint ^= (static_cast<std::uint64_t>(rows_) << 32 |
+                    static_cast<std::uint32_t>(cols_)) *
+                   kFingerprintPrime;
+    fingerprint += !fingerprint;
+  }
+  fingerprint_.store(fingerprint, std::memory_order_relaxed);
+  return fingerprint;
+}
+
+/**
+ * @brief Calculates the matrix of algebraic complements
+ * @details The complements are the transposed adjugate, det(A) * A^-T, so
+ * one LU decomposition gives all of them in O(n^3). Singular matrices, which
+ * have no inverse, take CalcComplementsOfSingular(), also O(n^3).
+ * @return The matrix of algebraic complements
+ */
+S21Matrix S21Matrix::CalcComplements() const {
+  S21_INSTRUMENT(INSTRUMENT_CALC_COMPLEMENTS, 2.0 * rows_ * rows_ * cols_,
+                 32.0 * rows_ * cols_);
+  CheckSizesFor(CALC_COMPLEMENTS, *this);
+  S21LuDecomposition lu(*this);
+  if (lu.IsSingular()) return CalcComplementsOfSingular();
+
+  S21Matrix result = lu.InverseMatrix().Transpose();
+  result.MulNumber(lu.Determinant());
+  return result;
+}
+
+/**
+ * @brief Calculates the determinant of the current matrix
+ * @details Uses the LU decomposition, see S21LuDecomposition
+ * @return The determinant
+ */
+double S21Matrix::Determinant() const {
+  S21_INSTRUMENT(INSTRUMENT_DETERMINANT, 2.0 / 3.0 * rows_ * rows_ * cols_,
+                 16.0 * rows_ * cols_);
+  CheckSizesFor(DETERMINANT, *this);
+  return S21LuDecomposition(*this).Determinant();
+}
+
+/**
+ * @brief Calculates the inverse of the current matrix
+ * @details Uses the LU decomposition, see S21LuDecomposition
+ * @return The inverse matrix
+ */
+S21Matrix S21Matrix::InverseMatrix() const {
+  S21_INSTRUMENT(INSTRUMENT_INVERSE_MATRIX, 2.0 * rows_ * rows_ * cols_,
+                 24.0 * rows_ * cols_);
+  CheckSizesFor(INVERSE_MATRIX, *this);
+  return S21LuDecomposition(*this).InverseMatrix();
+}
+
+/**
+ * @brief Solves the linear system A * X = B, A is the current matrix
+ * @details Every column of B is a right-hand side. A matrix that is
+ * symmetric up to rounding relative to its largest element is tried with
+ * S21CholeskyDecomposition first and any other one, or one that turns out
+ * not to be positive definite, is solved by S21LuDecomposition.
+ * Solving is cheaper and more accurate than multiplying by the inverse; to
+ * solve several B with one A keep a decomposition and call its Solve().
+ * @param other - B, with as many rows as the current matrix
+ * @return X, with the sizes of B
+ */
+S21Matrix S21Matrix::Solve(const S21Matrix &other) const {
+  S21_INSTRUMENT(INSTRUMENT_SOLVE,
+                 2.0 / 3.0 * rows_ * rows_ * cols_ +
+                     2.0 * rows_ * rows_ * other.cols_,
+                 16.0 * rows_ * cols_ + 16.0 * other.rows_ * other.cols_);
+  CheckSizesFor(SOLVE, other);
+  if (IsSymmetric(*this)) {
+    S21CholeskyDecomposition cholesky(*this);
+    if (cholesky.IsPositiveDefinite()) return cholesky.Solve(other);
+  }
+  return S21LuDecomposition(*this).Solve(other);
+}
+
+/**
+ * @brief Reads a matrix written by Save() and verifies its checksum
+ * @details The elements are read with a few large reads straight into the
+ * storage of the matrix
+ * @param path - name of the file
+ * @param resource - memory resource for the elements
+ * @return The matrix from the file
+ */
+S21Matrix S21Matrix::Load(const std::string &path,
+                          std::pmr::memory_resource *resource) {
+  return S21MatrixFile::Load(path, resource);
+}
+
+/**
+ * @brief Writes the matrix to a binary file, see S21MatrixFile
+ * @param path - name of the file, replaced if it exists
+ */
+void S21Matrix::Save(const std::string &path) const {
+  S21MatrixFile::Save(*this, path);
+}
 
 /* Help methods ---------------------------------------------------------*/
 
@@ -350,22 +903,288 @@ S21Matrix S21Matrix::Transpose() {
  */
 void S21Matrix::CheckSizesFor(int type_of_operation,
                               const S21Matrix &other) const {
-  if (this->GetRows() != other.GetRows() ||
-      this->GetCols() != other.GetCols()) {
+  CheckSizesFor(type_of_operation, rows_, cols_, other.rows_, other.cols_);
+}
+
+/**
+ * @brief Compare the sizes of two matrices for different operation
+ * @param type_of_operation - numeric code of operation described in enum
+ * 'types_of_operation' (SUM = 1, SUB = 2, etc.)
+ * @param rows, cols - size of the left operand
+ * @param other_rows, other_cols - size of the right operand
+ */
+void S21Matrix::CheckSizesFor(int type_of_operation, int rows, int cols,
+                              int other_rows, int other_cols) {
+  if (rows != other_rows || cols != other_cols) {
     if (type_of_operation == SUM)
       throw std::logic_error(
           "The addition was rejected. Matrices have different sizes");
     if (type_of_operation == SUB)
       throw std::logic_error(
           "The subtraction was rejected. Matrices have different sizes");
+    if (type_of_operation == ASSIGNMENT)
+      throw std::logic_error(
+          "The assignment was rejected. Matrices have different sizes");
+    if (type_of_operation == APPEND_ROW)
+      throw std::logic_error(
+          "The append of the row was rejected. Matrices have different "
+          "sizes");
   }
-  if (this->GetRows() != other.GetCols() ||
-      this->GetCols() != other.GetRows()) {
+  if (rows != other_cols || cols != other_rows) {
     if (type_of_operation == MUL_MATRIX)
       throw std::logic_error(
           "The multiplication of matrices was rejected. Matrices have "
           "different sizes");
   }
+  if (rows != cols) {
+    if (type_of_operation == CALC_COMPLEMENTS)
+      throw std::logic_error(
+          "The calculation of complements was rejected. The matrix is not "
+          "square");
+    if (type_of_operation == DETERMINANT)
+      throw std::logic_error(
+          "The calculation of determinant was rejected. The matrix is not "
+          "square");
+    if (type_of_operation == INVERSE_MATRIX)
+      throw std::logic_error(
+          "The matrix inversion was rejected. The matrix is not square");
+    if (type_of_operation == SOLVE)
+      throw std::logic_error(
+          "The solution was rejected. The matrix is not square");
+  }
+  if (rows != other_rows) {
+    if (type_of_operation == SOLVE)
+      throw std::logic_error(
+          "The solution was rejected. Matrices have different sizes");
+  }
+}
+
+/**
+ * @brief Calls body(begin, end) on row ranges that cover all rows
+ * @details Large matrices are split between the threads of S21ThreadPool
+ */
+void S21Matrix::ForEachRow(const std::function<void(int, int)> &body) const {
+  ForEachRowRange(rows_, cols_, body);
+}
+
+/**
+ * @brief Overwrites the elements through body(begin, end), which writes the
+ * rows of one range
+ * @details The non-template part of Assign(). It lives in the library, so
+ * the instrumentation of expressions does not depend on whether the code
+ * that includes the header defines S21_INSTRUMENTATION.
+ */
+void S21Matrix::AssignRows(const std::function<void(int, int)> &body) {
+  InvalidateFingerprint();
+  S21_INSTRUMENT(INSTRUMENT_EXPRESSION, 0, 8.0 * rows_ * cols_);
+  ForEachRow(body);
+}
+
+/**
+ * @brief Calls body(begin, end) on row ranges that cover [0, rows) of a
+ * rows x cols block, split between threads like the rows of a matrix
+ */
+void S21Matrix::ForEachRow(int rows, int cols,
+                           const std::function<void(int, int)> &body) {
+  ForEachRowRange(rows, cols, body);
+}
+
+/**
+ * @brief Exchanges the contents of two matrices
+ * @param other - the matrix to exchange with
+ */
+void S21Matrix::Swap(S21Matrix &other) noexcept {
+  std::swap(rows_, other.rows_);
+  std::swap(cols_, other.cols_);
+  std::swap(stride_, other.stride_);
+  std::swap(capacity_, other.capacity_);
+  std::swap(resource_, other.resource_);
+  std::swap(matrix_, other.matrix_);
+  std::uint64_t fingerprint = fingerprint_.load(std::memory_order_relaxed);
+  fingerprint_.store(other.fingerprint_.load(std::memory_order_relaxed),
+                     std::memory_order_relaxed);
+  other.fingerprint_.store(fingerprint, std::memory_order_relaxed);
+}
+
+/**
+ * @brief Moves the elements into a new block of row_capacity rows of
+ * 'stride' elements
+ * @details The elements past the current rows and columns are zero
+ */
+void S21Matrix::Reallocate(int row_capacity, int stride) {
+  double *elements = NewArrayOfElements(row_capacity, stride);
+  for (int i = 0; i < rows_; ++i) {
+    std::memcpy(elements + static_cast<std::ptrdiff_t>(i) * stride, Row(i),
+                cols_ * sizeof(double));
+  }
+  DeleteArrayOfElements();
+  stride_ = stride;
+  capacity_ = static_cast<std::size_t>(row_capacity) * stride;
+  matrix_ = elements;
+}
+
+/**
+ * @brief Packs the rows together, so that stride_ == cols_
+ * @details Every row moves towards the start of the block, so the rows are
+ * moved in order and the block stays the same
+ */
+void S21Matrix::Compact() {
+  if (stride_ == cols_) return;
+  for (int i = 1; i < rows_; ++i) {
+    std::memmove(matrix_ + static_cast<std::ptrdiff_t>(i) * cols_, Row(i),
+                 cols_ * sizeof(double));
+  }
+  stride_ = cols_;
+}
+
+/**
+ * @brief Matrix of algebraic complements of a singular matrix
+ * @details The adjugate of a matrix of rank n - 2 or lower is zero, of
+ * rank n - 1 it is c * v * u^T, where A * v = 0 and u^T * A = 0. The rank
+ * and both null vectors come from an elimination with complete pivoting,
+ * which reveals the rank unlike the row pivoting of S21LuDecomposition, and
+ * c from one complement taken as the determinant of its minor. All of it
+ * costs O(n^3). A 1 x 1 matrix has the complement 1.
+ */
+S21Matrix S21Matrix::CalcComplementsOfSingular() const {
+  int n = rows_;
+  S21Matrix result(n, n, resource_);
+  if (n == 1) {
+    result(0, 0) = 1.0;
+    return result;
+  }
+  S21Matrix lu(*this, resource_);
+  std::vector<int> row_of(n), col_of(n);  // Original rows and columns
+  double tolerance = 0.0;
+  for (int i = 0; i < n; ++i) {
+    row_of[i] = col_of[i] = i;
+    for (int j = 0; j < n; ++j) {
+      tolerance = std::max(tolerance, fabs(lu.Row(i)[j]));
+    }
+  }
+  tolerance *= n * DBL_EPSILON;
+
+  /* The matrix is singular, so at most n - 1 pivots are taken */
+  for (int k = 0; k < n - 1; ++k) {
+    int pivot_row = k, pivot_col = k;
+    for (int i = k; i < n; ++i) {
+      for (int j = k; j < n; ++j) {
+        if (fabs(lu.Row(i)[j]) > fabs(lu.Row(pivot_row)[pivot_col])) {
+          pivot_row = i;
+          pivot_col = j;
+        }
+      }
+    }
+    if (fabs(lu.Row(pivot_row)[pivot_col]) <= tolerance) return result;
+    std::swap_ranges(lu.Row(k), lu.Row(k) + n, lu.Row(pivot_row));
+    std::swap(row_of[k], row_of[pivot_row]);
+    for (int i = 0; i < n; ++i) std::swap(lu.Row(i)[k], lu.Row(i)[pivot_col]);
+    std::swap(col_of[k], col_of[pivot_col]);
+    const double *lu_k = lu.Row(k);
+    for (int i = k + 1; i < n; ++i) {
+      double *lu_i = lu.Row(i);
+      double l_ik = lu_i[k] /= lu_k[k];
+      for (int j = k + 1; j < n; ++j) lu_i[j] -= l_ik * lu_k[j];
+    }
+  }
+
+  /* U * z = 0 with z[n - 1] = 1, and L^T * w = e[n - 1] */
+  std::vector<double> z(n), w(n), v(n), u(n);
+  z[n - 1] = w[n - 1] = 1.0;
+  for (int k = n - 2; k >= 0; --k) {
+    double z_k = -lu.Row(k)[n - 1];
+    double w_k = 0.0;
+    for (int j = k + 1; j < n - 1; ++j) z_k -= lu.Row(k)[j] * z[j];
+    for (int i = k + 1; i < n; ++i) w_k -= lu.Row(i)[k] * w[i];
+    z[k] = z_k / lu.Row(k)[k];
+    w[k] = w_k;
+  }
+  for (int k = 0; k < n; ++k) {
+    v[col_of[k]] = z[k];
+    u[row_of[k]] = w[k];
+  }
+
+  int i = 0, j = 0;
+  for (int k = 1; k < n; ++k) {
+    if (fabs(v[k]) > fabs(v[i])) i = k;
+    if (fabs(u[k]) > fabs(u[j])) j = k;
+  }
+  S21Matrix minor(n - 1, n - 1, resource_);
+  for (int r = 0, minor_r = 0; r < n; ++r) {
+    if (r == j) continue;
+    for (int c = 0, minor_c = 0; c < n; ++c) {
+      if (c != i) minor.Row(minor_r)[minor_c++] = Row(r)[c];
+    }
+    ++minor_r;
+  }
+  double sign = (i + j) % 2 ? -1.0 : 1.0;
+  double scale =
+      sign * S21LuDecomposition(minor).Determinant() / (v[i] * u[j]);
+  for (int r = 0; r < n; ++r) {
+    for (int c = 0; c < n; ++c) result.Row(r)[c] = scale * u[r] * v[c];
+  }
+  return result;
+}
+
+/**
+ * @brief In-place transpose of a square matrix, block pair by block pair
+ * @details Block rows run on S21ThreadPool, the pairs of different block
+ * rows never overlap
+ */
+void S21Matrix::TransposeSquareInPlace() {
+  int blocks = (rows_ + kTransposeBlock - 1) / kTransposeBlock;
+  auto body = [this, blocks](long begin, long end) {
+    alignas(kAlignment) double buffer[kTransposeBlock * kTransposeBlock];
+    for (int bi = static_cast<int>(begin); bi < end; ++bi) {
+      int ib = bi * kTransposeBlock;
+      int i_count = std::min(kTransposeBlock, rows_ - ib);
+      for (int bj = bi; bj < blocks; ++bj) {
+        int jb = bj * kTransposeBlock;
+        int j_count = std::min(kTransposeBlock, cols_ - jb);
+        // buffer = transposed (ib, jb), then (ib, jb) = transposed (jb, ib)
+        S21Simd::Transpose(Row(ib) + jb, stride_, buffer, i_count, i_count,
+                           j_count);
+        if (bi != bj) {
+          S21Simd::Transpose(Row(jb) + ib, stride_, Row(ib) + jb, stride_,
+                             j_count, i_count);
+        }
+        for (int j = 0; j < j_count; ++j) {
+          std::memcpy(Row(jb + j) + ib, buffer + j * i_count,
+                      i_count * sizeof(double));
+        }
+      }
+    }
+  };
+  if (static_cast<long>(rows_) * cols_ < kParallelElements) {
+    body(0, blocks);
+  } else {
+    S21ThreadPool::Instance().ParallelFor(blocks, 1, body);
+  }
+}
+
+/**
+ * @brief In-place transpose of a rectangular matrix by cycle following
+ * @details The element with flat index k = i * cols + j moves to
+ * j * rows + i. Every cycle of this permutation is walked once, carrying
+ * one element, and a bit per element remembers the visited positions.
+ * Rows with spare columns after them are packed together first.
+ */
+void S21Matrix::TransposeByCycles() {
+  Compact();
+  std::size_t count = static_cast<std::size_t>(rows_) * cols_;
+  std::vector<bool> moved(count);
+  for (std::size_t start = 1; start + 1 < count; ++start) {
+    if (moved[start]) continue;
+    double value = matrix_[start];
+    std::size_t k = start;
+    do {
+      k = (k % cols_) * rows_ + k / cols_;
+      std::swap(value, matrix_[k]);
+      moved[k] = true;
+    } while (k != start);
+  }
+  std::swap(rows_, cols_);
+  stride_ = cols_;
 }
 
 /* Additional methods -----------------------------------------------------*/
@@ -374,10 +1193,11 @@ void S21Matrix::CheckSizesFor(int type_of_operation,
  * @brief Fills the matrix with numbers in order from 1 to rows * cols)
  */
 void S21Matrix::FillByOrder() {
+  InvalidateFingerprint();
   double k = 0.0;
   for (int i = 0; i < rows_; ++i) {
     for (int j = 0; j < cols_; ++j) {
-      matrix_[i][j] = ++k;
+      Row(i)[j] = ++k;
     }
   }
 }
@@ -386,10 +1206,11 @@ void S21Matrix::FillByOrder() {
  * @brief Fills the matrix with even numbers (2.0, 4.0, 6.0...)
  */
 void S21Matrix::FillByEven() {
+  InvalidateFingerprint();
   double k = 0.0;
   for (int i = 0; i < rows_; ++i) {
     for (int j = 0; j < cols_; ++j) {
-      matrix_[i][j] = ++k * 2.0;
+      Row(i)[j] = ++k * 2.0;
     }
   }
 }
@@ -398,9 +1219,10 @@ void S21Matrix::FillByEven() {
  * @brief Fills the matrix with numbers by 1
  */
 void S21Matrix::FillWithOne() {
+  InvalidateFingerprint();
   for (int i = 0; i < rows_; ++i) {
     for (int j = 0; j < cols_; ++j) {
-      matrix_[i][j] = 1.0;
+      Row(i)[j] = 1.0;
     }
   }
 }
@@ -409,23 +1231,22 @@ void S21Matrix::FillWithOne() {
  * @brief Fills the matrix with numbers by 0
  */
 void S21Matrix::FillWithZero() {
+  InvalidateFingerprint();
   for (int i = 0; i < rows_; ++i) {
     for (int j = 0; j < cols_; ++j) {
-      matrix_[i][j] = 0.0;
+      Row(i)[j] = 0.0;
     }
   }
 }
 
 /**
  * @brief Print matrix
+ * @details Rows of tab separated elements, formatted by S21MatrixText and
+ * written to std::cout in large blocks
  */
 void S21Matrix::Print() {
-  for (int i = 0; i < rows_; ++i) {
-    for (int j = 0; j < cols_; ++j) {
-      std::cout << matrix_[i][j] << '\t';
-    }
-    std::cout << std::endl;
-  }
+  S21MatrixText::Write(*this, std::cout, '\t');
+  std::cout.flush();
 }
 
 /*
@@ -22,8 +22,19 @@
 
 #include <math.h>
 
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
 #include <cstring>
+#include <functional>
 #include <iostream>
+#include <memory_resource>
+#include <new>
+#include <string>
+#include <utility>
+
+#include "s21_instrumentation.h"
+#include "s21_strassen.h"
 
 #define EPS 1e-07
 
@@ -35,65 +46,162 @@ enum types_of_operation {
   SUM = 1,
   SUB = 2,
   MUL_MATRIX = 3,
+  CALC_COMPLEMENTS = 4,
+  DETERMINANT = 5,
+  INVERSE_MATRIX = 6,
+  ASSIGNMENT = 7,
+  APPEND_ROW = 8,
+  SOLVE = 9,
   NUMBER_OF_OPERATIONS  // To get amount of elements of enum
 };
 
+class S21Vector;
+
+/**
+ * @brief Base of all matrix expressions (S21Matrix itself included)
+ * @details Expressions are evaluated lazily: every node provides GetRows(),
+ * GetCols() and GetVal(row, col), and the whole tree is computed in one pass
+ * when it is assigned to a S21Matrix. Nodes keep references to the matrices
+ * they were built from, so an expression must not outlive its operands.
+ */
+template <typename E>
+class S21MatrixExpr {
+ public:
+  const E& Self() const { return static_cast<const E&>(*this); }
+};
+
 /**
  * @brief Implementation of the matrix
  */
-class S21Matrix {
+class S21Matrix : public S21MatrixExpr<S21Matrix> {
+ public:
+  /* Alignment of the elements buffer in bytes (one cache line) */
+  static constexpr std::size_t kAlignment = 64;
+
  private:
   int rows_, cols_;
-  double** matrix_;
+  int stride_;  // Distance in elements between the starts of adjacent rows
+  std::size_t capacity_;  // Elements in the block, at least rows_ * stride_
+  std::pmr::memory_resource* resource_;  // Source of the elements buffer
+  double* matrix_;  // Single row-major block of capacity_ elements
+  mutable std::atomic<std::uint64_t> fingerprint_{0};  // 0 until computed
 
  private:
   /* Memory management functions -----------------------------------------*/
-  double** NewArrayOfElements(int rows, int cols) const;
+  double* NewArrayOfElements(int rows, int cols) const;
   void DeleteArrayOfElements();
   void CopyArrayOfElements(const S21Matrix& other);
+  double* Row(int row) const {
+    return matrix_ + static_cast<std::ptrdiff_t>(row) * stride_;
+  }
+  void InvalidateFingerprint() {
+    fingerprint_.store(0, std::memory_order_relaxed);
+  }
 
   /* Help methods --------------------------------------------------------*/
   void CheckSizesFor(int type_of_operation, const S21Matrix& other) const;
-  //  ...method for resize matrix...
+  static void CheckSizesFor(int type_of_operation, int rows, int cols,
+                            int other_rows, int other_cols);
+  void ForEachRow(const std::function<void(int, int)>& body) const;
+  static void ForEachRow(int rows, int cols,
+                         const std::function<void(int, int)>& body);
+  template <typename E>
+  void Assign(const E& expr);
+  void AssignRows(const std::function<void(int, int)>& body);
+  void Swap(S21Matrix& other) noexcept;
+  S21Matrix CalcComplementsOfSingular() const;
+  void TransposeSquareInPlace();
+  void TransposeByCycles();
+  void Reallocate(int row_capacity, int stride);
+  void Compact();
+
+  template <typename L, typename R, typename Op>
+  friend class S21MatrixBinaryExpr;
+  friend class S21MatrixView;
+  friend class S21MatrixFile;
+  friend class S21MatrixBatch;
+  friend class S21SparseMatrix;
+  template <typename T>
+  friend class S21BasicMatrix;
+
+  S21Matrix(int rows, int cols, double* elements,
+            std::pmr::memory_resource* resource) noexcept;
 
  public:
   /* Constructors and destructors ----------------------------------------*/
   S21Matrix();
-  S21Matrix(int rows, int cols);
+  S21Matrix(int rows, int cols,
+            std::pmr::memory_resource* resource =
+                std::pmr::get_default_resource());
   S21Matrix(const S21Matrix& other);
+  S21Matrix(const S21Matrix& other, std::pmr::memory_resource* resource);
   S21Matrix(S21Matrix&& other) noexcept;
+  explicit S21Matrix(const std::string& path);
+  template <typename E>
+  S21Matrix(const S21MatrixExpr<E>& expr);  // NOLINT(runtime/explicit)
   ~S21Matrix();
 
   /* Overloads -----------------------------------------------------------*/
   S21Matrix& operator=(const S21Matrix& other);
-  S21Matrix operator+(const S21Matrix& other) const;
-  S21Matrix operator-(const S21Matrix& other) const;
-  S21Matrix operator*(const double num) const;
+  S21Matrix& operator=(S21Matrix&& other) noexcept;
+  template <typename E>
+  S21Matrix& operator=(const S21MatrixExpr<E>& expr);
   S21Matrix operator*(const S21Matrix& other) const;
   double& operator()(int row, int col);
-  bool operator==(const S21Matrix& other);
+  bool operator==(const S21Matrix& other) const;
   S21Matrix& operator+=(const S21Matrix& other);
+  template <typename E>
+  S21Matrix& operator+=(const S21MatrixExpr<E>& expr);
   S21Matrix& operator-=(const S21Matrix& other);
+  template <typename E>
+  S21Matrix& operator-=(const S21MatrixExpr<E>& expr);
   S21Matrix& operator*=(const double num);
   S21Matrix& operator*=(const S21Matrix& other);
 
   /* Core methods --------------------------------------------------------*/
-  bool EqMatrix(const S21Matrix& other);
+  bool EqMatrix(const S21Matrix& other) const;
   void SumMatrix(const S21Matrix& other);
   void SubMatrix(const S21Matrix& other);
   void MulNumber(const double num);
   void MulMatrix(const S21Matrix& other);
-  S21Matrix Transpose();
-  //  S21Matrix CalcComplements();
-  //  double Determinant();
-  //  S21Matrix InverseMatrix();
+  void MulMatrixStrassen(const S21Matrix& other,
+                         int crossover = kStrassenCrossover);
+  void Gemm(double alpha, const S21Matrix& a, bool transpose_a,
+            const S21Matrix& b, bool transpose_b, double beta);
+  void Ger(double alpha, const S21Vector& x, const S21Vector& y);
+  S21Matrix Transpose() const;
+  void TransposeInPlace();
+  S21Matrix CalcComplements() const;
+  double Determinant() const;
+  S21Matrix InverseMatrix() const;
+  S21Matrix Solve(const S21Matrix& other) const;
+  static S21Matrix Load(const std::string& path,
+                        std::pmr::memory_resource* resource =
+                            std::pmr::get_default_resource());
+  void Save(const std::string& path) const;
 
   /* Accessors and mutators ---------------------------------------------*/
   int GetRows() const { return rows_; }
   int GetCols() const { return cols_; }
-  double GetVal(int row, int col) const { return matrix_[row][col]; }
-  //  void SetRows(int new_rows);
-  //  void SetCols(int new_cols);
+  double GetVal(int row, int col) const { return Row(row)[col]; }
+  double* data() {
+    InvalidateFingerprint();
+    return matrix_;
+  }
+  const double* data() const { return matrix_; }
+  int stride() const { return stride_; }
+  std::pmr::memory_resource* GetResource() const { return resource_; }
+  std::uint64_t Fingerprint() const;
+  static void SetNumThreads(int num_threads);
+  static int GetNumThreads();
+  void SetRows(int new_rows);
+  void SetCols(int new_cols);
+  int GetRowCapacity() const {
+    return stride_ ? static_cast<int>(capacity_ / stride_) : 0;
+  }
+  void ReserveRows(int row_capacity);
+  void AppendRow();
+  void AppendRow(const S21Matrix& row);
 
   /* Additional methods for testing -------------------------------------*/
   void FillByOrder();
@@ -103,4 +211,232 @@ class S21Matrix {
   void Print();
 };
 
+/* Expression templates ---------------------------------------------------*/
+
+/**
+ * @brief How an expression node stores its operand
+ * @details Matrices are kept by reference, nested nodes by value
+ */
+template <typename E>
+struct S21ExprOperand {
+  using type = const E;
+};
+
+template <>
+struct S21ExprOperand<S21Matrix> {
+  using type = const S21Matrix&;
+};
+
+/**
+ * @brief Element-wise operations of the expression nodes
+ */
+struct S21SumOp {
+  static constexpr int kOperation = SUM;
+  static double Apply(double lhs, double rhs) { return lhs + rhs; }
+};
+
+struct S21SubOp {
+  static constexpr int kOperation = SUB;
+  static double Apply(double lhs, double rhs) { return lhs - rhs; }
+};
+
+/**
+ * @brief Lazy element-wise combination of two expressions of the same size
+ * @details The sizes are checked when the node is built, so a mismatch
+ * throws the same std::logic_error as SumMatrix() and SubMatrix()
+ */
+template <typename L, typename R, typename Op>
+class S21MatrixBinaryExpr
+    : public S21MatrixExpr<S21MatrixBinaryExpr<L, R, Op>> {
+ public:
+  S21MatrixBinaryExpr(const L& lhs, const R& rhs) : lhs_(lhs), rhs_(rhs) {
+    S21Matrix::CheckSizesFor(Op::kOperation, lhs.GetRows(), lhs.GetCols(),
+                             rhs.GetRows(), rhs.GetCols());
+  }
+
+  int GetRows() const { return lhs_.GetRows(); }
+  int GetCols() const { return lhs_.GetCols(); }
+  double GetVal(int row, int col) const {
+    return Op::Apply(lhs_.GetVal(row, col), rhs_.GetVal(row, col));
+  }
+
+ private:
+  typename S21ExprOperand<L>::type lhs_;
+  typename S21ExprOperand<R>::type rhs_;
+};
+
+/**
+ * @brief Lazy multiplication of an expression by a number
+ */
+template <typename E>
+class S21MatrixScaleExpr : public S21MatrixExpr<S21MatrixScaleExpr<E>> {
+ public:
+  S21MatrixScaleExpr(const E& expr, double num) : expr_(expr), num_(num) {}
+
+  int GetRows() const { return expr_.GetRows(); }
+  int GetCols() const { return expr_.GetCols(); }
+  double GetVal(int row, int col) const {
+    return expr_.GetVal(row, col) * num_;
+  }
+
+ private:
+  typename S21ExprOperand<E>::type expr_;
+  double num_;
+};
+
+/* Overloads for temporary matrices, computed in the storage of an operand */
+S21Matrix operator+(S21Matrix&& lhs, S21Matrix&& rhs);
+S21Matrix operator-(S21Matrix&& lhs, S21Matrix&& rhs);
+S21Matrix operator*(S21Matrix&& matrix, const double num);
+
+/**
+ * @brief Overload of '+' that reuses the storage of a temporary matrix
+ * @param lhs - the temporary matrix, receives the result
+ * @param rhs - the matrix (or expression) that will be added
+ * @return Matrix with result of addition
+ */
+template <typename R>
+S21Matrix operator+(S21Matrix&& lhs, const S21MatrixExpr<R>& rhs) {
+  lhs += rhs;
+  return std::move(lhs);
+}
+
+/**
+ * @brief Overload of '+' that reuses the storage of a temporary matrix
+ * @param lhs - the matrix (or expression) that will be added
+ * @param rhs - the temporary matrix, receives the result
+ * @return Matrix with result of addition
+ */
+template <typename L>
+S21Matrix operator+(const S21MatrixExpr<L>& lhs, S21Matrix&& rhs) {
+  rhs = lhs + static_cast<const S21Matrix&>(rhs);
+  return std::move(rhs);
+}
+
+/**
+ * @brief Overload of '-' that reuses the storage of a temporary matrix
+ * @param lhs - the temporary matrix, receives the result
+ * @param rhs - the matrix (or expression) that will be subtract
+ * @return Matrix with result of subtraction
+ */
+template <typename R>
+S21Matrix operator-(S21Matrix&& lhs, const S21MatrixExpr<R>& rhs) {
+  lhs -= rhs;
+  return std::move(lhs);
+}
+
+/**
+ * @brief Overload of '-' that reuses the storage of a temporary matrix
+ * @param lhs - the matrix (or expression) from which 'rhs' is subtracted
+ * @param rhs - the temporary matrix, receives the result
+ * @return Matrix with result of subtraction
+ */
+template <typename L>
+S21Matrix operator-(const S21MatrixExpr<L>& lhs, S21Matrix&& rhs) {
+  rhs = lhs - static_cast<const S21Matrix&>(rhs);
+  return std::move(rhs);
+}
+
+/**
+ * @brief Overload of '+' for matrices
+ * @param lhs, rhs - the matrices (or expressions) that will be added
+ * @return Lazy expression of the addition
+ */
+template <typename L, typename R>
+S21MatrixBinaryExpr<L, R, S21SumOp> operator+(const S21MatrixExpr<L>& lhs,
+                                              const S21MatrixExpr<R>& rhs) {
+  return S21MatrixBinaryExpr<L, R, S21SumOp>(lhs.Self(), rhs.Self());
+}
+
+/**
+ * @brief Overload of '-' for matrices
+ * @param lhs, rhs - the matrices (or expressions) that will be subtracted
+ * @return Lazy expression of the subtraction
+ */
+template <typename L, typename R>
+S21MatrixBinaryExpr<L, R, S21SubOp> operator-(const S21MatrixExpr<L>& lhs,
+                                              const S21MatrixExpr<R>& rhs) {
+  return S21MatrixBinaryExpr<L, R, S21SubOp>(lhs.Self(), rhs.Self());
+}
+
+/**
+ * @brief Overload of '*' for matrices that will be multiply by a number 'num'
+ * @param expr - the matrix (or expression) that will be multiplied
+ * @param num - the number by which the matrix will be multiplied
+ * @return Lazy expression of the multiplication
+ */
+template <typename E>
+S21MatrixScaleExpr<E> operator*(const S21MatrixExpr<E>& expr,
+                                 const double num) {
+  return S21MatrixScaleExpr<E>(expr.Self(), num);
+}
+
+/**
+ * @brief Evaluates an expression into a new matrix
+ * @param expr - the expression that will be computed
+ */
+template <typename E>
+S21Matrix::S21Matrix(const S21MatrixExpr<E>& expr)
+    : S21Matrix(expr.Self().GetRows(), expr.Self().GetCols()) {
+  Assign(expr.Self());
+}
+
+/**
+ * @brief Evaluates an expression into the current matrix
+ * @details The elements are computed in one fused pass straight into the
+ * existing storage when the sizes match, so 'c = a + b - c * 2.0' neither
+ * allocates nor creates temporary matrices
+ * @param expr - the expression that will be assigned
+ * @return reference to the current matrix
+ */
+template <typename E>
+S21Matrix& S21Matrix::operator=(const S21MatrixExpr<E>& expr) {
+  const E& self = expr.Self();
+  if (self.GetRows() == rows_ && self.GetCols() == cols_) {
+    Assign(self);
+  } else {
+    S21Matrix result(self.GetRows(), self.GetCols(), resource_);
+    result.Assign(self);
+    Swap(result);
+  }
+  return *this;
+}
+
+/**
+ * Addition assignment of an expression, fused into one pass
+ * @param expr - the expression that will be added
+ * @return reference to the added matrix
+ */
+template <typename E>
+S21Matrix& S21Matrix::operator+=(const S21MatrixExpr<E>& expr) {
+  return *this = *this + expr;
+}
+
+/**
+ * Difference assignment of an expression, fused into one pass
+ * @param expr - the expression that will be subtract
+ * @return reference to the subtracted matrix
+ */
+template <typename E>
+S21Matrix& S21Matrix::operator-=(const S21MatrixExpr<E>& expr) {
+  return *this = *this - expr;
+}
+
+/**
+ * @brief Writes every element of an expression of the same size
+ * @details Element (i, j) of the expression only reads elements (i, j) of
+ * its operands, so the current matrix may appear in the expression
+ */
+template <typename E>
+void S21Matrix::Assign(const E& expr) {
+  AssignRows([this, &expr](int begin, int end) {
+    for (int i = begin; i < end; ++i) {
+      double* row = Row(i);
+      for (int j = 0; j < cols_; ++j) {
+        row[j] = expr.GetVal(i, j);
+      }
+    }
+  });
+}
+
 #endif  // SRC_S21_MATRIX_OOP_H_
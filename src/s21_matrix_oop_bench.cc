@@ -0,0 +1,614 @@
+/*
+ * Copyright 2023 Gleb Tolstenev
+ * yonnarge@student.21-school.ru
+ *
+ * s21_matrix_oop_bench.cc contains the performance benchmarks of
+ * s21_matrix_oop library
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <memory_resource>
+#include <thread>
+#include <utility>
+
+#include "s21_basic_matrix.h"
+#include "s21_matrix_oop.h"
+#include "s21_pool_resource.h"
+#include "s21_vector.h"
+
+namespace {
+
+constexpr int kMinSize = 2;
+constexpr int kMaxSize = 4096;
+constexpr int kMaxLuSize = 1024;
+
+/**
+ * @brief Square sizes from kMinSize to 'max_size', doubling every step
+ */
+void Sizes(benchmark::internal::Benchmark* bench, int max_size) {
+  for (int size = kMinSize; size <= max_size; size *= 2) {
+    bench->Arg(size);
+  }
+}
+
+void AllSizes(benchmark::internal::Benchmark* bench) { Sizes(bench, kMaxSize); }
+
+void LuSizes(benchmark::internal::Benchmark* bench) {
+  Sizes(bench, kMaxLuSize);
+}
+
+/**
+ * @brief Matrix of the given size with small, non-repeating elements
+ */
+S21Matrix MakeMatrix(int size) {
+  S21Matrix matrix(size, size);
+  matrix.FillByOrder();
+  matrix *= 1.0 / (static_cast<double>(size) * size);
+  for (int i = 0; i < size; ++i) {
+    matrix(i, i) += 1.0;
+  }
+  return matrix;
+}
+
+S21Matrix MakeIdentity(int size) {
+  S21Matrix matrix(size, size);
+  for (int i = 0; i < size; ++i) {
+    matrix(i, i) = 1.0;
+  }
+  return matrix;
+}
+
+/**
+ * @brief Reports bytes moved by an element-wise operation over 'operands'
+ * matrices of the benchmark size
+ */
+void SetElementwiseBytes(benchmark::State& state, int operands,
+                         std::size_t element_bytes = sizeof(double)) {
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) *
+                          state.range(0) * state.range(0) * operands *
+                          static_cast<int64_t>(element_bytes));
+}
+
+/**
+ * @brief Reports the floating point rate of a size x size product
+ */
+void SetGemmFlops(benchmark::State& state) {
+  double size = static_cast<double>(state.range(0));
+  state.counters["FLOPS"] = benchmark::Counter(
+      2.0 * size * size * size, benchmark::Counter::kIsIterationInvariantRate);
+}
+
+/* Constructors -----------------------------------------------------------*/
+
+void BM_DefaultConstructor(benchmark::State& state) {
+  for (auto _ : state) {
+    S21Matrix matrix;
+    benchmark::DoNotOptimize(matrix.data());
+  }
+}
+BENCHMARK(BM_DefaultConstructor);
+
+void BM_ParameterizedConstructor(benchmark::State& state) {
+  int size = static_cast<int>(state.range(0));
+  for (auto _ : state) {
+    S21Matrix matrix(size, size);
+    benchmark::DoNotOptimize(matrix.data());
+  }
+  SetElementwiseBytes(state, 1);
+}
+BENCHMARK(BM_ParameterizedConstructor)->Apply(AllSizes);
+
+void BM_CopyConstructor(benchmark::State& state) {
+  S21Matrix matrix = MakeMatrix(static_cast<int>(state.range(0)));
+  for (auto _ : state) {
+    S21Matrix copy(matrix);
+    benchmark::DoNotOptimize(copy.data());
+  }
+  SetElementwiseBytes(state, 2);
+}
+BENCHMARK(BM_CopyConstructor)->Apply(AllSizes);
+
+void BM_MoveConstructor(benchmark::State& state) {
+  S21Matrix matrix = MakeMatrix(static_cast<int>(state.range(0)));
+  for (auto _ : state) {
+    S21Matrix moved(std::move(matrix));
+    benchmark::DoNotOptimize(moved.data());
+    matrix = std::move(moved);
+  }
+}
+BENCHMARK(BM_MoveConstructor)->Apply(AllSizes);
+
+/* Assignments ------------------------------------------------------------*/
+
+void BM_CopyAssignment(benchmark::State& state) {
+  int size = static_cast<int>(state.range(0));
+  S21Matrix matrix = MakeMatrix(size);
+  S21Matrix copy(size, size);
+  for (auto _ : state) {
+    copy = matrix;
+    benchmark::DoNotOptimize(copy.data());
+  }
+  SetElementwiseBytes(state, 2);
+}
+BENCHMARK(BM_CopyAssignment)->Apply(AllSizes);
+
+void BM_MoveAssignment(benchmark::State& state) {
+  S21Matrix matrix = MakeMatrix(static_cast<int>(state.range(0)));
+  S21Matrix moved;
+  for (auto _ : state) {
+    moved = std::move(matrix);
+    matrix = std::move(moved);
+    benchmark::DoNotOptimize(matrix.data());
+  }
+}
+BENCHMARK(BM_MoveAssignment)->Apply(AllSizes);
+
+/* Arithmetic operators ---------------------------------------------------*/
+
+void BM_Sum(benchmark::State& state) {
+  int size = static_cast<int>(state.range(0));
+  S21Matrix matrix_1 = MakeMatrix(size);
+  S21Matrix matrix_2 = MakeMatrix(size);
+  S21Matrix result(size, size);
+  for (auto _ : state) {
+    result = matrix_1 + matrix_2;
+    benchmark::DoNotOptimize(result.data());
+  }
+  SetElementwiseBytes(state, 3);
+}
+BENCHMARK(BM_Sum)->Apply(AllSizes);
+
+void BM_Sub(benchmark::State& state) {
+  int size = static_cast<int>(state.range(0));
+  S21Matrix matrix_1 = MakeMatrix(size);
+  S21Matrix matrix_2 = MakeMatrix(size);
+  S21Matrix result(size, size);
+  for (auto _ : state) {
+    result = matrix_1 - matrix_2;
+    benchmark::DoNotOptimize(result.data());
+  }
+  SetElementwiseBytes(state, 3);
+}
+BENCHMARK(BM_Sub)->Apply(AllSizes);
+
+void BM_MulNumber(benchmark::State& state) {
+  int size = static_cast<int>(state.range(0));
+  S21Matrix matrix = MakeMatrix(size);
+  S21Matrix result(size, size);
+  for (auto _ : state) {
+    result = matrix * 0.5;
+    benchmark::DoNotOptimize(result.data());
+  }
+  SetElementwiseBytes(state, 2);
+}
+BENCHMARK(BM_MulNumber)->Apply(AllSizes);
+
+void BM_MulMatrix(benchmark::State& state) {
+  int size = static_cast<int>(state.range(0));
+  S21Matrix matrix_1 = MakeMatrix(size);
+  S21Matrix matrix_2 = MakeMatrix(size);
+  for (auto _ : state) {
+    S21Matrix result = matrix_1 * matrix_2;
+    benchmark::DoNotOptimize(result.data());
+  }
+  SetGemmFlops(state);
+}
+BENCHMARK(BM_MulMatrix)->Apply(AllSizes)->Unit(benchmark::kMicrosecond);
+
+/* Same product as BM_MulMatrix, FLOPS counts the classical operations */
+void BM_MulMatrixStrassen(benchmark::State& state) {
+  int size = static_cast<int>(state.range(0));
+  S21Matrix matrix_1 = MakeMatrix(size);
+  S21Matrix matrix_2 = MakeMatrix(size);
+  for (auto _ : state) {
+    S21Matrix result(matrix_1);
+    result.MulMatrixStrassen(matrix_2);
+    benchmark::DoNotOptimize(result.data());
+  }
+  SetGemmFlops(state);
+}
+BENCHMARK(BM_MulMatrixStrassen)
+    ->Apply(AllSizes)
+    ->Unit(benchmark::kMicrosecond);
+
+/* c += (a * b) * alpha through the operators and through the fused Gemm */
+void BM_MulMatrixAccumulate(benchmark::State& state) {
+  int size = static_cast<int>(state.range(0));
+  S21Matrix matrix_1 = MakeMatrix(size);
+  S21Matrix matrix_2 = MakeMatrix(size);
+  S21Matrix result = MakeMatrix(size);
+  for (auto _ : state) {
+    result += (matrix_1 * matrix_2) * 0.5;
+    benchmark::DoNotOptimize(result.data());
+  }
+  SetGemmFlops(state);
+}
+BENCHMARK(BM_MulMatrixAccumulate)
+    ->Apply(AllSizes)
+    ->Unit(benchmark::kMicrosecond);
+
+void BM_Gemm(benchmark::State& state) {
+  int size = static_cast<int>(state.range(0));
+  S21Matrix matrix_1 = MakeMatrix(size);
+  S21Matrix matrix_2 = MakeMatrix(size);
+  S21Matrix result = MakeMatrix(size);
+  for (auto _ : state) {
+    result.Gemm(0.5, matrix_1, false, matrix_2, false, 1.0);
+    benchmark::DoNotOptimize(result.data());
+  }
+  SetGemmFlops(state);
+}
+BENCHMARK(BM_Gemm)->Apply(AllSizes)->Unit(benchmark::kMicrosecond);
+
+/* B is read through swapped strides instead of being transposed */
+void BM_GemmTransposed(benchmark::State& state) {
+  int size = static_cast<int>(state.range(0));
+  S21Matrix matrix_1 = MakeMatrix(size);
+  S21Matrix matrix_2 = MakeMatrix(size);
+  S21Matrix result = MakeMatrix(size);
+  for (auto _ : state) {
+    result.Gemm(0.5, matrix_1, false, matrix_2, true, 1.0);
+    benchmark::DoNotOptimize(result.data());
+  }
+  SetGemmFlops(state);
+}
+BENCHMARK(BM_GemmTransposed)->Apply(AllSizes)->Unit(benchmark::kMicrosecond);
+
+/* Matrix-vector products and rank-1 updates, bytes count the matrix once */
+
+void BM_GemvColumnMatrix(benchmark::State& state) {
+  int size = static_cast<int>(state.range(0));
+  S21Matrix matrix = MakeMatrix(size);
+  S21Matrix x(size, 1), y(size, 1);
+  x.FillByOrder();
+  for (auto _ : state) {
+    y.Gemm(1.0, matrix, false, x, false, 0.5);
+    benchmark::DoNotOptimize(y.data());
+  }
+  SetElementwiseBytes(state, 1);
+}
+BENCHMARK(BM_GemvColumnMatrix)->Apply(AllSizes);
+
+void BM_Gemv(benchmark::State& state) {
+  int size = static_cast<int>(state.range(0));
+  S21Matrix matrix = MakeMatrix(size);
+  S21Vector x(size), y(size);
+  for (int i = 0; i < size; ++i) x(i) = i;
+  for (auto _ : state) {
+    y.Gemv(1.0, matrix, false, x, 0.5);
+    benchmark::DoNotOptimize(y.data());
+  }
+  SetElementwiseBytes(state, 1);
+}
+BENCHMARK(BM_Gemv)->Apply(AllSizes);
+
+void BM_GemvTransposed(benchmark::State& state) {
+  int size = static_cast<int>(state.range(0));
+  S21Matrix matrix = MakeMatrix(size);
+  S21Vector x(size), y(size);
+  for (int i = 0; i < size; ++i) x(i) = i;
+  for (auto _ : state) {
+    y.Gemv(1.0, matrix, true, x, 0.5);
+    benchmark::DoNotOptimize(y.data());
+  }
+  SetElementwiseBytes(state, 1);
+}
+BENCHMARK(BM_GemvTransposed)->Apply(AllSizes);
+
+void BM_Ger(benchmark::State& state) {
+  int size = static_cast<int>(state.range(0));
+  S21Matrix matrix = MakeMatrix(size);
+  S21Vector x(size), y(size);
+  for (int i = 0; i < size; ++i) x(i) = y(i) = 1.0 / (i + 1.0);
+  for (auto _ : state) {
+    matrix.Ger(1e-9, x, y);
+    benchmark::DoNotOptimize(matrix.data());
+  }
+  SetElementwiseBytes(state, 2);
+}
+BENCHMARK(BM_Ger)->Apply(AllSizes);
+
+void BM_SumAssignment(benchmark::State& state) {
+  int size = static_cast<int>(state.range(0));
+  S21Matrix matrix = MakeMatrix(size);
+  S21Matrix result = MakeMatrix(size);
+  for (auto _ : state) {
+    result += matrix;
+    benchmark::DoNotOptimize(result.data());
+  }
+  SetElementwiseBytes(state, 3);
+}
+BENCHMARK(BM_SumAssignment)->Apply(AllSizes);
+
+void BM_SubAssignment(benchmark::State& state) {
+  int size = static_cast<int>(state.range(0));
+  S21Matrix matrix = MakeMatrix(size);
+  S21Matrix result = MakeMatrix(size);
+  for (auto _ : state) {
+    result -= matrix;
+    benchmark::DoNotOptimize(result.data());
+  }
+  SetElementwiseBytes(state, 3);
+}
+BENCHMARK(BM_SubAssignment)->Apply(AllSizes);
+
+void BM_MulNumberAssignment(benchmark::State& state) {
+  S21Matrix result = MakeMatrix(static_cast<int>(state.range(0)));
+  for (auto _ : state) {
+    result *= 1.0;
+    benchmark::DoNotOptimize(result.data());
+  }
+  SetElementwiseBytes(state, 2);
+}
+BENCHMARK(BM_MulNumberAssignment)->Apply(AllSizes);
+
+void BM_MulMatrixAssignment(benchmark::State& state) {
+  int size = static_cast<int>(state.range(0));
+  S21Matrix identity = MakeIdentity(size);
+  S21Matrix result = MakeMatrix(size);
+  for (auto _ : state) {
+    result *= identity;
+    benchmark::DoNotOptimize(result.data());
+  }
+  SetGemmFlops(state);
+}
+BENCHMARK(BM_MulMatrixAssignment)
+    ->Apply(AllSizes)
+    ->Unit(benchmark::kMicrosecond);
+
+/* Core methods -----------------------------------------------------------*/
+
+void BM_EqMatrix(benchmark::State& state) {
+  int size = static_cast<int>(state.range(0));
+  S21Matrix matrix_1 = MakeMatrix(size);
+  S21Matrix matrix_2 = MakeMatrix(size);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(matrix_1.EqMatrix(matrix_2));
+  }
+  SetElementwiseBytes(state, 2);
+}
+BENCHMARK(BM_EqMatrix)->Apply(AllSizes);
+
+void BM_Transpose(benchmark::State& state) {
+  S21Matrix matrix = MakeMatrix(static_cast<int>(state.range(0)));
+  for (auto _ : state) {
+    S21Matrix result = matrix.Transpose();
+    benchmark::DoNotOptimize(result.data());
+  }
+  SetElementwiseBytes(state, 2);
+}
+BENCHMARK(BM_Transpose)->Apply(AllSizes);
+
+void BM_Determinant(benchmark::State& state) {
+  S21Matrix matrix = MakeMatrix(static_cast<int>(state.range(0)));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(matrix.Determinant());
+  }
+}
+BENCHMARK(BM_Determinant)->Apply(LuSizes)->Unit(benchmark::kMicrosecond);
+
+void BM_InverseMatrix(benchmark::State& state) {
+  S21Matrix matrix = MakeMatrix(static_cast<int>(state.range(0)));
+  for (auto _ : state) {
+    S21Matrix result = matrix.InverseMatrix();
+    benchmark::DoNotOptimize(result.data());
+  }
+}
+BENCHMARK(BM_InverseMatrix)->Apply(LuSizes)->Unit(benchmark::kMicrosecond);
+
+/* A * X = B with kSolveColumns right-hand sides, by LU for the general
+ * matrix and by Cholesky for the symmetric one */
+
+constexpr int kSolveColumns = 16;
+
+void BM_Solve(benchmark::State& state) {
+  int size = static_cast<int>(state.range(0));
+  S21Matrix matrix = MakeMatrix(size);
+  S21Matrix rhs(size, kSolveColumns);
+  rhs.FillByOrder();
+  for (auto _ : state) {
+    S21Matrix result = matrix.Solve(rhs);
+    benchmark::DoNotOptimize(result.data());
+  }
+}
+BENCHMARK(BM_Solve)->Apply(LuSizes)->Unit(benchmark::kMicrosecond);
+
+void BM_SolveSymmetric(benchmark::State& state) {
+  int size = static_cast<int>(state.range(0));
+  S21Matrix matrix = MakeMatrix(size);
+  matrix += matrix.Transpose();
+  for (int i = 0; i < size; ++i) {
+    matrix(i, i) += 2.0 * size;  // Positive definite by diagonal dominance
+  }
+  S21Matrix rhs(size, kSolveColumns);
+  rhs.FillByOrder();
+  for (auto _ : state) {
+    S21Matrix result = matrix.Solve(rhs);
+    benchmark::DoNotOptimize(result.data());
+  }
+}
+BENCHMARK(BM_SolveSymmetric)->Apply(LuSizes)->Unit(benchmark::kMicrosecond);
+
+/* Thread scaling ---------------------------------------------------------*/
+
+/* The second argument is the thread count given to S21Matrix::SetNumThreads,
+ * from 1 to the number of hardware threads. The times are wall times. */
+
+/**
+ * @brief Sizes 256 and 2048 with 1, 2, 4, ... threads up to the number of
+ * hardware threads, which is always included
+ */
+void ThreadCounts(benchmark::internal::Benchmark* bench) {
+  int max_threads =
+      std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+  bench->ArgNames({"size", "threads"});
+  for (int size : {256, 2048}) {
+    for (int threads = 1; threads < max_threads; threads *= 2) {
+      bench->Args({size, threads});
+    }
+    bench->Args({size, max_threads});
+  }
+}
+
+/**
+ * @brief Sets the thread count of the benchmark for its lifetime
+ */
+class ScopedNumThreads {
+ public:
+  explicit ScopedNumThreads(const benchmark::State& state)
+      : previous_(S21Matrix::GetNumThreads()) {
+    S21Matrix::SetNumThreads(static_cast<int>(state.range(1)));
+  }
+  ScopedNumThreads(const ScopedNumThreads&) = delete;
+  ScopedNumThreads& operator=(const ScopedNumThreads&) = delete;
+  ~ScopedNumThreads() { S21Matrix::SetNumThreads(previous_); }
+
+ private:
+  int previous_;
+};
+
+void BM_MulMatrixThreads(benchmark::State& state) {
+  int size = static_cast<int>(state.range(0));
+  S21Matrix matrix_1 = MakeMatrix(size);
+  S21Matrix matrix_2 = MakeMatrix(size);
+  ScopedNumThreads threads(state);
+  for (auto _ : state) {
+    S21Matrix result = matrix_1 * matrix_2;
+    benchmark::DoNotOptimize(result.data());
+  }
+  SetGemmFlops(state);
+}
+BENCHMARK(BM_MulMatrixThreads)
+    ->Apply(ThreadCounts)
+    ->UseRealTime()
+    ->Unit(benchmark::kMicrosecond);
+
+void BM_SumMatrixThreads(benchmark::State& state) {
+  int size = static_cast<int>(state.range(0));
+  S21Matrix matrix = MakeMatrix(size);
+  S21Matrix result = MakeMatrix(size);
+  ScopedNumThreads threads(state);
+  for (auto _ : state) {
+    result.SumMatrix(matrix);
+    benchmark::DoNotOptimize(result.data());
+  }
+  SetElementwiseBytes(state, 3);
+}
+BENCHMARK(BM_SumMatrixThreads)->Apply(ThreadCounts)->UseRealTime();
+
+void BM_TransposeThreads(benchmark::State& state) {
+  S21Matrix matrix = MakeMatrix(static_cast<int>(state.range(0)));
+  ScopedNumThreads threads(state);
+  for (auto _ : state) {
+    S21Matrix result = matrix.Transpose();
+    benchmark::DoNotOptimize(result.data());
+  }
+  SetElementwiseBytes(state, 2);
+}
+BENCHMARK(BM_TransposeThreads)->Apply(ThreadCounts)->UseRealTime();
+
+/* Memory resources -------------------------------------------------------*/
+
+enum BenchResources { kDefaultResource, kPoolResource, kMonotonicResource };
+
+/**
+ * @brief Sizes 3, 4 and 6, each with the default resource, S21PoolResource
+ * and a monotonic arena
+ */
+void ChurnArgs(benchmark::internal::Benchmark* bench) {
+  bench->ArgNames({"size", "resource"});
+  bench->ArgsProduct(
+      {{3, 4, 6}, {kDefaultResource, kPoolResource, kMonotonicResource}});
+}
+
+/* Every iteration builds and drops the short-lived temporaries of a small
+ * computation, the arena is released once per iteration */
+void BM_SmallMatrixChurn(benchmark::State& state) {
+  int size = static_cast<int>(state.range(0));
+  S21Matrix source = MakeMatrix(size);
+  std::array<std::byte, 4096> buffer;
+  std::pmr::monotonic_buffer_resource arena(buffer.data(), buffer.size());
+  std::pmr::memory_resource* resource = std::pmr::get_default_resource();
+  if (state.range(1) == kPoolResource) {
+    resource = S21PoolResource::Instance();
+    state.SetLabel("pool");
+  } else if (state.range(1) == kMonotonicResource) {
+    resource = &arena;
+    state.SetLabel("monotonic");
+  } else {
+    state.SetLabel("default");
+  }
+  for (auto _ : state) {
+    {
+      S21Matrix matrix(source, resource);
+      S21Matrix sum(size, size, resource);
+      sum.SumMatrix(matrix);
+      matrix.MulMatrix(sum);
+      benchmark::DoNotOptimize(matrix.data());
+    }
+    if (resource == &arena) arena.release();
+  }
+}
+BENCHMARK(BM_SmallMatrixChurn)->Apply(ChurnArgs);
+
+/* Element types ----------------------------------------------------------*/
+
+/* Same operations as BM_SumAssignment and BM_MulMatrix on floats */
+
+void BM_SumAssignmentFloat(benchmark::State& state) {
+  int size = static_cast<int>(state.range(0));
+  S21MatrixF matrix(MakeMatrix(size));
+  S21MatrixF result(MakeMatrix(size));
+  for (auto _ : state) {
+    result += matrix;
+    benchmark::DoNotOptimize(result.data());
+  }
+  SetElementwiseBytes(state, 3, sizeof(float));
+}
+BENCHMARK(BM_SumAssignmentFloat)->Apply(AllSizes);
+
+void BM_MulMatrixFloat(benchmark::State& state) {
+  int size = static_cast<int>(state.range(0));
+  S21MatrixF matrix_1(MakeMatrix(size));
+  S21MatrixF matrix_2(MakeMatrix(size));
+  for (auto _ : state) {
+    S21MatrixF result = matrix_1 * matrix_2;
+    benchmark::DoNotOptimize(result.data());
+  }
+  SetGemmFlops(state);
+}
+BENCHMARK(BM_MulMatrixFloat)->Apply(AllSizes)->Unit(benchmark::kMicrosecond);
+
+void BM_MulMatrixFloatDoubleSums(benchmark::State& state) {
+  int size = static_cast<int>(state.range(0));
+  S21MatrixF matrix_1(MakeMatrix(size));
+  S21MatrixF matrix_2(MakeMatrix(size));
+  for (auto _ : state) {
+    S21MatrixF result = matrix_1.Multiply(matrix_2, GEMM_ACCUMULATE_DOUBLE);
+    benchmark::DoNotOptimize(result.data());
+  }
+  SetGemmFlops(state);
+}
+BENCHMARK(BM_MulMatrixFloatDoubleSums)
+    ->Apply(AllSizes)
+    ->Unit(benchmark::kMicrosecond);
+
+}  // namespace
+
+BENCHMARK_MAIN();
@@ -1,8 +1,74 @@
 #include <gtest/gtest.h>
+#include <unistd.h>
 
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
 #include <iostream>
-
+#include <new>
+#include <sstream>
+
+#include "s21_basic_matrix.h"
+#include "s21_cholesky_decomposition.h"
+#include "s21_fixed_matrix.h"
+#include "s21_gemm.h"
+#include "s21_instrumentation.h"
+#include "s21_lu_decomposition.h"
+#include "s21_matrix_batch.h"
+#include "s21_matrix_file.h"
 #include "s21_matrix_oop.h"
+#include "s21_matrix_text.h"
+#include "s21_matrix_view.h"
+#include "s21_pool_resource.h"
+#include "s21_result_cache.h"
+#include "s21_simd.h"
+#include "s21_sparse_matrix.h"
+#include "s21_strassen.h"
+#include "s21_vector.h"
+
+/* Allocation counting ---------------------------------------------------*/
+
+/* Heap allocations made by the whole test binary */
+static std::atomic<long> allocation_count(0);
+
+static void *CountedAllocate(std::size_t size, std::size_t alignment) {
+  ++allocation_count;
+  if (size == 0) size = 1;
+  void *ptr = nullptr;
+  if (alignment <= alignof(std::max_align_t)) {
+    ptr = std::malloc(size);
+  } else {
+    size = (size + alignment - 1) / alignment * alignment;
+    ptr = std::aligned_alloc(alignment, size);
+  }
+  if (!ptr) throw std::bad_alloc();
+  return ptr;
+}
+
+void *operator new(std::size_t size) { return CountedAllocate(size, 0); }
+void *operator new[](std::size_t size) { return CountedAllocate(size, 0); }
+void *operator new(std::size_t size, std::align_val_t alignment) {
+  return CountedAllocate(size, static_cast<std::size_t>(alignment));
+}
+void *operator new[](std::size_t size, std::align_val_t alignment) {
+  return CountedAllocate(size, static_cast<std::size_t>(alignment));
+}
+void operator delete(void *ptr) noexcept { std::free(ptr); }
+void operator delete[](void *ptr) noexcept { std::free(ptr); }
+void operator delete(void *ptr, std::size_t) noexcept { std::free(ptr); }
+void operator delete[](void *ptr, std::size_t) noexcept { std::free(ptr); }
+void operator delete(void *ptr, std::align_val_t) noexcept { std::free(ptr); }
+void operator delete[](void *ptr, std::align_val_t) noexcept {
+  std::free(ptr);
+}
+void operator delete(void *ptr, std::size_t, std::align_val_t) noexcept {
+  std::free(ptr);
+}
+void operator delete[](void *ptr, std::size_t, std::align_val_t) noexcept {
+  std::free(ptr);
+}
 
 TEST(AccessorMutator, GetRowsColsSuccess) {
   S21Matrix matrix(3, 2);
@@ -49,6 +115,36 @@ TEST(Constructors, MoveSuccess) {
   EXPECT_EQ(matrix_1.GetCols(), 0);
 }
 
+TEST(Constructors, MoveAssignmentSuccess) {
+  S21Matrix matrix_1(2, 3);
+  matrix_1.FillByOrder();
+  const double *storage = matrix_1.data();
+  S21Matrix matrix_2(1, 1);
+
+  matrix_2 = std::move(matrix_1);
+
+  EXPECT_EQ(matrix_2.data(), storage);
+  EXPECT_EQ(matrix_2.GetRows(), 2);
+  EXPECT_EQ(matrix_2.GetCols(), 3);
+  EXPECT_DOUBLE_EQ(matrix_2(1, 2), 6.0);
+  EXPECT_EQ(matrix_1.GetRows(), 0);
+  EXPECT_EQ(matrix_1.GetCols(), 0);
+}
+
+TEST(Constructors, CopyAssignmentReusesStorageSuccess) {
+  S21Matrix matrix_1(3, 3);
+  matrix_1.FillByOrder();
+  S21Matrix matrix_2(3, 3);
+  const double *storage = matrix_2.data();
+
+  matrix_2 = matrix_1;
+  S21Matrix &alias = matrix_2;
+  matrix_2 = alias;
+
+  EXPECT_EQ(matrix_2.data(), storage);
+  EXPECT_EQ(matrix_2.EqMatrix(matrix_1), true);
+}
+
 TEST(Other, IndexingSuccess) {
   S21Matrix matrix_1(2, 2);
   EXPECT_NO_THROW(matrix_1(1, 1));
@@ -177,6 +273,34 @@ TEST(Calculations, MulMatrixException) {
   EXPECT_ANY_THROW(matrix_1.MulMatrix(matrix_2));
 }
 
+TEST(Calculations, MulMatrixBlockedSuccess) {
+  const int rows = 67, cols = 131;
+  S21Matrix matrix_1(rows, cols);
+  S21Matrix matrix_2(cols, rows);
+  for (int i = 0; i < rows; ++i) {
+    for (int j = 0; j < cols; ++j) {
+      matrix_1(i, j) = (i * 7 + j * 3) % 11 - 5.0;
+      matrix_2(j, i) = (i * 5 + j * 2) % 13 - 6.0;
+    }
+  }
+  S21Matrix expected(rows, rows);
+  for (int i = 0; i < rows; ++i) {
+    for (int j = 0; j < rows; ++j) {
+      double sum = 0.0;
+      for (int k = 0; k < cols; ++k) sum += matrix_1(i, k) * matrix_2(k, j);
+      expected(i, j) = sum;
+    }
+  }
+
+  S21Matrix product = matrix_1 * matrix_2;
+  matrix_1.MulMatrix(matrix_2);
+
+  EXPECT_EQ(matrix_1.GetRows(), rows);
+  EXPECT_EQ(matrix_1.GetCols(), rows);
+  EXPECT_EQ(matrix_1.EqMatrix(expected), true);
+  EXPECT_EQ(product.EqMatrix(expected), true);
+}
+
 TEST(Overloads, EqMatrixSuccess) {
   S21Matrix matrix_1(3, 2);
   matrix_1.FillByOrder();
@@ -253,6 +377,69 @@ TEST(Overloads, MulMatrixSuccess) {
   EXPECT_DOUBLE_EQ(result.GetVal(0, 0), 188.0);
 }
 
+TEST(Overloads, ChainedExpressionSuccess) {
+  S21Matrix matrix_1(2, 3);
+  matrix_1.FillByOrder();
+  S21Matrix matrix_2(2, 3);
+  matrix_2.FillByEven();
+  S21Matrix matrix_3(2, 3);
+  matrix_3.FillWithOne();
+  S21Matrix result(2, 3);
+  double *storage = result.data();
+
+  result = matrix_1 + matrix_2 - matrix_3 * 2.0;
+  S21Matrix constructed = (matrix_1 - matrix_3) * 0.5 + matrix_2;
+
+  EXPECT_EQ(result.data(), storage);
+  for (int i = 0; i < 2; ++i) {
+    for (int j = 0; j < 3; ++j) {
+      double order = i * 3 + j + 1.0;
+      EXPECT_DOUBLE_EQ(result(i, j), order * 3.0 - 2.0);
+      EXPECT_DOUBLE_EQ(constructed(i, j), (order - 1.0) * 0.5 + order * 2.0);
+    }
+  }
+}
+
+TEST(Overloads, ChainedExpressionAliasingSuccess) {
+  S21Matrix matrix_1(2, 2);
+  matrix_1.FillByOrder();
+  S21Matrix matrix_2(2, 2);
+  matrix_2.FillWithOne();
+
+  matrix_1 = matrix_1 + matrix_1 * 2.0;
+  matrix_1 += matrix_2 * 3.0;
+  matrix_1 -= matrix_2 + matrix_2;
+
+  EXPECT_DOUBLE_EQ(matrix_1(0, 0), 4.0);
+  EXPECT_DOUBLE_EQ(matrix_1(0, 1), 7.0);
+  EXPECT_DOUBLE_EQ(matrix_1(1, 0), 10.0);
+  EXPECT_DOUBLE_EQ(matrix_1(1, 1), 13.0);
+}
+
+TEST(Overloads, ChainedExpressionResizeSuccess) {
+  S21Matrix matrix_1(3, 2);
+  matrix_1.FillByOrder();
+  S21Matrix result(1, 1);
+
+  result = matrix_1 * 2.0 - matrix_1;
+
+  EXPECT_EQ(result.GetRows(), 3);
+  EXPECT_EQ(result.GetCols(), 2);
+  EXPECT_EQ(result.EqMatrix(matrix_1), true);
+}
+
+TEST(Overloads, ChainedExpressionException) {
+  S21Matrix matrix_1(2, 2);
+  S21Matrix matrix_2(2, 2);
+  S21Matrix matrix_3(3, 2);
+
+  EXPECT_THROW(S21Matrix result = matrix_1 + matrix_2 - matrix_3,
+               std::logic_error);
+  EXPECT_THROW(S21Matrix result = matrix_3 * 2.0 + matrix_1,
+               std::logic_error);
+  EXPECT_THROW(matrix_1 += matrix_3 * 2.0, std::logic_error);
+}
+
 TEST(AssignmentCalculations, SumMatrixSuccess) {
   S21Matrix matrix_1(2, 2);
   matrix_1.FillByOrder();
@@ -321,6 +508,1696 @@ TEST(Special, TransposeSuccess) {
   EXPECT_DOUBLE_EQ(result(2, 1), 6.0);
 }
 
+TEST(Special, DeterminantSuccess) {
+  S21Matrix matrix(3, 3);
+  matrix(0, 0) = 2;
+  matrix(0, 1) = 5;
+  matrix(0, 2) = 7;
+  matrix(1, 0) = 6;
+  matrix(1, 1) = 3;
+  matrix(1, 2) = 4;
+  matrix(2, 0) = 5;
+  matrix(2, 1) = -2;
+  matrix(2, 2) = -3;
+  S21Matrix singular(4, 4);
+  singular.FillByOrder();
+
+  EXPECT_NEAR(matrix.Determinant(), -1.0, EPS);
+  EXPECT_DOUBLE_EQ(singular.Determinant(), 0.0);
+}
+
+TEST(Special, DeterminantException) {
+  S21Matrix matrix(3, 4);
+
+  EXPECT_THROW(matrix.Determinant(), std::logic_error);
+}
+
+TEST(Special, CalcComplementsSuccess) {
+  S21Matrix matrix(3, 3);
+  matrix(0, 0) = 1;
+  matrix(0, 1) = 2;
+  matrix(0, 2) = 3;
+  matrix(1, 1) = 4;
+  matrix(1, 2) = 2;
+  matrix(2, 0) = 5;
+  matrix(2, 1) = 2;
+  matrix(2, 2) = 1;
+  S21Matrix check(3, 3);
+  check(0, 1) = 10;
+  check(0, 2) = -20;
+  check(1, 0) = 4;
+  check(1, 1) = -14;
+  check(1, 2) = 8;
+  check(2, 0) = -8;
+  check(2, 1) = -2;
+  check(2, 2) = 4;
+  const S21Matrix &constant = matrix;
+
+  EXPECT_TRUE(constant.CalcComplements() == check);
+  EXPECT_DOUBLE_EQ(constant.Determinant(), -40.0);
+}
+
+TEST(Special, CalcComplementsSingularSuccess) {
+  S21Matrix matrix(3, 3);
+  matrix.FillByOrder();
+  S21Matrix check(3, 3);
+  check(0, 0) = check(0, 2) = check(2, 0) = check(2, 2) = -3;
+  check(0, 1) = check(1, 0) = check(1, 2) = check(2, 1) = 6;
+  check(1, 1) = -12;
+  S21Matrix one(1, 1);
+  one(0, 0) = 42;
+
+  EXPECT_TRUE(matrix.CalcComplements() == check);
+  EXPECT_DOUBLE_EQ(one.CalcComplements()(0, 0), 1.0);
+  EXPECT_THROW(S21Matrix(2, 3).CalcComplements(), std::logic_error);
+}
+
+TEST(Special, CalcComplementsRankDeficientSuccess) {
+  S21Matrix nilpotent(2, 2);
+  nilpotent(0, 1) = 1;
+  S21Matrix nilpotent_check(2, 2);
+  nilpotent_check(1, 0) = -1;
+  S21Matrix rank_two(4, 4);
+  rank_two.FillByOrder();
+
+  EXPECT_TRUE(nilpotent.CalcComplements() == nilpotent_check);
+  EXPECT_TRUE(rank_two.CalcComplements() == S21Matrix(4, 4));
+}
+
+TEST(Special, CalcComplementsLargeSingularSuccess) {
+  const int n = 120;
+  S21Matrix matrix(n, n);
+  for (int i = 0; i < n; ++i) {
+    for (int j = 0; j < n; ++j) matrix(i, j) = (i * 7 + j * 13) % 17 - 8.0;
+    matrix(i, i) += n;
+  }
+  for (int j = 0; j < n; ++j) matrix(n - 1, j) = matrix(0, j) - matrix(1, j);
+  S21Matrix complements = matrix.CalcComplements();
+  S21Matrix product(n, n);
+  product.Gemm(1.0, matrix, false, complements, true, 0.0);
+  S21Matrix minor(n - 1, n - 1);
+  for (int i = 0; i < n - 1; ++i) {
+    for (int j = 0; j < n - 1; ++j) minor(i, j) = matrix(i + 1, j + 1);
+  }
+  double expected = minor.Determinant();
+
+  EXPECT_NEAR(complements(0, 0), expected, fabs(expected) * 1e-9);
+  for (int i = 0; i < n; ++i) {
+    for (int j = 0; j < n; ++j) {
+      EXPECT_NEAR(product(i, j), 0.0, fabs(expected) * 1e-9);
+    }
+  }
+}
+
+TEST(Special, InverseMatrixSuccess) {
+  S21Matrix matrix(3, 3);
+  matrix(0, 0) = 2;
+  matrix(0, 1) = 5;
+  matrix(0, 2) = 7;
+  matrix(1, 0) = 6;
+  matrix(1, 1) = 3;
+  matrix(1, 2) = 4;
+  matrix(2, 0) = 5;
+  matrix(2, 1) = -2;
+  matrix(2, 2) = -3;
+  S21Matrix check(3, 3);
+  check(0, 0) = 1;
+  check(0, 1) = -1;
+  check(0, 2) = 1;
+  check(1, 0) = -38;
+  check(1, 1) = 41;
+  check(1, 2) = -34;
+  check(2, 0) = 27;
+  check(2, 1) = -29;
+  check(2, 2) = 24;
+
+  EXPECT_TRUE(matrix.InverseMatrix() == check);
+}
+
+TEST(Special, InverseMatrixException) {
+  S21Matrix singular(3, 3);
+  singular.FillByOrder();
+
+  EXPECT_THROW(singular.InverseMatrix(), std::logic_error);
+  EXPECT_THROW(S21Matrix(3, 2).InverseMatrix(), std::logic_error);
+}
+
+TEST(Special, InverseMatrixBlockedSuccess) {
+  const int size = 150;
+  S21Matrix matrix(size, size);
+  std::uint64_t seed = 42;
+  for (int i = 0; i < size; ++i) {
+    for (int j = 0; j < size; ++j) {
+      seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+      matrix(i, j) = static_cast<double>(seed >> 11) / (1ULL << 53) - 0.5;
+    }
+  }
+
+  S21Matrix product = matrix * matrix.InverseMatrix();
+
+  for (int i = 0; i < size; ++i) {
+    for (int j = 0; j < size; ++j) {
+      ASSERT_NEAR(product(i, j), i == j ? 1.0 : 0.0, 1e-9);
+    }
+  }
+}
+
+TEST(Special, LuDecompositionReuseSuccess) {
+  S21Matrix matrix(100, 100);
+  for (int i = 0; i < 100; ++i) {
+    for (int j = 0; j < 100; ++j) {
+      matrix(i, j) = (i == j ? 2.0 : 0.0) + ((i * 7 + j * 3) % 5) / 50.0;
+    }
+  }
+  S21LuDecomposition lu(matrix);
+
+  EXPECT_FALSE(lu.IsSingular());
+  EXPECT_EQ(lu.GetPivots().size(), 100u);
+  EXPECT_DOUBLE_EQ(lu.Determinant(), matrix.Determinant());
+  EXPECT_TRUE(lu.InverseMatrix() == matrix.InverseMatrix());
+  EXPECT_THROW(S21LuDecomposition(S21Matrix(2, 3)), std::logic_error);
+}
+
+TEST(Storage, ContiguousAlignedSuccess) {
+  S21Matrix matrix(3, 5);
+  matrix.FillByOrder();
+
+  EXPECT_EQ(reinterpret_cast<std::uintptr_t>(matrix.data()) %
+                S21Matrix::kAlignment,
+            0u);
+  EXPECT_GE(matrix.stride(), matrix.GetCols());
+  EXPECT_DOUBLE_EQ(matrix.data()[2 * matrix.stride() + 4], 15.0);
+}
+
+TEST(Storage, CopyKeepsElementsSuccess) {
+  S21Matrix matrix_1(100, 7);
+  matrix_1.FillByEven();
+  S21Matrix matrix_2(matrix_1);
+  S21Matrix matrix_3(1, 1);
+  matrix_3 = matrix_1;
+
+  EXPECT_NE(matrix_2.data(), matrix_1.data());
+  EXPECT_EQ(matrix_2.EqMatrix(matrix_1), true);
+  EXPECT_EQ(matrix_3.EqMatrix(matrix_1), true);
+  EXPECT_DOUBLE_EQ(matrix_3(99, 6), 1400.0);
+}
+
+TEST(Threads, SetNumThreadsFail) {
+  EXPECT_THROW(S21Matrix::SetNumThreads(0), std::invalid_argument);
+}
+
+TEST(Threads, ParallelMatchesSerialSuccess) {
+  const int rows = 300, cols = 280;
+  S21Matrix matrix_1(rows, cols);
+  S21Matrix matrix_2(rows, cols);
+  S21Matrix matrix_3(cols, rows);
+  for (int i = 0; i < rows; ++i) {
+    for (int j = 0; j < cols; ++j) {
+      matrix_1(i, j) = (i * 7 + j * 3) % 11 - 5.0;
+      matrix_2(i, j) = (i + j) % 5 * 0.5;
+      matrix_3(j, i) = (i * 5 + j * 2) % 13 - 6.0;
+    }
+  }
+  int default_threads = S21Matrix::GetNumThreads();
+
+  S21Matrix::SetNumThreads(1);
+  S21Matrix serial_sum = matrix_1 + matrix_2;
+  S21Matrix serial_mul = matrix_1 * matrix_3;
+  S21Matrix serial_transpose = matrix_1.Transpose();
+  S21Matrix::SetNumThreads(4);
+  S21Matrix parallel_sum = matrix_1 + matrix_2;
+  S21Matrix parallel_mul = matrix_1 * matrix_3;
+  S21Matrix parallel_transpose = matrix_1.Transpose();
+  S21Matrix::SetNumThreads(default_threads);
+
+  EXPECT_EQ(S21Matrix::GetNumThreads(), default_threads);
+  EXPECT_EQ(parallel_sum.EqMatrix(serial_sum), true);
+  EXPECT_EQ(parallel_mul.EqMatrix(serial_mul), true);
+  EXPECT_EQ(parallel_transpose.EqMatrix(serial_transpose), true);
+}
+
+TEST(Simd, SetLevelFail) {
+  EXPECT_THROW(S21Simd::SetLevel(NUMBER_OF_SIMD_LEVELS), std::invalid_argument);
+  EXPECT_THROW(S21Simd::SetLevel(-1), std::invalid_argument);
+}
+
+TEST(Simd, EveryLevelMatchesSuccess) {
+  const int rows = 13, cols = 37;
+  S21Matrix matrix_1(rows, cols);
+  S21Matrix matrix_2(rows, cols);
+  for (int i = 0; i < rows; ++i) {
+    for (int j = 0; j < cols; ++j) {
+      matrix_1(i, j) = i * 0.25 - j;
+      matrix_2(i, j) = (i * 3 + j) % 7 + 0.5;
+    }
+  }
+  S21Matrix transposed = matrix_2.Transpose();
+  int detected = S21Simd::DetectedLevel();
+  S21Simd::SetLevel(SIMD_SCALAR);
+  S21Matrix scalar_product = matrix_1 * transposed;
+
+  for (int level = SIMD_SCALAR; level <= detected; ++level) {
+    S21Simd::SetLevel(level);
+    EXPECT_EQ(S21Simd::GetLevel(), level);
+    S21Matrix sum = matrix_1 + matrix_2;
+    S21Matrix sub = matrix_1 - matrix_2;
+    S21Matrix mul = matrix_1 * -1.5;
+    S21Matrix product = matrix_1 * transposed;
+    S21Matrix almost(matrix_1);
+    almost(rows - 1, cols - 1) += EPS / 2;
+    S21Matrix differs(matrix_1);
+    differs(rows - 1, cols - 1) += EPS * 2;
+    S21Matrix differs_early(matrix_1);
+    differs_early(0, 1) -= 1.0;
+
+    for (int i = 0; i < rows; ++i) {
+      for (int j = 0; j < cols; ++j) {
+        EXPECT_DOUBLE_EQ(sum(i, j), matrix_1(i, j) + matrix_2(i, j));
+        EXPECT_DOUBLE_EQ(sub(i, j), matrix_1(i, j) - matrix_2(i, j));
+        EXPECT_DOUBLE_EQ(mul(i, j), matrix_1(i, j) * -1.5);
+      }
+    }
+    EXPECT_EQ(matrix_1.EqMatrix(almost), true);
+    EXPECT_EQ(matrix_1.EqMatrix(differs), false);
+    EXPECT_EQ(matrix_1.EqMatrix(differs_early), false);
+    EXPECT_EQ(product.EqMatrix(scalar_product), true);
+  }
+  S21Simd::SetLevel(detected);
+}
+
+TEST(Simd, TransposeEveryLevelSuccess) {
+  const int sizes[][2] = {{67, 131}, {131, 67}, {40, 40}, {1, 9}, {300, 300}};
+  int detected = S21Simd::DetectedLevel();
+  for (int level = SIMD_SCALAR; level <= detected; ++level) {
+    S21Simd::SetLevel(level);
+    for (const auto &size : sizes) {
+      S21Matrix matrix(size[0], size[1]);
+      matrix.FillByOrder();
+      S21Matrix transposed = matrix.Transpose();
+      S21Matrix in_place(matrix);
+      in_place.TransposeInPlace();
+
+      ASSERT_EQ(transposed.GetRows(), size[1]);
+      ASSERT_EQ(in_place.GetRows(), size[1]);
+      ASSERT_EQ(in_place.GetCols(), size[0]);
+      for (int i = 0; i < size[0]; ++i) {
+        for (int j = 0; j < size[1]; ++j) {
+          ASSERT_EQ(transposed(j, i), matrix(i, j));
+          ASSERT_EQ(in_place(j, i), matrix(i, j));
+        }
+      }
+    }
+  }
+  S21Simd::SetLevel(detected);
+}
+
+TEST(Simd, AxpyDotEveryLevelSuccess) {
+  const std::size_t count = 101;
+  double lhs[count], rhs[count], expected_axpy[count];
+  double expected_dot = 0.0;
+  for (std::size_t i = 0; i < count; ++i) {
+    lhs[i] = i * 0.5 - 7.0;
+    rhs[i] = (i % 9) + 0.25;
+    expected_dot += lhs[i] * rhs[i];
+    expected_axpy[i] = lhs[i] - 2.0 * rhs[i];
+  }
+  int detected = S21Simd::DetectedLevel();
+  for (int level = SIMD_SCALAR; level <= detected; ++level) {
+    S21Simd::SetLevel(level);
+    for (std::size_t size : {count, std::size_t{7}, std::size_t{0}}) {
+      double sum = 0.0;
+      for (std::size_t i = 0; i < size; ++i) sum += lhs[i] * rhs[i];
+      EXPECT_NEAR(S21Simd::Dot(lhs, rhs, size), sum, 1e-9);
+    }
+    EXPECT_NEAR(S21Simd::Dot(lhs, rhs, count), expected_dot, 1e-9);
+    double axpy[count];
+    std::memcpy(axpy, lhs, sizeof(axpy));
+    S21Simd::Axpy(axpy, -2.0, rhs, count);
+    for (std::size_t i = 0; i < count; ++i) {
+      ASSERT_DOUBLE_EQ(axpy[i], expected_axpy[i]);
+    }
+  }
+  S21Simd::SetLevel(detected);
+}
+
+TEST(Special, TransposeInPlaceSuccess) {
+  S21Matrix matrix(2, 3);
+  matrix.FillByOrder();
+  long before = allocation_count.load();
+  matrix.TransposeInPlace();
+  matrix.TransposeInPlace();
+  matrix.TransposeInPlace();
+  long allocations = allocation_count.load() - before;
+
+  EXPECT_EQ(matrix.GetRows(), 3);
+  EXPECT_EQ(matrix.GetCols(), 2);
+  EXPECT_DOUBLE_EQ(matrix(0, 1), 4.0);
+  EXPECT_DOUBLE_EQ(matrix(2, 0), 3.0);
+  EXPECT_DOUBLE_EQ(matrix(2, 1), 6.0);
+  EXPECT_LE(allocations, 3);  // The bits of the visited elements only
+}
+
+TEST(Views, BlockSharesStorageSuccess) {
+  S21Matrix matrix(4, 5);
+  matrix.FillByOrder();
+  S21MatrixView block(matrix, 1, 2, 2, 3);
+
+  EXPECT_EQ(block.GetRows(), 2);
+  EXPECT_EQ(block.GetCols(), 3);
+  EXPECT_DOUBLE_EQ(block(0, 0), 8.0);
+  EXPECT_DOUBLE_EQ(block(1, 2), 15.0);
+  block(1, 2) = -1.0;
+  EXPECT_DOUBLE_EQ(matrix(2, 4), -1.0);
+  EXPECT_DOUBLE_EQ(block.RowRange(1, 1)(0, 0), 13.0);
+  EXPECT_DOUBLE_EQ(block.ColRange(1, 2)(0, 1), 10.0);
+  EXPECT_THROW(S21MatrixView(matrix, 3, 0, 2, 1), std::out_of_range);
+  EXPECT_THROW(block.Block(0, 2, 1, 2), std::out_of_range);
+  EXPECT_THROW(block(2, 0), std::out_of_range);
+}
+
+TEST(Views, TransposeSuccess) {
+  S21Matrix matrix(3, 4);
+  matrix.FillByOrder();
+  S21MatrixView transposed = S21MatrixView(matrix).Transpose();
+  S21Matrix check = matrix.Transpose();
+
+  EXPECT_EQ(transposed.GetRows(), 4);
+  EXPECT_EQ(transposed.GetCols(), 3);
+  EXPECT_EQ(transposed.data(), matrix.data());
+  EXPECT_TRUE(transposed == S21MatrixView(check));
+  EXPECT_TRUE(S21Matrix(transposed) == check);
+}
+
+TEST(Views, ArithmeticSuccess) {
+  S21Matrix matrix(4, 4);
+  matrix.FillByOrder();
+  S21Matrix other(2, 2);
+  other.FillWithOne();
+  S21MatrixView top_left(matrix, 0, 0, 2, 2);
+  S21MatrixView bottom_right(matrix, 2, 2, 2, 2);
+
+  top_left += S21MatrixView(other);
+  bottom_right -= top_left.Transpose();
+  top_left *= 2.0;
+
+  EXPECT_DOUBLE_EQ(matrix(0, 0), 4.0);
+  EXPECT_DOUBLE_EQ(matrix(1, 0), 12.0);
+  EXPECT_DOUBLE_EQ(matrix(2, 2), 9.0);
+  EXPECT_DOUBLE_EQ(matrix(2, 3), 6.0);
+  EXPECT_DOUBLE_EQ(matrix(0, 2), 3.0);
+  EXPECT_THROW(top_left += S21MatrixView(matrix), std::logic_error);
+  EXPECT_THROW(top_left -= S21MatrixView(matrix), std::logic_error);
+}
+
+TEST(Views, MulMatrixSuccess) {
+  S21Matrix matrix(5, 6);
+  matrix.FillByOrder();
+  S21MatrixView block(matrix, 1, 1, 3, 4);
+  S21Matrix copy(block);
+
+  S21Matrix product = block * block.Transpose();
+  S21Matrix check = copy * copy.Transpose();
+  S21Matrix square(4, 4);
+  square.FillByEven();
+  block.MulMatrix(S21MatrixView(square));
+  S21Matrix check_square(3, 4);
+  for (int i = 0; i < 3; ++i) {
+    for (int j = 0; j < 4; ++j) {
+      for (int k = 0; k < 4; ++k) {
+        check_square(i, j) += copy(i, k) * square(k, j);
+      }
+    }
+  }
+
+  EXPECT_TRUE(product == check);
+  EXPECT_TRUE(S21Matrix(block) == check_square);
+  EXPECT_DOUBLE_EQ(matrix(0, 0), 1.0);
+  EXPECT_DOUBLE_EQ(matrix(4, 5), 30.0);
+  EXPECT_THROW(block * block, std::logic_error);
+  EXPECT_THROW(block *= block, std::logic_error);
+}
+
+TEST(Views, MulMatrixEmptySuccess) {
+  S21Matrix matrix(2, 2);
+  matrix.FillByOrder();
+  S21MatrixView row(matrix, 0, 0, 1, 0);
+  S21MatrixView column(matrix, 0, 0, 0, 1);
+
+  S21Matrix product = row * column;
+  EXPECT_EQ(product.GetRows(), 1);
+  EXPECT_EQ(product.GetCols(), 1);
+  EXPECT_DOUBLE_EQ(product(0, 0), 0.0);
+  EXPECT_THROW(column * row, std::logic_error);
+  EXPECT_NO_THROW(column.MulMatrix(S21MatrixView(matrix, 0, 0, 1, 1)));
+}
+
+TEST(Views, AssignmentSuccess) {
+  S21Matrix matrix(4, 4);
+  S21Matrix source(2, 2);
+  source.FillByOrder();
+  S21MatrixView block(matrix, 2, 0, 2, 2);
+
+  block = source;
+  S21MatrixView(matrix, 0, 2, 2, 2) = block.Transpose();
+  S21MatrixView(matrix, 0, 0, 2, 2) = source + source * 2.0;
+
+  EXPECT_DOUBLE_EQ(matrix(3, 1), 4.0);
+  EXPECT_DOUBLE_EQ(matrix(0, 3), 3.0);
+  EXPECT_DOUBLE_EQ(matrix(1, 1), 12.0);
+  EXPECT_THROW(block = S21Matrix(3, 3), std::logic_error);
+}
+
+TEST(Files, SaveLoadSuccess) {
+  const std::string path = "s21_files_save_load.bin";
+  S21Matrix matrix(5, 7);
+  matrix.FillByOrder();
+  matrix *= 0.1;
+  matrix.Save(path);
+
+  S21Matrix loaded = S21Matrix::Load(path);
+  EXPECT_EQ(loaded.GetRows(), 5);
+  EXPECT_EQ(loaded.GetCols(), 7);
+  EXPECT_TRUE(loaded == matrix);
+  std::remove(path.c_str());
+}
+
+TEST(Files, MappedSuccess) {
+  const std::string path = "s21_files_mapped.bin";
+  S21Matrix matrix(300, 200);
+  matrix.FillByOrder();
+  matrix.Save(path);
+
+  S21Matrix mapped(path);
+  EXPECT_EQ(reinterpret_cast<std::uintptr_t>(mapped.data()) %
+                S21Matrix::kAlignment,
+            0U);
+  EXPECT_TRUE(mapped == matrix);
+
+  // Changes stay in memory, the file keeps the saved elements
+  mapped(0, 0) = -1.0;
+  EXPECT_DOUBLE_EQ(S21Matrix(path)(0, 0), 1.0);
+
+  // The mapped storage is released and replaced like any other
+  S21Matrix moved(std::move(mapped));
+  moved *= moved.Transpose();
+  EXPECT_EQ(moved.GetRows(), 300);
+  EXPECT_EQ(moved.GetCols(), 300);
+  mapped = S21Matrix(path);
+  mapped = mapped + mapped;
+  matrix *= 2.0;
+  EXPECT_TRUE(mapped == matrix);
+  std::remove(path.c_str());
+}
+
+TEST(Files, Exception) {
+  const std::string path = "s21_files_exception.bin";
+  EXPECT_THROW(S21Matrix::Load("s21_files_missing.bin"), std::runtime_error);
+
+  S21Matrix matrix(4, 4);
+  matrix.FillByOrder();
+  matrix.Save(path);
+  std::FILE* file = std::fopen(path.c_str(), "r+b");
+  ASSERT_NE(file, nullptr);
+  std::fseek(file, S21MatrixFile::kHeaderBytes + 3 * sizeof(double),
+             SEEK_SET);
+  double changed = 100.0;
+  std::fwrite(&changed, sizeof(changed), 1, file);
+  std::fclose(file);
+  EXPECT_THROW(S21Matrix::Load(path), std::invalid_argument);
+
+  file = std::fopen(path.c_str(), "wb");
+  std::fputs("not a matrix file, but long enough to hold a whole header", file);
+  std::fputs("...", file);
+  std::fclose(file);
+  EXPECT_THROW(S21Matrix::Load(path), std::invalid_argument);
+  EXPECT_THROW(S21Matrix mapped(path), std::invalid_argument);
+
+  matrix.Save(path);
+  EXPECT_EQ(truncate(path.c_str(), S21MatrixFile::kHeaderBytes + 8), 0);
+  EXPECT_THROW(S21Matrix mapped(path), std::invalid_argument);
+  std::remove(path.c_str());
+}
+
+TEST(Files, MultiplySuccess) {
+  const std::string a_path = "s21_files_multiply_a.bin";
+  const std::string b_path = "s21_files_multiply_b.bin";
+  const std::string c_path = "s21_files_multiply_c.bin";
+  S21Matrix a(37, 53), b(53, 29);
+  a.FillByOrder();
+  b.FillByEven();
+  a *= 1e-2;
+  b *= 1e-3;
+  a.Save(a_path);
+  b.Save(b_path);
+
+  S21Matrix expected(37, 29);
+  for (int i = 0; i < 37; ++i) {
+    for (int j = 0; j < 29; ++j) {
+      for (int l = 0; l < 53; ++l) expected(i, j) += a(i, l) * b(l, j);
+    }
+  }
+  // The smallest budget gives 8 x 8 tiles with partial tiles on every edge
+  S21MatrixFile::Multiply(a_path, b_path, c_path,
+                          5 * sizeof(double) * S21MatrixFile::kMinTile *
+                              S21MatrixFile::kMinTile);
+  EXPECT_TRUE(S21Matrix::Load(c_path) == expected);
+
+  S21MatrixFile::Multiply(a_path, b_path, c_path);
+  EXPECT_TRUE(S21Matrix::Load(c_path) == expected);
+
+  EXPECT_THROW(S21MatrixFile::Multiply(a_path, a_path, c_path),
+               std::logic_error);
+  EXPECT_THROW(S21MatrixFile::Multiply(a_path, b_path, c_path, 64),
+               std::invalid_argument);
+  std::remove(a_path.c_str());
+  std::remove(b_path.c_str());
+  std::remove(c_path.c_str());
+}
+
+/**
+ * @brief Batch of 'count' random matrices, each with a heavy diagonal
+ */
+static S21MatrixBatch MakeRandomBatch(int count, int rows, int cols) {
+  S21MatrixBatch batch(count, rows, cols);
+  std::uint64_t seed = 7;
+  for (int index = 0; index < count; ++index) {
+    for (int i = 0; i < rows; ++i) {
+      for (int j = 0; j < cols; ++j) {
+        seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+        batch(index, i, j) = static_cast<double>(seed >> 11) / (1ULL << 53) -
+                             0.5 + (i == j ? 2.0 : 0.0);
+      }
+    }
+  }
+  return batch;
+}
+
+TEST(Batch, ArithmeticSuccess) {
+  S21MatrixBatch batch_1 = MakeRandomBatch(70, 3, 5);
+  S21MatrixBatch batch_2 = batch_1 * S21MatrixBatch(70, 5, 5);
+  EXPECT_FALSE(batch_1 == batch_2);
+
+  S21MatrixBatch result = batch_1;
+  result += batch_1;
+  result *= 3.0;
+  result -= batch_1;
+  for (int index = 0; index < 70; ++index) {
+    S21Matrix expected = batch_1.GetMatrix(index) * 5.0;
+    EXPECT_TRUE(result.GetMatrix(index) == expected);
+  }
+
+  S21MatrixBatch transposed = batch_1.Transpose();
+  EXPECT_EQ(transposed.GetRows(), 5);
+  EXPECT_EQ(transposed.GetCols(), 3);
+  S21Matrix matrix = batch_1.GetMatrix(69);
+  EXPECT_TRUE(transposed.GetMatrix(69) == matrix.Transpose());
+
+  matrix *= 2.0;
+  batch_1.SetMatrix(3, matrix);
+  EXPECT_TRUE(batch_1.GetMatrix(3) == matrix);
+}
+
+TEST(Batch, MulMatrixSuccess) {
+  S21MatrixBatch lhs = MakeRandomBatch(131, 4, 6);
+  S21MatrixBatch rhs = MakeRandomBatch(131, 6, 3);
+  for (int level = 0; level <= S21Simd::DetectedLevel(); ++level) {
+    S21Simd::SetLevel(level);
+    S21MatrixBatch result = lhs;
+    result *= rhs;
+    for (int index = 0; index < 131; ++index) {
+      S21Matrix expected(4, 3);
+      for (int i = 0; i < 4; ++i) {
+        for (int j = 0; j < 3; ++j) {
+          for (int l = 0; l < 6; ++l) {
+            expected(i, j) += lhs(index, i, l) * rhs(index, l, j);
+          }
+        }
+      }
+      EXPECT_TRUE(result.GetMatrix(index) == expected);
+    }
+  }
+  S21Simd::SetLevel(S21Simd::DetectedLevel());
+}
+
+TEST(Batch, DeterminantAndInverseSuccess) {
+  for (int size : {1, 4, 6}) {
+    S21MatrixBatch batch = MakeRandomBatch(100, size, size);
+    // Needs a row exchange in every column
+    for (int i = 0; i < size; ++i) {
+      batch(5, i, i) = 0.0;
+      batch(5, i, (i + 1) % size) = 3.0;
+    }
+    for (int level = 0; level <= S21Simd::DetectedLevel(); ++level) {
+      S21Simd::SetLevel(level);
+      std::vector<double> determinant = batch.Determinant();
+      S21MatrixBatch inverse = batch.InverseMatrix();
+      ASSERT_EQ(determinant.size(), 100U);
+      for (int index = 0; index < 100; ++index) {
+        S21Matrix matrix = batch.GetMatrix(index);
+        EXPECT_NEAR(determinant[index], matrix.Determinant(), 1e-9);
+        EXPECT_TRUE(inverse.GetMatrix(index) == matrix.InverseMatrix());
+      }
+    }
+    S21Simd::SetLevel(S21Simd::DetectedLevel());
+  }
+
+  S21MatrixBatch batch = MakeRandomBatch(10, 3, 3);
+  for (int j = 0; j < 3; ++j) batch(7, 2, j) = 2.0 * batch(7, 0, j);
+  EXPECT_DOUBLE_EQ(batch.Determinant()[7], 0.0);
+  EXPECT_THROW(batch.InverseMatrix(), std::logic_error);
+}
+
+TEST(Batch, CopyMovedFromSuccess) {
+  S21MatrixBatch batch(5, 2, 2);
+  S21MatrixBatch moved(std::move(batch));
+  S21MatrixBatch copy(batch);
+  moved = batch;
+
+  EXPECT_EQ(copy.GetCount(), 0);
+  EXPECT_EQ(copy.data(), nullptr);
+  EXPECT_EQ(moved.GetCount(), 0);
+  EXPECT_EQ(moved.data(), nullptr);
+}
+
+TEST(Batch, Exception) {
+  EXPECT_THROW(S21MatrixBatch(0, 2, 2), std::invalid_argument);
+  EXPECT_THROW(S21MatrixBatch(2, 0, 2), std::invalid_argument);
+  S21MatrixBatch batch(5, 2, 3);
+  EXPECT_THROW(batch(5, 0, 0), std::out_of_range);
+  EXPECT_THROW(batch(0, 2, 0), std::out_of_range);
+  EXPECT_THROW(batch.GetMatrix(-1), std::out_of_range);
+  EXPECT_THROW(batch.SetMatrix(0, S21Matrix(3, 2)), std::logic_error);
+  EXPECT_THROW(batch += S21MatrixBatch(4, 2, 3), std::logic_error);
+  EXPECT_THROW(batch -= S21MatrixBatch(5, 3, 2), std::logic_error);
+  EXPECT_THROW(batch *= S21MatrixBatch(5, 2, 3), std::logic_error);
+  EXPECT_THROW(batch.Determinant(), std::logic_error);
+  EXPECT_THROW(batch.InverseMatrix(), std::logic_error);
+}
+
+/**
+ * @brief rows x cols matrix with about one element in 'period' nonzero
+ */
+static S21Matrix MakeSparseDense(int rows, int cols, int period) {
+  S21Matrix matrix(rows, cols);
+  std::uint64_t seed = 11;
+  for (int i = 0; i < rows; ++i) {
+    for (int j = 0; j < cols; ++j) {
+      seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+      if ((seed >> 33) % period == 0) {
+        matrix(i, j) = static_cast<double>((seed >> 40) % 100) / 10.0 + 0.5;
+      }
+    }
+  }
+  return matrix;
+}
+
+TEST(Sparse, ConversionSuccess) {
+  S21Matrix dense = MakeSparseDense(40, 30, 10);
+  S21SparseMatrix sparse(dense);
+  EXPECT_GT(sparse.GetNonZeros(), 0U);
+  EXPECT_LT(sparse.GetNonZeros(), 40U * 30U / 5U);
+  EXPECT_TRUE(sparse.ToDense() == dense);
+  EXPECT_DOUBLE_EQ(sparse.GetVal(7, 9), dense(7, 9));
+
+  S21SparseMatrix from_triplets(2, 3, {{1, 2, 1.5}, {0, 1, 2.0}, {1, 2, 0.5},
+                                       {1, 0, -1.0}});
+  EXPECT_EQ(from_triplets.GetNonZeros(), 3U);
+  EXPECT_DOUBLE_EQ(from_triplets.GetVal(1, 2), 2.0);
+  EXPECT_DOUBLE_EQ(from_triplets.GetVal(0, 0), 0.0);
+  S21SparseMatrix from_arrays(2, 3, {0, 1, 3}, {1, 0, 2}, {2.0, -1.0, 2.0});
+  EXPECT_TRUE(from_arrays == from_triplets);
+  EXPECT_TRUE(S21SparseMatrix(2, 3, {0, 1, 1}, {1}, {0.0}) ==
+              S21SparseMatrix(2, 3));
+}
+
+TEST(Sparse, OperationsSuccess) {
+  S21Matrix a = MakeSparseDense(50, 70, 8);
+  S21Matrix b = MakeSparseDense(70, 20, 8);
+  S21SparseMatrix sparse_a(a), sparse_b(b);
+
+  S21Matrix expected(50, 20);
+  for (int i = 0; i < 50; ++i) {
+    for (int j = 0; j < 20; ++j) {
+      for (int k = 0; k < 70; ++k) expected(i, j) += a(i, k) * b(k, j);
+    }
+  }
+  EXPECT_TRUE(sparse_a * b == expected);
+  EXPECT_TRUE((sparse_a * sparse_b).ToDense() == expected);
+
+  S21Matrix dense = MakeSparseDense(50, 70, 1);
+  S21Matrix sum = a + dense;
+  EXPECT_TRUE(sparse_a + dense == sum);
+  EXPECT_TRUE(dense + sparse_a == sum);
+
+  S21SparseMatrix transposed = sparse_a.Transpose();
+  EXPECT_EQ(transposed.GetRows(), 70);
+  EXPECT_TRUE(transposed.ToDense() == a.Transpose());
+  EXPECT_TRUE(transposed.Transpose() == sparse_a);
+}
+
+TEST(Sparse, Exception) {
+  EXPECT_THROW(S21SparseMatrix(0, 3), std::invalid_argument);
+  EXPECT_THROW(S21SparseMatrix(2, 3, {{2, 0, 1.0}}), std::out_of_range);
+  EXPECT_THROW(S21SparseMatrix(2, 3, {0, 2, 2}, {1, 1}, {1.0, 1.0}),
+               std::invalid_argument);
+  EXPECT_THROW(S21SparseMatrix(2, 3, {0, 1}, {1}, {1.0}),
+               std::invalid_argument);
+  S21SparseMatrix sparse(2, 3);
+  EXPECT_THROW(sparse.GetVal(0, 3), std::out_of_range);
+  EXPECT_THROW(sparse * S21Matrix(2, 3), std::logic_error);
+  EXPECT_THROW(sparse * S21SparseMatrix(2, 3), std::logic_error);
+  EXPECT_THROW(sparse + S21Matrix(3, 2), std::logic_error);
+}
+
+TEST(BasicMatrix, FloatEveryLevelSuccess) {
+  const int sizes[][3] = {{7, 5, 3}, {37, 53, 29}, {130, 260, 70}};
+  int detected = S21Simd::DetectedLevel();
+  for (int level = SIMD_SCALAR; level <= detected; ++level) {
+    S21Simd::SetLevel(level);
+    for (const auto &size : sizes) {
+      S21Matrix a = MakeSparseDense(size[0], size[1], 1);
+      S21Matrix b = MakeSparseDense(size[1], size[2], 1);
+      S21MatrixF a_float(a), b_float(b);
+      S21MatrixF product = a_float * b_float;
+      S21MatrixF wide = a_float.Multiply(b_float, GEMM_ACCUMULATE_DOUBLE);
+      ASSERT_EQ(product.GetRows(), size[0]);
+      ASSERT_EQ(product.GetCols(), size[2]);
+      for (int i = 0; i < size[0]; ++i) {
+        for (int j = 0; j < size[2]; ++j) {
+          double expected = 0.0;
+          for (int k = 0; k < size[1]; ++k) {
+            expected += static_cast<double>(a_float(i, k)) * b_float(k, j);
+          }
+          ASSERT_NEAR(product(i, j), expected, expected * 1e-5);
+          ASSERT_EQ(wide(i, j), static_cast<float>(expected));
+        }
+      }
+
+      S21MatrixF sum = a_float + a_float * 2.0f - a_float;
+      EXPECT_TRUE(sum == a_float * 2.0f);
+      EXPECT_TRUE(sum.Transpose().Transpose() == sum);
+      EXPECT_EQ(sum.Transpose()(1, 0), sum(0, 1));
+      S21Matrix back = sum.ToMatrix();
+      EXPECT_EQ(back(size[0] - 1, 0), sum(size[0] - 1, 0));
+      EXPECT_TRUE(S21MatrixF(back) == sum);
+    }
+  }
+  S21Simd::SetLevel(detected);
+}
+
+TEST(BasicMatrix, DoubleAccumulationSuccess) {
+  const int k = 1 << 16;
+  S21MatrixF a(1, k), b(k, 1);
+  for (int p = 0; p < k; ++p) {
+    a(0, p) = 1.0f;
+    b(p, 0) = 0.1f;
+  }
+  float exact = static_cast<float>(k * static_cast<double>(0.1f));
+  float native = a.Multiply(b)(0, 0);
+  float wide = a.Multiply(b, GEMM_ACCUMULATE_DOUBLE)(0, 0);
+  EXPECT_EQ(wide, exact);
+  EXPECT_GT(fabsf(native - exact), 0.0f);
+
+  S21MatrixF c(1, 1);
+  c(0, 0) = 1.0f;
+  S21MatrixF tolerance(c);
+  tolerance(0, 0) += 0.5f * S21ElementTraits<float>::kEps;
+  EXPECT_TRUE(c == tolerance);
+  tolerance(0, 0) += S21ElementTraits<float>::kEps;
+  EXPECT_FALSE(c == tolerance);
+}
+
+TEST(BasicMatrix, ComplexSuccess) {
+  using Complex = std::complex<double>;
+  S21MatrixC a(2, 2), b(2, 1);
+  a(0, 0) = Complex(1, 1);
+  a(0, 1) = Complex(0, 2);
+  a(1, 0) = Complex(3, 0);
+  a(1, 1) = Complex(1, -1);
+  b(0, 0) = Complex(2, 0);
+  b(1, 0) = Complex(0, 1);
+  S21MatrixC product = a * b;
+  EXPECT_EQ(product(0, 0), Complex(0, 2));
+  EXPECT_EQ(product(1, 0), Complex(7, 1));
+
+  S21MatrixC scaled = a * Complex(0, 1);
+  EXPECT_EQ(scaled(1, 1), Complex(1, 1));
+  scaled -= a * Complex(0, 1);
+  EXPECT_TRUE(scaled == S21MatrixC(2, 2));
+  EXPECT_EQ(a.Transpose()(0, 1), Complex(3, 0));
+  EXPECT_TRUE(S21MatrixC(S21Matrix(2, 2)) == S21MatrixC(2, 2));
+}
+
+TEST(BasicMatrix, Exception) {
+  EXPECT_THROW(S21MatrixF(0, 3), std::invalid_argument);
+  EXPECT_THROW(S21MatrixF(3, 0), std::invalid_argument);
+  EXPECT_THROW(S21MatrixF(3, 3, nullptr), std::invalid_argument);
+  S21MatrixF a(2, 3), b(2, 3);
+  EXPECT_THROW(a(2, 0), std::out_of_range);
+  EXPECT_THROW(a * b, std::logic_error);
+  EXPECT_THROW(a + S21MatrixF(3, 2), std::logic_error);
+  EXPECT_THROW(a - S21MatrixF(3, 2), std::logic_error);
+  EXPECT_NO_THROW(a * S21MatrixF(3, 4));
+  EXPECT_FALSE(a == S21MatrixF(3, 2));
+}
+
+TEST(BasicMatrix, CopyUsesDefaultResourceSuccess) {
+  std::pmr::memory_resource *pool = S21PoolResource::Instance();
+  S21MatrixF pooled(2, 3, pool);
+  pooled(1, 2) = 4.0f;
+  S21MatrixF copy(pooled);
+  S21MatrixF assigned(1, 1, pool);
+  assigned = copy;
+
+  EXPECT_EQ(copy.GetResource(), std::pmr::get_default_resource());
+  EXPECT_EQ(assigned.GetResource(), pool);
+  EXPECT_TRUE(copy == pooled);
+  EXPECT_TRUE(assigned == pooled);
+}
+
+TEST(Strassen, OddSizesSuccess) {
+  const int sizes[][3] = {{67, 53, 71}, {64, 64, 64}, {33, 65, 17}};
+  int default_threads = S21Matrix::GetNumThreads();
+  for (int threads : {1, 4}) {
+    S21Matrix::SetNumThreads(threads);
+    for (const auto &size : sizes) {
+      S21Matrix a = MakeSparseDense(size[0], size[2], 1);
+      S21Matrix b = MakeSparseDense(size[2], size[1], 1);
+      S21Matrix expected(size[0], size[1]);
+      S21Matrix result(size[0], size[1]);
+      S21Gemm(size[0], size[1], size[2], 1.0, a.data(), a.stride(), 1,
+              b.data(), b.stride(), 1, 0.0, expected.data(), expected.stride());
+      S21Strassen(size[0], size[1], size[2], a.data(), a.stride(), b.data(),
+                  b.stride(), result.data(), result.stride(), 8);
+      for (int i = 0; i < size[0]; ++i) {
+        for (int j = 0; j < size[1]; ++j) {
+          ASSERT_NEAR(result(i, j), expected(i, j), 1e-9 * expected(i, j));
+        }
+      }
+    }
+  }
+  S21Matrix::SetNumThreads(default_threads);
+}
+
+TEST(Strassen, MulMatrixStrassenSuccess) {
+  S21Matrix matrix = MakeSparseDense(75, 75, 1);
+  S21Matrix other = MakeSparseDense(75, 75, 2);
+  S21Matrix expected = matrix * other;
+  matrix.MulMatrixStrassen(other, 16);
+  EXPECT_TRUE(matrix == expected);
+
+  S21Matrix small(3, 2), small_other(2, 3);
+  small.FillByOrder();
+  small_other.FillByOrder();
+  S21Matrix small_expected = small * small_other;
+  small.MulMatrixStrassen(small_other);
+  EXPECT_TRUE(small == small_expected);
+}
+
+TEST(Strassen, Exception) {
+  S21Matrix matrix(4, 4), other(3, 4);
+  EXPECT_THROW(matrix.MulMatrixStrassen(other), std::logic_error);
+  EXPECT_THROW(matrix.MulMatrixStrassen(matrix, 0), std::invalid_argument);
+  EXPECT_EQ(matrix.GetCols(), 4);
+}
+
+TEST(Vector, ConstructionSuccess) {
+  S21Vector vector(4);
+  EXPECT_EQ(vector.GetSize(), 4);
+  EXPECT_DOUBLE_EQ(vector(3), 0.0);
+  S21Matrix column(3, 1), row(1, 3);
+  column.FillByOrder();
+  row.FillByEven();
+  S21Vector from_column(column), from_row(row, S21PoolResource::Instance());
+  EXPECT_DOUBLE_EQ(from_column(2), 3.0);
+  EXPECT_DOUBLE_EQ(from_row(2), row(0, 2));
+  EXPECT_EQ(from_row.GetResource(), S21PoolResource::Instance());
+  EXPECT_TRUE(from_column.ToMatrix() == column);
+
+  S21Vector copy(from_column);
+  EXPECT_TRUE(copy == from_column);
+  vector(0) = 1.0;
+  const double *storage = vector.data();
+  S21Vector moved(std::move(vector));
+  EXPECT_EQ(moved.data(), storage);
+  EXPECT_EQ(vector.GetSize(), 0);
+  EXPECT_DOUBLE_EQ(moved(0), 1.0);
+  storage = copy.data();
+  copy = from_row;
+  EXPECT_EQ(copy.data(), storage);
+  EXPECT_TRUE(copy == from_row);
+  copy = moved;
+  EXPECT_EQ(copy.GetSize(), 4);
+  EXPECT_FALSE(copy == from_row);
+}
+
+TEST(Vector, CopyMovedFromSuccess) {
+  S21Vector vector(3);
+  S21Vector moved(std::move(vector));
+  S21Vector copy(vector);
+  moved = vector;
+
+  EXPECT_EQ(copy.GetSize(), 0);
+  EXPECT_EQ(copy.data(), nullptr);
+  EXPECT_EQ(moved.GetSize(), 0);
+  EXPECT_EQ(moved.data(), nullptr);
+  moved = S21Vector(2);
+  EXPECT_EQ(moved.GetSize(), 2);
+}
+
+TEST(Vector, ArithmeticSuccess) {
+  S21Vector lhs(2), rhs(2);
+  lhs(0) = 3.0;
+  lhs(1) = 4.0;
+  rhs(0) = 1.0;
+  rhs(1) = -1.0;
+
+  EXPECT_DOUBLE_EQ(lhs.Norm(), 5.0);
+  EXPECT_DOUBLE_EQ(lhs.Dot(rhs), -1.0);
+  lhs += rhs;
+  EXPECT_DOUBLE_EQ(lhs(1), 3.0);
+  lhs -= rhs;
+  lhs *= 2.0;
+  EXPECT_DOUBLE_EQ(lhs(0), 6.0);
+  lhs.Axpy(-2.0, rhs);
+  EXPECT_DOUBLE_EQ(lhs(0), 4.0);
+  EXPECT_DOUBLE_EQ(lhs(1), 10.0);
+  EXPECT_TRUE(lhs.EqVector(lhs));
+}
+
+TEST(Vector, GemvSuccess) {
+  const int sizes[][2] = {{37, 53}, {300, 700}, {1, 1}};
+  for (const auto &size : sizes) {
+    int rows = size[0], cols = size[1];
+    S21Matrix matrix(rows, cols);
+    S21Vector x(cols), x_t(rows), y(rows), y_t(cols);
+    for (int i = 0; i < rows; ++i) {
+      for (int j = 0; j < cols; ++j) matrix(i, j) = sin(i * 0.3 + j * 0.7);
+      x_t(i) = cos(i * 0.2);
+      y(i) = i;
+    }
+    for (int j = 0; j < cols; ++j) {
+      x(j) = cos(j * 0.5);
+      y_t(j) = NAN;
+    }
+    S21Vector expected(y), expected_t(cols);
+    for (int i = 0; i < rows; ++i) {
+      double sum = 0.0;
+      for (int j = 0; j < cols; ++j) {
+        sum += matrix(i, j) * x(j);
+        expected_t(j) += 2.0 * matrix(i, j) * x_t(i);
+      }
+      expected(i) = 1.5 * sum + 0.5 * y(i);
+    }
+
+    y.Gemv(1.5, matrix, false, x, 0.5);
+    y_t.Gemv(2.0, matrix, true, x_t, 0.0);
+    EXPECT_TRUE(y == expected);
+    EXPECT_TRUE(y_t == expected_t);
+    y_t.Gemv(-1.0, matrix, true, x_t, 2.0);
+    expected_t *= 1.5;
+    EXPECT_TRUE(y_t == expected_t);
+  }
+  S21Matrix square(2, 2);
+  square.FillByOrder();
+  S21Vector vector(2);
+  vector(0) = 1.0;
+  vector(1) = 1.0;
+  vector.Gemv(1.0, square, false, vector, 1.0);
+  EXPECT_DOUBLE_EQ(vector(0), 4.0);
+  EXPECT_DOUBLE_EQ(vector(1), 8.0);
+}
+
+TEST(Vector, GerSuccess) {
+  S21Matrix matrix(300, 500), expected(300, 500);
+  S21Vector x(300), y(500);
+  for (int i = 0; i < 300; ++i) x(i) = i * 0.5;
+  for (int j = 0; j < 500; ++j) y(j) = 1.0 - j;
+  matrix.FillByOrder();
+  expected.FillByOrder();
+  expected.Gemm(-2.0, x.ToMatrix(), false, y.ToMatrix(), true, 1.0);
+
+  matrix.Ger(-2.0, x, y);
+  EXPECT_TRUE(matrix == expected);
+}
+
+TEST(Vector, Exception) {
+  S21Matrix matrix(3, 4);
+  S21Vector three(3), four(4);
+  EXPECT_THROW(S21Vector(0), std::invalid_argument);
+  EXPECT_THROW(S21Vector{matrix}, std::invalid_argument);
+  EXPECT_THROW(three(3), std::out_of_range);
+  EXPECT_THROW(three += four, std::logic_error);
+  EXPECT_THROW(three -= four, std::logic_error);
+  EXPECT_THROW(three.Dot(four), std::logic_error);
+  EXPECT_THROW(three.Axpy(1.0, four), std::logic_error);
+  EXPECT_THROW(three.Gemv(1.0, matrix, false, three, 0.0), std::logic_error);
+  EXPECT_THROW(three.Gemv(1.0, matrix, true, three, 0.0), std::logic_error);
+  EXPECT_THROW(matrix.Ger(1.0, four, three), std::logic_error);
+  EXPECT_NO_THROW(three.Gemv(1.0, matrix, false, four, 0.0));
+  EXPECT_NO_THROW(four.Gemv(1.0, matrix, true, three, 0.0));
+  EXPECT_NO_THROW(matrix.Ger(1.0, three, four));
+}
+
+TEST(Solve, LuSuccess) {
+  S21Matrix matrix(100, 100), rhs(100, 7), product(100, 7);
+  for (int i = 0; i < 100; ++i) {
+    for (int j = 0; j < 100; ++j) matrix(i, j) = sin(i * j * 0.37 + i + 1.0);
+    for (int j = 0; j < 7; ++j) rhs(i, j) = cos(i + j * 5.0);
+  }
+
+  S21Matrix solution = matrix.Solve(rhs);
+  EXPECT_EQ(solution.GetRows(), 100);
+  EXPECT_EQ(solution.GetCols(), 7);
+  product.Gemm(1.0, matrix, false, solution, false, 0.0);
+  EXPECT_TRUE(product == rhs);
+  S21LuDecomposition lu(matrix);
+  EXPECT_TRUE(lu.Solve(rhs) == solution);
+  product.Gemm(1.0, matrix.InverseMatrix(), false, rhs, false, 0.0);
+  EXPECT_TRUE(product == solution);
+}
+
+TEST(Solve, CholeskySuccess) {
+  const int n = 300;
+  S21Matrix factor(n, n), rhs(n, 3), product(n, 3);
+  for (int i = 0; i < n; ++i) {
+    for (int j = 0; j < n; ++j) factor(i, j) = sin(i * j * 0.11 + j);
+    for (int j = 0; j < 3; ++j) rhs(i, j) = i - j;
+  }
+  S21Matrix matrix(n, n);
+  matrix.Gemm(1.0, factor, true, factor, false, 0.0);
+  for (int i = 0; i < n; ++i) matrix(i, i) += n;
+
+  S21CholeskyDecomposition cholesky(matrix);
+  ASSERT_TRUE(cholesky.IsPositiveDefinite());
+  const S21Matrix &l = cholesky.GetL();
+  EXPECT_DOUBLE_EQ(l.GetVal(0, 1), 0.0);
+  S21Matrix restored(n, n);
+  restored.Gemm(1.0, l, false, l, true, 0.0);
+  EXPECT_TRUE(restored == matrix);
+
+  S21Matrix solution = matrix.Solve(rhs);
+  product.Gemm(1.0, matrix, false, solution, false, 0.0);
+  EXPECT_TRUE(product == rhs);
+  EXPECT_TRUE(cholesky.Solve(rhs) == solution);
+  rhs.MulNumber(-2.0);
+  solution.MulNumber(-2.0);
+  EXPECT_TRUE(cholesky.Solve(rhs) == solution);
+
+  S21Matrix small(3, 3);
+  small(0, 0) = 4.0;
+  small(0, 1) = small(1, 0) = 2.0;
+  small(1, 1) = 5.0;
+  small(1, 2) = small(2, 1) = 1.0;
+  small(2, 2) = 3.0;
+  EXPECT_DOUBLE_EQ(S21CholeskyDecomposition(small).Determinant(), 44.0);
+}
+
+TEST(Solve, IndefiniteFallsBackToLuSuccess) {
+  S21Matrix matrix(2, 2), rhs(2, 1);
+  matrix(0, 1) = 1.0;
+  matrix(1, 0) = 1.0;
+  rhs(0, 0) = 2.0;
+  rhs(1, 0) = 3.0;
+
+  EXPECT_FALSE(S21CholeskyDecomposition(matrix).IsPositiveDefinite());
+  S21Matrix solution = matrix.Solve(rhs);
+  EXPECT_DOUBLE_EQ(solution(0, 0), 3.0);
+  EXPECT_DOUBLE_EQ(solution(1, 0), 2.0);
+}
+
+TEST(Solve, SmallNonSymmetricUsesLuSuccess) {
+  S21Matrix matrix(2, 2), rhs(2, 1), product(2, 1);
+  matrix(0, 0) = 4e-8;
+  matrix(0, 1) = 9e-8;
+  matrix(1, 0) = 1e-8;
+  matrix(1, 1) = 4e-8;
+  rhs(0, 0) = 1.0;
+  rhs(1, 0) = 1.0;
+
+  S21Matrix solution = matrix.Solve(rhs);
+  product.Gemm(1.0, matrix, false, solution, false, 0.0);
+  EXPECT_NEAR(product(0, 0), 1.0, 1e-9);
+  EXPECT_NEAR(product(1, 0), 1.0, 1e-9);
+  EXPECT_NEAR(solution(0, 0), -5e8 / 7.0, 1e2);
+  EXPECT_NEAR(solution(1, 0), 3e8 / 7.0, 1e2);
+}
+
+TEST(Solve, Exception) {
+  S21Matrix square(3, 3), rhs(3, 2);
+  EXPECT_THROW(square.Solve(rhs), std::logic_error);
+  EXPECT_THROW(S21LuDecomposition(square).Solve(rhs), std::logic_error);
+  EXPECT_THROW(S21CholeskyDecomposition(square).Solve(rhs),
+               std::logic_error);
+  EXPECT_THROW(S21CholeskyDecomposition(square).Determinant(),
+               std::logic_error);
+  square.FillWithOne();
+  square(1, 1) = 2.0;
+  square(2, 2) = 3.0;
+  EXPECT_THROW(square.Solve(S21Matrix(2, 2)), std::logic_error);
+  EXPECT_THROW(S21LuDecomposition(square).Solve(S21Matrix(2, 2)),
+               std::logic_error);
+  EXPECT_THROW(S21Matrix(3, 2).Solve(rhs), std::logic_error);
+  EXPECT_THROW(S21CholeskyDecomposition(S21Matrix(3, 2)), std::logic_error);
+  EXPECT_NO_THROW(square.Solve(rhs));
+}
+
+TEST(Fingerprint, InvalidatedOnChangeSuccess) {
+  S21Matrix matrix(3, 4);
+  matrix.FillByOrder();
+  std::uint64_t fingerprint = matrix.Fingerprint();
+  S21Matrix copy(matrix);
+
+  EXPECT_NE(fingerprint, 0u);
+  EXPECT_EQ(copy.Fingerprint(), fingerprint);
+  EXPECT_EQ(S21Matrix(matrix, S21PoolResource::Instance()).Fingerprint(),
+            fingerprint);
+  copy(1, 1) = -1.0;
+  EXPECT_NE(copy.Fingerprint(), fingerprint);
+  copy(1, 1) = 6.0;
+  EXPECT_EQ(copy.Fingerprint(), fingerprint);
+  copy.MulNumber(2.0);
+  EXPECT_NE(copy.Fingerprint(), fingerprint);
+  copy = matrix;
+  EXPECT_EQ(copy.Fingerprint(), fingerprint);
+  copy.data()[0] = 0.0;
+  EXPECT_NE(copy.Fingerprint(), fingerprint);
+
+  S21Matrix moved(std::move(matrix));
+  EXPECT_EQ(moved.Fingerprint(), fingerprint);
+  S21Matrix reshaped(4, 3);
+  reshaped.FillByOrder();
+  EXPECT_NE(reshaped.Fingerprint(), fingerprint);
+}
+
+TEST(Fingerprint, SpareColumnsSuccess) {
+  S21Matrix matrix(3, 5);
+  matrix.FillByOrder();
+  matrix.SetCols(3);
+  S21Matrix packed(matrix);
+  EXPECT_NE(matrix.stride(), packed.stride());
+  EXPECT_EQ(matrix.Fingerprint(), S21Matrix(packed).Fingerprint());
+  EXPECT_TRUE(matrix.EqMatrix(packed));
+  packed.SetCols(4);
+  EXPECT_NE(matrix.Fingerprint(), packed.Fingerprint());
+  EXPECT_FALSE(matrix.EqMatrix(packed));
+}
+
+TEST(Fingerprint, StaleReferenceDoesNotFoolEqMatrixSuccess) {
+  S21Matrix matrix(2, 2), copy(2, 2);
+  matrix.FillByOrder();
+  copy.FillByOrder();
+  double &element = matrix(1, 1);
+  EXPECT_EQ(matrix.Fingerprint(), copy.Fingerprint());
+  element = 42.0;
+  EXPECT_FALSE(matrix.EqMatrix(copy));
+}
+
+TEST(ResultCache, HitsAndMissesSuccess) {
+  S21ResultCache cache;
+  S21Matrix lhs(4, 3), rhs(3, 4);
+  lhs.FillByOrder();
+  rhs.FillByOrder();
+
+  auto product = cache.MulMatrix(lhs, rhs);
+  EXPECT_TRUE(*product == lhs * rhs);
+  EXPECT_EQ(cache.MulMatrix(S21Matrix(lhs), rhs), product);
+  EXPECT_TRUE(*cache.Transpose(lhs) == lhs.Transpose());
+  EXPECT_NE(cache.MulMatrix(rhs, lhs), product);
+  rhs(0, 0) = 0.0;
+  EXPECT_NE(cache.MulMatrix(lhs, rhs), product);
+  EXPECT_TRUE(*cache.MulMatrix(lhs, rhs) == lhs * rhs);
+
+  S21Matrix square(2, 2);
+  square(0, 0) = 2.0;
+  square(0, 1) = 1.0;
+  square(1, 0) = 1.0;
+  square(1, 1) = 3.0;
+  auto inverse = cache.InverseMatrix(square);
+  EXPECT_TRUE(*inverse == square.InverseMatrix());
+  EXPECT_EQ(cache.InverseMatrix(square), inverse);
+
+  S21ResultCacheStats stats = cache.GetStats();
+  EXPECT_EQ(stats.hits, 3u);
+  EXPECT_EQ(stats.misses, 5u);
+  EXPECT_EQ(stats.evictions, 0u);
+  EXPECT_EQ(stats.entries, 5u);
+  EXPECT_EQ(stats.bytes, (16 + 12 + 9 + 16 + 4) * sizeof(double));
+  cache.Clear();
+  EXPECT_EQ(cache.GetStats().entries, 0u);
+  EXPECT_EQ(cache.GetStats().bytes, 0u);
+  EXPECT_TRUE(*inverse == square.InverseMatrix());
+}
+
+TEST(ResultCache, LeastRecentlyUsedEvictedSuccess) {
+  S21ResultCache cache(3 * 16 * sizeof(double));
+  S21Matrix first(4, 4), second(4, 4), third(4, 4), fourth(4, 4);
+  first.FillByOrder();
+  second.FillByEven();
+  third.FillWithOne();
+  fourth.FillWithOne();
+  fourth.MulNumber(4.0);
+
+  cache.Transpose(first);
+  cache.Transpose(second);
+  cache.Transpose(third);
+  cache.Transpose(first);
+  cache.Transpose(fourth);
+  S21ResultCacheStats stats = cache.GetStats();
+  EXPECT_EQ(stats.evictions, 1u);
+  EXPECT_EQ(stats.entries, 3u);
+  cache.Transpose(first);
+  EXPECT_EQ(cache.GetStats().hits, 2u);
+  cache.Transpose(second);
+  EXPECT_EQ(cache.GetStats().misses, 5u);
+
+  S21ResultCache small(8 * sizeof(double));
+  EXPECT_TRUE(*small.Transpose(first) == first.Transpose());
+  EXPECT_EQ(small.GetStats().entries, 0u);
+}
+
+TEST(ResultCache, Exception) {
+  S21ResultCache cache;
+  S21Matrix singular(2, 2);
+  EXPECT_THROW(cache.InverseMatrix(singular), std::logic_error);
+  EXPECT_THROW(cache.MulMatrix(S21Matrix(2, 3), S21Matrix(2, 3)),
+               std::logic_error);
+  EXPECT_EQ(cache.GetStats().entries, 0u);
+  EXPECT_EQ(cache.GetStats().misses, 2u);
+}
+
+TEST(Resize, SetRowsSuccess) {
+  S21Matrix matrix(4, 3);
+  matrix.FillByOrder();
+  const double *storage = matrix.data();
+
+  matrix.SetRows(2);
+  EXPECT_EQ(matrix.GetRows(), 2);
+  EXPECT_EQ(matrix.GetRowCapacity(), 4);
+  matrix.SetRows(3);
+  EXPECT_EQ(matrix.data(), storage);
+  EXPECT_DOUBLE_EQ(matrix(1, 2), 6.0);
+  EXPECT_DOUBLE_EQ(matrix(2, 0), 0.0);
+
+  matrix.SetRows(5);
+  EXPECT_EQ(matrix.GetRowCapacity(), 8);
+  EXPECT_DOUBLE_EQ(matrix(0, 0), 1.0);
+  EXPECT_DOUBLE_EQ(matrix(4, 2), 0.0);
+  storage = matrix.data();
+  matrix.ReserveRows(2);
+  EXPECT_EQ(matrix.data(), storage);
+  matrix.ReserveRows(100);
+  EXPECT_EQ(matrix.GetRowCapacity(), 100);
+  EXPECT_EQ(matrix.GetRows(), 5);
+  EXPECT_DOUBLE_EQ(matrix(1, 0), 4.0);
+}
+
+TEST(Resize, SetColsSuccess) {
+  S21Matrix matrix(3, 5);
+  matrix.FillByOrder();
+  const double *storage = matrix.data();
+  matrix.SetCols(3);
+  S21Matrix expected(3, 3);
+  for (int i = 0; i < 3; ++i) {
+    for (int j = 0; j < 3; ++j) expected(i, j) = i * 5.0 + j + 1.0;
+  }
+
+  EXPECT_EQ(matrix.data(), storage);
+  EXPECT_EQ(matrix.stride(), 5);
+  EXPECT_TRUE(matrix == expected);
+  EXPECT_TRUE(S21Matrix(matrix) == expected);
+  EXPECT_TRUE(matrix * matrix == expected * expected);
+  EXPECT_TRUE(matrix.Transpose() == expected.Transpose());
+  EXPECT_DOUBLE_EQ(matrix.Determinant(), expected.Determinant());
+
+  matrix.SetCols(4);
+  EXPECT_EQ(matrix.data(), storage);
+  EXPECT_DOUBLE_EQ(matrix(2, 3), 0.0);
+  matrix.SetCols(2);
+  matrix.Save("s21_resize_set_cols.bin");
+  EXPECT_TRUE(S21Matrix::Load("s21_resize_set_cols.bin") == matrix);
+  std::remove("s21_resize_set_cols.bin");
+  matrix.TransposeInPlace();
+  EXPECT_EQ(matrix.GetRows(), 2);
+  EXPECT_EQ(matrix.GetCols(), 3);
+  EXPECT_DOUBLE_EQ(matrix(1, 0), 2.0);
+  EXPECT_DOUBLE_EQ(matrix(0, 1), 6.0);
+
+  matrix.SetCols(7);
+  EXPECT_EQ(matrix.stride(), 7);
+  EXPECT_DOUBLE_EQ(matrix(1, 1), 7.0);
+  EXPECT_DOUBLE_EQ(matrix(1, 6), 0.0);
+}
+
+TEST(Resize, AppendRowSuccess) {
+  S21Matrix matrix(1, 3);
+  S21Matrix row(1, 3);
+  int reallocations = 0;
+  for (int i = 1; i < 1000; ++i) {
+    const double *storage = matrix.data();
+    row(0, 0) = i;
+    if (i % 2) {
+      matrix.AppendRow(row);
+    } else {
+      matrix.AppendRow();
+      matrix(i, 0) = i;
+    }
+    reallocations += matrix.data() != storage;
+  }
+
+  EXPECT_EQ(matrix.GetRows(), 1000);
+  EXPECT_EQ(reallocations, 10);
+  for (int i = 0; i < 1000; ++i) EXPECT_DOUBLE_EQ(matrix(i, 0), i);
+  S21Matrix single(1, 2);
+  single.FillByOrder();
+  single.AppendRow(single);
+  EXPECT_DOUBLE_EQ(single(1, 1), 2.0);
+}
+
+TEST(Resize, Exception) {
+  S21Matrix matrix(2, 3);
+  EXPECT_THROW(matrix.SetRows(0), std::invalid_argument);
+  EXPECT_THROW(matrix.SetCols(0), std::invalid_argument);
+  EXPECT_THROW(matrix.AppendRow(S21Matrix(1, 2)), std::logic_error);
+  EXPECT_THROW(matrix.AppendRow(matrix), std::logic_error);
+  EXPECT_EQ(matrix.GetRows(), 2);
+}
+
+TEST(Text, ParseSuccess) {
+  S21Matrix expected(2, 3);
+  expected.FillByOrder();
+  expected(1, 2) = -0.25;
+
+  S21Matrix csv =
+      S21MatrixText::Parse("\n1, 2 ,3\r\n  \n4,5,-0.25e0\r\n\n", ',');
+  S21Matrix tsv = S21MatrixText::Parse("1\t2\t3\n4\t5\t-.25", '\t');
+  S21Matrix spaces = S21MatrixText::Parse(" 1  2\t3\n4 5 -0.25 \n");
+
+  EXPECT_TRUE(csv == expected);
+  EXPECT_TRUE(tsv == expected);
+  EXPECT_TRUE(spaces == expected);
+}
+
+TEST(Text, FormatRoundTripSuccess) {
+  S21Matrix matrix(3, 4);
+  matrix.FillByOrder();
+  matrix *= 0.1;
+  matrix(0, 0) = 1.0 / 3.0;
+  matrix(2, 3) = -4.9e-324;
+  matrix(1, 1) = 1.7976931348623157e308;
+
+  EXPECT_EQ(S21MatrixText::Format(S21Matrix(1, 2)), "0 0\n");
+  for (char delimiter : {S21MatrixText::kWhitespace, ',', '\t', ';'}) {
+    S21Matrix parsed = S21MatrixText::Parse(
+        S21MatrixText::Format(matrix, delimiter), delimiter);
+    ASSERT_EQ(parsed.GetRows(), 3);
+    ASSERT_EQ(parsed.GetCols(), 4);
+    for (int i = 0; i < 3; ++i) {
+      for (int j = 0; j < 4; ++j) {
+        EXPECT_EQ(parsed(i, j), matrix(i, j)) << delimiter;
+      }
+    }
+  }
+}
+
+TEST(Text, LargeFilesAndStreamsSuccess) {
+  const std::string path = "s21_text_large.csv";
+  S21Matrix matrix(4000, 64);
+  matrix.FillByOrder();
+  matrix *= 0.37;
+  int num_threads = S21Matrix::GetNumThreads();
+  S21Matrix::SetNumThreads(4);
+
+  S21MatrixText::Save(matrix, path, ',');
+  S21Matrix loaded = S21MatrixText::Load(path, ',');
+  std::stringstream stream;
+  S21MatrixText::Write(matrix, stream, '\t');
+  S21Matrix read = S21MatrixText::Read(stream, '\t');
+
+  S21Matrix::SetNumThreads(num_threads);
+  std::remove(path.c_str());
+  EXPECT_GT(stream.str().size(), 2 * S21MatrixText::kChunkBytes);
+  ASSERT_EQ(loaded.GetRows(), 4000);
+  ASSERT_EQ(read.GetRows(), 4000);
+  EXPECT_EQ(std::memcmp(loaded.data(), matrix.data(), 4000 * 64 * 8), 0);
+  EXPECT_EQ(std::memcmp(read.data(), matrix.data(), 4000 * 64 * 8), 0);
+}
+
+TEST(Text, Exception) {
+  EXPECT_THROW(S21MatrixText::Parse("1 2\n3\n"), std::invalid_argument);
+  EXPECT_THROW(S21MatrixText::Parse("1 2\n3 4 5\n"), std::invalid_argument);
+  EXPECT_THROW(S21MatrixText::Parse("1 x\n"), std::invalid_argument);
+  EXPECT_THROW(S21MatrixText::Parse("1,2\n"), std::invalid_argument);
+  EXPECT_THROW(S21MatrixText::Parse("1,2,\n", ','), std::invalid_argument);
+  EXPECT_THROW(S21MatrixText::Parse("1,,2\n", ','), std::invalid_argument);
+  EXPECT_THROW(S21MatrixText::Parse(" \n\r\n"), std::invalid_argument);
+  EXPECT_THROW(S21MatrixText::Parse("1 2", '.'), std::invalid_argument);
+  EXPECT_THROW(S21MatrixText::Format(S21Matrix(), 'e'), std::invalid_argument);
+  EXPECT_THROW(S21MatrixText::Load("s21_text_missing.csv"), std::runtime_error);
+}
+
+TEST(Gemm, TransposedOperandsSuccess) {
+  S21Matrix a(4, 3), b(3, 4);
+  a.FillByOrder();
+  b.FillByEven();
+  for (int transpose_a = 0; transpose_a < 2; ++transpose_a) {
+    for (int transpose_b = 0; transpose_b < 2; ++transpose_b) {
+      S21Matrix op_a = transpose_a ? a.Transpose() : a;
+      S21Matrix op_b = transpose_b ? b.Transpose() : b;
+      S21Matrix c(4, 4);
+      c.FillWithOne();
+      S21Matrix expected = (a * b) * 2.0 - c * 0.5;
+
+      c.Gemm(2.0, op_a, transpose_a, op_b, transpose_b, -0.5);
+
+      EXPECT_TRUE(c == expected) << transpose_a << transpose_b;
+    }
+  }
+}
+
+TEST(Gemm, AccumulateWithoutAllocationsSuccess) {
+  S21Matrix a(64, 64), b(64, 64), c(64, 64);
+  a.FillByOrder();
+  b.FillWithOne();
+  c.FillByEven();
+  S21Matrix expected = c + (a * b) * 0.25;
+  c.Gemm(0.25, a, false, b, false, 0.0);
+  c = expected - (a * b) * 0.25;
+
+  long before = allocation_count.load();
+  c.Gemm(0.25, a, false, b, false, 1.0);
+  long allocations = allocation_count.load() - before;
+
+  EXPECT_EQ(allocations, 0);
+  EXPECT_TRUE(c == expected);
+}
+
+TEST(Gemm, OperandIsResultSuccess) {
+  S21Matrix a(4, 4), b(4, 4);
+  a.FillByOrder();
+  b.FillByEven();
+  S21Matrix expected = a * b + a;
+
+  a.Gemm(1.0, a, false, b, false, 1.0);
+
+  EXPECT_TRUE(a == expected);
+}
+
+TEST(Gemm, Exception) {
+  S21Matrix a(2, 3), b(3, 4), c(2, 4);
+  EXPECT_THROW(c.Gemm(1.0, a, true, b, false, 0.0), std::logic_error);
+  EXPECT_THROW(c.Gemm(1.0, a, false, b, true, 0.0), std::logic_error);
+  EXPECT_THROW(a.Gemm(1.0, a, false, b, false, 0.0), std::logic_error);
+  EXPECT_NO_THROW(c.Gemm(1.0, a, false, b, false, 0.0));
+}
+
+TEST(Instrumentation, CountersSuccess) {
+  S21Instrumentation::Reset();
+  S21Matrix matrix_1(4, 4);
+  S21Matrix matrix_2(4, 4);
+  matrix_1.MulMatrix(matrix_2);
+  S21Matrix result = matrix_1 + matrix_2;
+  S21InstrumentationSnapshot snapshot = S21Instrumentation::Snapshot();
+
+  const S21OperationStats &mul = snapshot[INSTRUMENT_MUL_MATRIX];
+  if (S21Instrumentation::Enabled()) {
+    EXPECT_EQ(snapshot[INSTRUMENT_CONSTRUCT].calls, 3u);
+    EXPECT_EQ(snapshot[INSTRUMENT_CONSTRUCT].allocations, 3u);
+    EXPECT_EQ(snapshot[INSTRUMENT_EXPRESSION].calls, 1u);
+    EXPECT_EQ(snapshot[INSTRUMENT_EXPRESSION].allocations, 0u);
+    EXPECT_EQ(mul.calls, 1u);
+    EXPECT_EQ(mul.flops, 128u);
+    EXPECT_EQ(mul.bytes, 384u);
+    EXPECT_EQ(mul.allocations, 1u);
+    EXPECT_EQ(mul.allocated_bytes, 128u);
+    std::uint64_t histogram_calls = 0;
+    for (auto calls : mul.histogram) histogram_calls += calls;
+    EXPECT_EQ(histogram_calls, 1u);
+  } else {
+    for (const auto &stats : snapshot) {
+      EXPECT_EQ(stats.calls, 0u);
+      EXPECT_EQ(stats.allocations, 0u);
+    }
+  }
+
+  S21Instrumentation::Reset();
+  EXPECT_EQ(S21Instrumentation::Snapshot()[INSTRUMENT_MUL_MATRIX].calls, 0u);
+}
+
+TEST(Instrumentation, JsonSuccess) {
+  std::string json = S21Instrumentation::ToJson();
+  EXPECT_NE(json.find(S21Instrumentation::Enabled() ? "\"enabled\": true"
+                                                    : "\"enabled\": false"),
+            std::string::npos);
+  for (int i = 0; i < NUMBER_OF_INSTRUMENTED_OPERATIONS; ++i) {
+    std::string name = S21Instrumentation::Name(i);
+    EXPECT_NE(json.find("\"" + name + "\": {\"calls\": "), std::string::npos);
+  }
+}
+
+TEST(Instrumentation, Exception) {
+  EXPECT_THROW(S21Instrumentation::Name(-1), std::out_of_range);
+  EXPECT_THROW(S21Instrumentation::Name(NUMBER_OF_INSTRUMENTED_OPERATIONS),
+               std::out_of_range);
+}
+
+TEST(Allocations, RvalueOperandsReuseStorageSuccess) {
+  S21Matrix matrix_1(2, 2);
+  matrix_1.FillByOrder();
+  S21Matrix matrix_2(2, 2);
+  matrix_2.FillWithOne();
+  S21Matrix temporary(matrix_1);
+  const double *storage = temporary.data();
+
+  S21Matrix result = matrix_2 - (std::move(temporary) * 2.0 + matrix_2);
+
+  EXPECT_EQ(result.data(), storage);
+  EXPECT_DOUBLE_EQ(result(0, 0), -2.0);
+  EXPECT_DOUBLE_EQ(result(1, 1), -8.0);
+}
+
+TEST(Allocations, SteadyStateLoopAllocatesNothing) {
+  S21Matrix matrix_1(4, 4);
+  matrix_1.FillByOrder();
+  S21Matrix matrix_2(4, 4);
+  matrix_2.FillByEven();
+  S21Matrix result(4, 4);
+  S21Matrix copy(4, 4);
+
+  long before = allocation_count.load();
+  for (int i = 0; i < 100; ++i) {
+    result = matrix_1 + matrix_2;
+    result = matrix_1 - matrix_2 * 0.5 + result;
+    result += matrix_1 * 2.0;
+    copy = result;
+  }
+  long allocations = allocation_count.load() - before;
+
+  EXPECT_EQ(allocations, 0);
+  EXPECT_DOUBLE_EQ(result(0, 0), 5.0);
+}
+
+TEST(Resources, DefaultResourceSuccess) {
+  S21Matrix matrix(2, 2);
+  S21Matrix pooled(2, 2, S21PoolResource::Instance());
+  S21Matrix copy(pooled);
+
+  EXPECT_EQ(matrix.GetResource(), std::pmr::get_default_resource());
+  EXPECT_EQ(pooled.GetResource(), S21PoolResource::Instance());
+  EXPECT_EQ(copy.GetResource(), std::pmr::get_default_resource());
+  EXPECT_THROW(S21Matrix(2, 2, nullptr), std::invalid_argument);
+}
+
+TEST(Resources, PoolChurnAllocatesNothing) {
+  std::pmr::memory_resource *pool = S21PoolResource::Instance();
+  S21Matrix matrix_1(4, 4, pool);
+  matrix_1.FillByOrder();
+  {
+    S21Matrix warm_up_1(4, 4, pool);
+    S21Matrix warm_up_2(4, 4, pool);
+  }
+
+  long before = allocation_count.load();
+  for (int i = 0; i < 100; ++i) {
+    S21Matrix matrix_2(matrix_1, pool);
+    S21Matrix matrix_3 = matrix_2.Transpose();
+    matrix_2 += matrix_3;
+    EXPECT_EQ(matrix_3.GetResource(), pool);
+  }
+  long allocations = allocation_count.load() - before;
+
+  EXPECT_EQ(allocations, 0);
+}
+
+TEST(Resources, ArenaSuccess) {
+  alignas(S21Matrix::kAlignment) static char buffer[4096];
+  std::pmr::monotonic_buffer_resource arena(
+      buffer, sizeof(buffer), std::pmr::null_memory_resource());
+  S21Matrix matrix_1(3, 3, &arena);
+  matrix_1.FillByOrder();
+  S21Matrix matrix_2(matrix_1, &arena);
+  matrix_2 = matrix_1 * matrix_2;
+
+  S21Matrix check(3, 3);
+  check.FillByOrder();
+  check *= check;
+
+  EXPECT_TRUE(matrix_2 == check);
+  EXPECT_EQ(matrix_2.GetResource(), &arena);
+}
+
+TEST(Fixed, ArithmeticMatchesDynamic) {
+  S21FixedMatrix<4, 4> fixed_1;
+  fixed_1.FillByOrder();
+  S21FixedMatrix<4, 4> fixed_2;
+  fixed_2.FillByEven();
+  S21Matrix matrix_1(4, 4);
+  matrix_1.FillByOrder();
+  S21Matrix matrix_2(4, 4);
+  matrix_2.FillByEven();
+
+  long before = allocation_count.load();
+  S21FixedMatrix<4, 4> fixed_result = (fixed_1 + fixed_2) * fixed_1;
+  fixed_result -= fixed_2 * 0.5;
+  fixed_result *= fixed_2;
+  EXPECT_EQ(allocation_count.load() - before, 0);
+
+  S21Matrix result = matrix_1 + matrix_2;
+  result *= matrix_1;
+  result -= matrix_2 * 0.5;
+  result *= matrix_2;
+
+  EXPECT_TRUE(result == S21Matrix(fixed_result));
+  EXPECT_TRUE((fixed_result == S21FixedMatrix<4, 4>(result)));
+  EXPECT_EQ(sizeof(fixed_result), 16 * sizeof(double));
+}
+
+TEST(Fixed, RectangularSuccess) {
+  S21FixedMatrix<2, 3> fixed_1;
+  fixed_1.FillByOrder();
+  S21FixedMatrix<3, 4> fixed_2;
+  fixed_2.FillByEven();
+
+  S21FixedMatrix<2, 4> product = fixed_1 * fixed_2;
+  S21FixedMatrix<3, 2> transposed = fixed_1.Transpose();
+
+  EXPECT_EQ(product.GetRows(), 2);
+  EXPECT_EQ(product.GetCols(), 4);
+  EXPECT_DOUBLE_EQ(product(0, 0), 76.0);
+  EXPECT_DOUBLE_EQ(product(1, 3), 256.0);
+  EXPECT_DOUBLE_EQ(transposed(2, 0), 3.0);
+  EXPECT_DOUBLE_EQ(transposed(0, 1), 4.0);
+}
+
+TEST(Fixed, Exception) {
+  S21FixedMatrix<2, 2> fixed;
+  S21Matrix matrix(2, 3);
+
+  EXPECT_THROW(fixed(2, 0), std::out_of_range);
+  EXPECT_THROW(fixed(0, -1), std::out_of_range);
+  EXPECT_THROW((S21FixedMatrix<2, 2>(matrix)), std::invalid_argument);
+}
+
 int main(int argc, char **argv) {
   ::testing::InitGoogleTest(&argc, argv);
 
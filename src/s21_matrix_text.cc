@@ -0,0 +1,376 @@
+/*
+ * Copyright 2023 Gleb Tolstenev
+ * yonnarge@student.21-school.ru
+ *
+ * s21_matrix_text.cc is the source code file for the text import and export
+ * of s21_matrix_oop library
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "s21_matrix_text.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <charconv>
+#include <climits>
+#include <cstring>
+#include <fstream>
+#include <istream>
+#include <ostream>
+#include <stdexcept>
+#include <vector>
+
+#include "s21_thread_pool.h"
+
+namespace {
+
+/* Longest text of a double from std::to_chars, -2.2250738585072014e-308 */
+constexpr std::size_t kMaxElementChars = 24;
+
+/* Chunks formatted in parallel before they are written */
+constexpr long kRoundChunks = 16;
+
+/* Size of the reads from a stream */
+constexpr std::size_t kReadBytes = std::size_t{1} << 20;
+
+[[noreturn]] void ThrowTextError(const std::string& what) {
+  throw std::invalid_argument("The text was rejected. " + what);
+}
+
+[[noreturn]] void ThrowFileError(const std::string& what,
+                                 const std::string& path) {
+  throw std::runtime_error(what + " '" + path + "': " + std::strerror(errno));
+}
+
+/**
+ * @brief Rejects delimiters that may be a part of a number or of a line end
+ */
+void CheckDelimiter(char delimiter) {
+  if (delimiter == '\0' ||
+      std::isalnum(static_cast<unsigned char>(delimiter)) ||
+      std::strchr("+-.\r\n", delimiter)) {
+    throw std::invalid_argument("The delimiter is not supported");
+  }
+}
+
+bool IsBlank(char c) { return c == ' ' || c == '\t' || c == '\r'; }
+
+/**
+ * @brief Tells whether 'c' is skipped around the elements, the delimiter
+ * is not unless it is kWhitespace
+ */
+bool IsSkipped(char c, char delimiter) {
+  return IsBlank(c) &&
+         (c != delimiter || delimiter == S21MatrixText::kWhitespace);
+}
+
+bool IsEmptyLine(const char* begin, const char* end) {
+  return std::all_of(begin, end, IsBlank);
+}
+
+/**
+ * @brief Calls line(begin, end) on every line of [begin, end), the line
+ * breaks are not included
+ */
+template <typename Line>
+void ForEachLine(const char* begin, const char* end, const Line& line) {
+  while (begin != end) {
+    auto next = static_cast<const char*>(
+        std::memchr(begin, '\n', static_cast<std::size_t>(end - begin)));
+    const char* line_end = next ? next : end;
+    line(begin, line_end);
+    begin = next ? next + 1 : end;
+  }
+}
+
+/**
+ * @brief Parses the elements of one line into 'row'
+ * @return Number of elements, 'capacity' + 1 when there are more than
+ * 'capacity' of them, -1 when an element is malformed
+ */
+int ParseLine(const char* p, const char* end, char delimiter, double* row,
+              int capacity) {
+  bool whitespace = delimiter == S21MatrixText::kWhitespace;
+  int count = 0;
+  while (true) {
+    while (p != end && IsSkipped(*p, delimiter)) ++p;
+    if (p == end) return whitespace || count == 0 ? count : -1;
+    if (count == capacity) return capacity + 1;
+    auto [next, error] = std::from_chars(p, end, row[count]);
+    if (error != std::errc()) return -1;
+    ++count;
+    p = next;
+    if (whitespace) {
+      if (p != end && !IsSkipped(*p, delimiter)) return -1;
+      continue;
+    }
+    while (p != end && IsSkipped(*p, delimiter)) ++p;
+    if (p == end) return count;
+    if (*p++ != delimiter) return -1;
+  }
+}
+
+/**
+ * @brief Splits the text into chunks of about kChunkBytes that end with a
+ * line break
+ * @return Bounds of the chunks, chunk i is [bounds[i], bounds[i + 1])
+ */
+std::vector<const char*> SplitIntoChunks(const char* begin, const char* end) {
+  std::vector<const char*> bounds = {begin};
+  const char* cursor = begin;
+  while (static_cast<std::size_t>(end - cursor) > S21MatrixText::kChunkBytes) {
+    cursor += S21MatrixText::kChunkBytes;
+    auto next = static_cast<const char*>(
+        std::memchr(cursor, '\n', static_cast<std::size_t>(end - cursor)));
+    if (!next) break;
+    cursor = next + 1;
+    bounds.push_back(cursor);
+  }
+  if (bounds.back() != end) bounds.push_back(end);
+  return bounds;
+}
+
+/**
+ * @brief Writes rows [begin, end) of the matrix as text into 'out'
+ */
+void FormatRows(const S21Matrix& matrix, int begin, int end, char delimiter,
+                std::string* out) {
+  int cols = matrix.GetCols();
+  out->resize(static_cast<std::size_t>(end - begin) * cols *
+              (kMaxElementChars + 1));
+  char* cursor = &(*out)[0];
+  for (int i = begin; i < end; ++i) {
+    const double* row =
+        matrix.data() + static_cast<std::ptrdiff_t>(i) * matrix.stride();
+    for (int j = 0; j < cols; ++j) {
+      cursor = std::to_chars(cursor, cursor + kMaxElementChars, row[j]).ptr;
+      *cursor++ = j + 1 < cols ? delimiter : '\n';
+    }
+  }
+  out->resize(static_cast<std::size_t>(cursor - out->data()));
+}
+
+/**
+ * @brief Formats the matrix in chunks of about kChunkBytes and passes them
+ * to sink(text) in order
+ * @details kRoundChunks chunks are formatted in parallel at a time, so the
+ * memory does not grow with the size of the matrix
+ */
+template <typename Sink>
+void FormatChunks(const S21Matrix& matrix, char delimiter, const Sink& sink) {
+  CheckDelimiter(delimiter);
+  long row_bytes =
+      static_cast<long>(matrix.GetCols()) * (kMaxElementChars + 1);
+  long rows_per_chunk =
+      std::max(1L, static_cast<long>(S21MatrixText::kChunkBytes) / row_bytes);
+  long chunks = (matrix.GetRows() + rows_per_chunk - 1) / rows_per_chunk;
+
+  std::vector<std::string> buffers(std::min(chunks, kRoundChunks));
+  for (long first = 0; first < chunks; first += kRoundChunks) {
+    long count = std::min(kRoundChunks, chunks - first);
+    S21ThreadPool::Instance().ParallelFor(
+        count, 1, [&](long begin, long end) {
+          for (long c = begin; c < end; ++c) {
+            long row = (first + c) * rows_per_chunk;
+            long row_end =
+                std::min<long>(row + rows_per_chunk, matrix.GetRows());
+            FormatRows(matrix, static_cast<int>(row),
+                       static_cast<int>(row_end), delimiter, &buffers[c]);
+          }
+        });
+    for (long c = 0; c < count; ++c) sink(buffers[c]);
+  }
+}
+
+/**
+ * @brief Maps a file for reading and unmaps it when it goes out of scope
+ */
+class Mapping {
+ public:
+  Mapping(void* base, std::size_t bytes) : base_(base), bytes_(bytes) {}
+  Mapping(const Mapping&) = delete;
+  Mapping& operator=(const Mapping&) = delete;
+  ~Mapping() { munmap(base_, bytes_); }
+  const char* data() const { return static_cast<const char*>(base_); }
+
+ private:
+  void* base_;
+  std::size_t bytes_;
+};
+
+}  // namespace
+
+/**
+ * @brief Reads a matrix from text
+ * @details The text is parsed twice: the first pass counts the rows of
+ * every chunk, then the matrix is allocated and the second pass parses the
+ * chunks straight into their rows. The number of columns is the number of
+ * elements in the first row, the other rows must have as many.
+ * @param text - rows of elements, see S21MatrixText
+ * @param delimiter - separator of the elements, e.g. ',' or '\t'
+ * @param resource - memory resource for the elements
+ * @return The matrix
+ */
+S21Matrix S21MatrixText::Parse(std::string_view text, char delimiter,
+                               std::pmr::memory_resource* resource) {
+  CheckDelimiter(delimiter);
+  const char* begin = text.data();
+  const char* end = begin + text.size();
+
+  const char* first_line = begin;
+  const char* first_end = begin;
+  while (first_line != end) {
+    auto next = static_cast<const char*>(std::memchr(
+        first_line, '\n', static_cast<std::size_t>(end - first_line)));
+    first_end = next ? next : end;
+    if (!IsEmptyLine(first_line, first_end)) break;
+    first_line = next ? next + 1 : end;
+  }
+  if (first_line == end) ThrowTextError("There are no elements");
+  std::vector<double> elements(
+      static_cast<std::size_t>(first_end - first_line));
+  int cols = ParseLine(first_line, first_end, delimiter, elements.data(),
+                       static_cast<int>(elements.size()));
+  if (cols < 0) ThrowTextError("Row 0 has a malformed element");
+
+  std::vector<const char*> bounds = SplitIntoChunks(first_line, end);
+  long chunks = static_cast<long>(bounds.size()) - 1;
+  std::vector<long> first_rows(chunks + 1, 0);
+  S21ThreadPool::Instance().ParallelFor(chunks, 1, [&](long b, long e) {
+    for (long c = b; c < e; ++c) {
+      long rows = 0;
+      ForEachLine(bounds[c], bounds[c + 1],
+                  [&rows](const char* line, const char* line_end) {
+                    rows += !IsEmptyLine(line, line_end);
+                  });
+      first_rows[c + 1] = rows;
+    }
+  });
+  for (long c = 0; c < chunks; ++c) first_rows[c + 1] += first_rows[c];
+  if (first_rows[chunks] > INT_MAX) ThrowTextError("There are too many rows");
+
+  S21Matrix result(static_cast<int>(first_rows[chunks]), cols, resource);
+  S21ThreadPool::Instance().ParallelFor(chunks, 1, [&](long b, long e) {
+    for (long c = b; c < e; ++c) {
+      long row = first_rows[c];
+      ForEachLine(bounds[c], bounds[c + 1],
+                  [&](const char* line, const char* line_end) {
+                    if (IsEmptyLine(line, line_end)) return;
+                    double* elements = result.data() + row * result.stride();
+                    int count =
+                        ParseLine(line, line_end, delimiter, elements, cols);
+                    if (count < 0) {
+                      ThrowTextError("Row " + std::to_string(row) +
+                                     " has a malformed element");
+                    } else if (count != cols) {
+                      ThrowTextError("Row " + std::to_string(row) +
+                                     " has a different number of elements");
+                    }
+                    ++row;
+                  });
+    }
+  });
+  return result;
+}
+
+/**
+ * @brief Writes a matrix as text
+ * @param matrix - the matrix that will be written
+ * @param delimiter - separator of the elements, kWhitespace writes a space
+ * @return Rows of elements, every one followed by '\n'
+ */
+std::string S21MatrixText::Format(const S21Matrix& matrix, char delimiter) {
+  std::string text;
+  FormatChunks(matrix, delimiter,
+               [&text](const std::string& chunk) { text += chunk; });
+  return text;
+}
+
+/**
+ * @brief Reads a matrix from the rest of a stream
+ * @details The stream is read in blocks of kReadBytes and parsed at once
+ * by Parse()
+ */
+S21Matrix S21MatrixText::Read(std::istream& stream, char delimiter,
+                              std::pmr::memory_resource* resource) {
+  std::string text;
+  std::size_t size = 0;
+  while (stream) {
+    text.resize(size + kReadBytes);
+    stream.read(&text[size], static_cast<std::streamsize>(kReadBytes));
+    size += static_cast<std::size_t>(stream.gcount());
+  }
+  text.resize(size);
+  return Parse(text, delimiter, resource);
+}
+
+/**
+ * @brief Writes a matrix as text into a stream
+ * @details The text is written in chunks of about kChunkBytes, errors are
+ * left in the state of the stream
+ */
+void S21MatrixText::Write(const S21Matrix& matrix, std::ostream& stream,
+                          char delimiter) {
+  FormatChunks(matrix, delimiter, [&stream](const std::string& chunk) {
+    stream.write(chunk.data(), static_cast<std::streamsize>(chunk.size()));
+  });
+}
+
+/**
+ * @brief Reads a matrix from a text file
+ * @details Regular files are mapped and parsed in place, other files are
+ * read like a stream
+ * @param path - name of the file
+ */
+S21Matrix S21MatrixText::Load(const std::string& path, char delimiter,
+                              std::pmr::memory_resource* resource) {
+  int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+  if (fd < 0) ThrowFileError("Cannot open the file", path);
+  struct stat info;
+  void* base = MAP_FAILED;
+  if (fstat(fd, &info) == 0 && S_ISREG(info.st_mode) && info.st_size > 0) {
+    base = mmap(nullptr, static_cast<std::size_t>(info.st_size), PROT_READ,
+                MAP_PRIVATE, fd, 0);
+  }
+  close(fd);
+
+  if (base == MAP_FAILED) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) ThrowFileError("Cannot open the file", path);
+    return Read(file, delimiter, resource);
+  }
+  Mapping mapping(base, static_cast<std::size_t>(info.st_size));
+  return Parse(std::string_view(mapping.data(),
+                                static_cast<std::size_t>(info.st_size)),
+               delimiter, resource);
+}
+
+/**
+ * @brief Writes a matrix to a text file
+ * @param path - name of the file, replaced if it exists
+ */
+void S21MatrixText::Save(const S21Matrix& matrix, const std::string& path,
+                         char delimiter) {
+  std::ofstream file(path, std::ios::binary | std::ios::trunc);
+  if (!file) ThrowFileError("Cannot create the file", path);
+  Write(matrix, file, delimiter);
+  file.close();
+  if (!file) ThrowFileError("Cannot write the file", path);
+}
@@ -0,0 +1,67 @@
+/*
+ * Copyright 2023 Gleb Tolstenev
+ * yonnarge@student.21-school.ru
+ *
+ * s21_matrix_text.h is the header file for the text import and export of
+ * s21_matrix_oop library
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef SRC_S21_MATRIX_TEXT_H_
+#define SRC_S21_MATRIX_TEXT_H_
+
+#include <cstddef>
+#include <iosfwd>
+#include <memory_resource>
+#include <string>
+#include <string_view>
+
+#include "s21_matrix_oop.h"
+
+/**
+ * @brief Text format of a matrix: CSV, TSV or whitespace separated numbers
+ * @details Every line is a row and the elements of a row are separated by
+ * the delimiter. Spaces around the elements are ignored, so are empty lines
+ * and a '\r' before the end of a line. With kWhitespace as the delimiter
+ * any run of spaces and tabs separates the elements.
+ *
+ * The numbers are parsed by std::from_chars and written by std::to_chars,
+ * which do not depend on the locale and write the shortest text that reads
+ * back to the same double. Texts of more than kChunkBytes are split into
+ * chunks at line breaks that are parsed or formatted on S21ThreadPool.
+ */
+class S21MatrixText {
+ public:
+  static constexpr char kWhitespace = ' ';
+  /* Size of the pieces of text handled by one task */
+  static constexpr std::size_t kChunkBytes = std::size_t{1} << 20;
+
+  static S21Matrix Parse(std::string_view text, char delimiter = kWhitespace,
+                         std::pmr::memory_resource* resource =
+                             std::pmr::get_default_resource());
+  static std::string Format(const S21Matrix& matrix,
+                            char delimiter = kWhitespace);
+  static S21Matrix Read(std::istream& stream, char delimiter = kWhitespace,
+                        std::pmr::memory_resource* resource =
+                            std::pmr::get_default_resource());
+  static void Write(const S21Matrix& matrix, std::ostream& stream,
+                    char delimiter = kWhitespace);
+  static S21Matrix Load(const std::string& path, char delimiter = kWhitespace,
+                        std::pmr::memory_resource* resource =
+                            std::pmr::get_default_resource());
+  static void Save(const S21Matrix& matrix, const std::string& path,
+                   char delimiter = kWhitespace);
+};
+
+#endif  // SRC_S21_MATRIX_TEXT_H_
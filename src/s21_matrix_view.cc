@@ -0,0 +1,287 @@
+/*
+ * Copyright 2023 Gleb Tolstenev
+ * yonnarge@student.21-school.ru
+ *
+ * s21_matrix_view.cc is the source code file for the non-owning matrix
+ * view of s21_matrix_oop library
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "s21_matrix_view.h"
+
+#include "s21_gemm.h"
+#include "s21_simd.h"
+
+/* Constructors and destructors ---------------------------------------------*/
+
+/**
+ * @brief View of the whole matrix
+ * @param matrix - the matrix that will be viewed
+ */
+S21MatrixView::S21MatrixView(S21Matrix &matrix)
+    : S21MatrixView(matrix.data(), matrix.GetRows(), matrix.GetCols(),
+                    matrix.stride()) {}
+
+/**
+ * @brief View of a block of the matrix
+ * @param matrix - the matrix that will be viewed
+ * @param row, col - indexes of the first element of the block
+ * @param rows, cols - size of the block
+ */
+S21MatrixView::S21MatrixView(S21Matrix &matrix, int row, int col, int rows,
+                             int cols)
+    : S21MatrixView(S21MatrixView(matrix).Block(row, col, rows, cols)) {}
+
+/**
+ * @brief View of external memory
+ * @param data - the first element
+ * @param rows, cols - size of the view
+ * @param row_stride, col_stride - distances in elements between adjacent
+ * rows and adjacent columns
+ */
+S21MatrixView::S21MatrixView(double *data, int rows, int cols,
+                             std::ptrdiff_t row_stride,
+                             std::ptrdiff_t col_stride)
+    : data_(data),
+      rows_(rows),
+      cols_(cols),
+      row_stride_(row_stride),
+      col_stride_(col_stride) {
+  if (rows < 0) {
+    throw std::invalid_argument("The number of rows is lower than 0");
+  } else if (cols < 0) {
+    throw std::invalid_argument("The number of columns is lower than 0");
+  }
+}
+
+/* Overloads ----------------------------------------------------------------*/
+
+/**
+ * @brief Copies the elements of 'other' into the view
+ * @param other - the view of the same size
+ * @return reference to the view
+ */
+S21MatrixView &S21MatrixView::operator=(const S21MatrixView &other) {
+  S21Matrix::CheckSizesFor(ASSIGNMENT, rows_, cols_, other.rows_,
+                           other.cols_);
+  if (data_ == other.data_ && row_stride_ == other.row_stride_ &&
+      col_stride_ == other.col_stride_) {
+    return *this;
+  }
+  if (IsRowContiguous() && other.IsRowContiguous()) {
+    ForEachRow([this, &other](int i) {
+      std::memmove(At(i, 0), other.At(i, 0), cols_ * sizeof(double));
+    });
+  } else {
+    ForEachRow([this, &other](int i) {
+      for (int j = 0; j < cols_; ++j) *At(i, j) = *other.At(i, j);
+    });
+  }
+  return *this;
+}
+
+/**
+ * @brief Copies the elements of a matrix into the view
+ * @param other - the matrix of the same size
+ * @return reference to the view
+ */
+S21MatrixView &S21MatrixView::operator=(const S21Matrix &other) {
+  return *this = S21MatrixView(const_cast<double *>(other.data()),
+                               other.GetRows(), other.GetCols(),
+                               other.stride());
+}
+
+/**
+ * @brief Overload of '*' for views
+ * @details Strided and transposed operands are passed to S21Gemm as they
+ * are, nothing is copied. Views with no columns give a zero product; a
+ * product with no rows or columns is rejected, as a S21Matrix has at least
+ * one element.
+ * @param other - the view with as many rows as this view has columns
+ * @return New matrix with the product
+ */
+S21Matrix S21MatrixView::operator*(const S21MatrixView &other) const {
+  if (cols_ != other.rows_) {
+    throw std::logic_error(
+        "The multiplication of matrices was rejected. Matrices have "
+        "different sizes");
+  }
+  if (rows_ == 0 || other.cols_ == 0) {
+    throw std::logic_error(
+        "The multiplication of matrices was rejected. The product is empty");
+  }
+  S21Matrix result(rows_, other.cols_);
+  if (cols_ == 0) return result;
+  S21Gemm(rows_, other.cols_, cols_, 1.0, data_, row_stride_, col_stride_,
+          other.data_, other.row_stride_, other.col_stride_, 0.0,
+          result.data(), result.stride());
+  return result;
+}
+
+/**
+ * Overload of '()' for indexation by view elements (row, column)
+ * @param row - index of row
+ * @param col - index of column
+ * @return The element of the viewed matrix
+ */
+double &S21MatrixView::operator()(int row, int col) const {
+  if (row < 0 || row >= rows_ || col < 0 || col >= cols_)
+    throw std::out_of_range(
+        "Attempt to access to element of matrix by index outside of the range");
+  return *At(row, col);
+}
+
+bool S21MatrixView::operator==(const S21MatrixView &other) const {
+  return EqMatrix(other);
+}
+
+S21MatrixView &S21MatrixView::operator+=(const S21MatrixView &other) {
+  SumMatrix(other);
+  return *this;
+}
+
+S21MatrixView &S21MatrixView::operator-=(const S21MatrixView &other) {
+  SubMatrix(other);
+  return *this;
+}
+
+S21MatrixView &S21MatrixView::operator*=(const double num) {
+  MulNumber(num);
+  return *this;
+}
+
+S21MatrixView &S21MatrixView::operator*=(const S21MatrixView &other) {
+  MulMatrix(other);
+  return *this;
+}
+
+/* Core methods -------------------------------------------------------------*/
+
+/**
+ * @brief Checks the viewed elements for equality up to EPS
+ * @param other - the view that will be compared
+ */
+bool S21MatrixView::EqMatrix(const S21MatrixView &other) const {
+  if (rows_ != other.rows_ || cols_ != other.cols_) return false;
+  bool contiguous = IsRowContiguous() && other.IsRowContiguous();
+  for (int i = 0; i < rows_; ++i) {
+    if (contiguous) {
+      if (!S21Simd::Equal(At(i, 0), other.At(i, 0), cols_, EPS)) return false;
+    } else {
+      for (int j = 0; j < cols_; ++j) {
+        if (fabs(*At(i, j) - *other.At(i, j)) > EPS) return false;
+      }
+    }
+  }
+  return true;
+}
+
+/**
+ * @brief Adds the elements of 'other' to the viewed elements
+ * @param other - the view of the same size
+ */
+void S21MatrixView::SumMatrix(const S21MatrixView &other) {
+  S21Matrix::CheckSizesFor(SUM, rows_, cols_, other.rows_, other.cols_);
+  if (IsRowContiguous() && other.IsRowContiguous()) {
+    ForEachRow([this, &other](int i) {
+      S21Simd::Add(At(i, 0), other.At(i, 0), cols_);
+    });
+  } else {
+    ForEachRow([this, &other](int i) {
+      for (int j = 0; j < cols_; ++j) *At(i, j) += *other.At(i, j);
+    });
+  }
+}
+
+/**
+ * @brief Subtracts the elements of 'other' from the viewed elements
+ * @param other - the view of the same size
+ */
+void S21MatrixView::SubMatrix(const S21MatrixView &other) {
+  S21Matrix::CheckSizesFor(SUB, rows_, cols_, other.rows_, other.cols_);
+  if (IsRowContiguous() && other.IsRowContiguous()) {
+    ForEachRow([this, &other](int i) {
+      S21Simd::Sub(At(i, 0), other.At(i, 0), cols_);
+    });
+  } else {
+    ForEachRow([this, &other](int i) {
+      for (int j = 0; j < cols_; ++j) *At(i, j) -= *other.At(i, j);
+    });
+  }
+}
+
+/**
+ * @brief Multiplies the viewed elements by a number
+ */
+void S21MatrixView::MulNumber(const double num) {
+  if (IsRowContiguous()) {
+    ForEachRow([this, num](int i) { S21Simd::Scale(At(i, 0), num, cols_); });
+  } else {
+    ForEachRow([this, num](int i) {
+      for (int j = 0; j < cols_; ++j) *At(i, j) *= num;
+    });
+  }
+}
+
+/**
+ * @brief Replaces the viewed elements with their product by 'other'
+ * @details The view cannot change its shape, so 'other' must be a square
+ * view of cols x cols. The product is computed into a temporary matrix, so
+ * 'other' may overlap the view.
+ * @param other - the view that will be multiplied
+ */
+void S21MatrixView::MulMatrix(const S21MatrixView &other) {
+  if (other.rows_ != other.cols_) {
+    throw std::logic_error(
+        "The multiplication of matrices was rejected. Matrices have "
+        "different sizes");
+  }
+  if ((rows_ == 0 || cols_ == 0) && cols_ == other.rows_) return;
+  *this = *this * other;
+}
+
+/**
+ * @brief Transposed view of the same elements, no element is moved
+ */
+S21MatrixView S21MatrixView::Transpose() const {
+  return S21MatrixView(data_, cols_, rows_, col_stride_, row_stride_);
+}
+
+/**
+ * @brief View of a block of the current view
+ * @param row, col - indexes of the first element of the block
+ * @param rows, cols - size of the block
+ */
+S21MatrixView S21MatrixView::Block(int row, int col, int rows,
+                                   int cols) const {
+  if (row < 0 || col < 0 || rows < 0 || cols < 0 || row > rows_ - rows ||
+      col > cols_ - cols)
+    throw std::out_of_range(
+        "Attempt to take a block of matrix outside of the range");
+  return S21MatrixView(At(row, col), rows, cols, row_stride_, col_stride_);
+}
+
+/**
+ * @brief View of the rows [row, row + rows)
+ */
+S21MatrixView S21MatrixView::RowRange(int row, int rows) const {
+  return Block(row, 0, rows, cols_);
+}
+
+/**
+ * @brief View of the columns [col, col + cols)
+ */
+S21MatrixView S21MatrixView::ColRange(int col, int cols) const {
+  return Block(0, col, rows_, cols);
+}
@@ -0,0 +1,127 @@
+/*
+ * Copyright 2023 Gleb Tolstenev
+ * yonnarge@student.21-school.ru
+ *
+ * s21_matrix_view.h is the header file for the non-owning matrix view of
+ * s21_matrix_oop library
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef SRC_S21_MATRIX_VIEW_H_
+#define SRC_S21_MATRIX_VIEW_H_
+
+#include <cstddef>
+
+#include "s21_matrix_oop.h"
+
+/**
+ * @brief Non-owning window into the elements of a matrix
+ * @details A view is a pointer to its first element, a shape and a stride
+ * for rows and for columns, so blocks, row ranges, column ranges and
+ * transposes of a S21Matrix are all views of the same storage. Creating a
+ * view checks the range once and copies nothing; the view must not outlive
+ * the matrix it looks into.
+ *
+ * Copying a view copies the window. Assigning to a view (from another
+ * view, a S21Matrix or an expression) copies elements into the window.
+ * Operands of an operation must not overlap the view, unless they are the
+ * same window.
+ */
+class S21MatrixView : public S21MatrixExpr<S21MatrixView> {
+ private:
+  double* data_;
+  int rows_, cols_;
+  std::ptrdiff_t row_stride_;  // Distance in elements between rows
+  std::ptrdiff_t col_stride_;  // Distance in elements between columns
+
+ private:
+  /* Help methods --------------------------------------------------------*/
+  double* At(int row, int col) const {
+    return data_ + row * row_stride_ + col * col_stride_;
+  }
+  bool IsRowContiguous() const { return col_stride_ == 1; }
+  template <typename Body>
+  void ForEachRow(const Body& body) const;
+
+ public:
+  /* Constructors and destructors ----------------------------------------*/
+  explicit S21MatrixView(S21Matrix& matrix);
+  S21MatrixView(S21Matrix& matrix, int row, int col, int rows, int cols);
+  S21MatrixView(double* data, int rows, int cols, std::ptrdiff_t row_stride,
+                std::ptrdiff_t col_stride = 1);
+  S21MatrixView(const S21MatrixView& other) = default;
+
+  /* Overloads -----------------------------------------------------------*/
+  S21MatrixView& operator=(const S21MatrixView& other);
+  S21MatrixView& operator=(const S21Matrix& other);
+  template <typename E>
+  S21MatrixView& operator=(const S21MatrixExpr<E>& expr);
+  S21Matrix operator*(const S21MatrixView& other) const;
+  double& operator()(int row, int col) const;
+  bool operator==(const S21MatrixView& other) const;
+  S21MatrixView& operator+=(const S21MatrixView& other);
+  S21MatrixView& operator-=(const S21MatrixView& other);
+  S21MatrixView& operator*=(const double num);
+  S21MatrixView& operator*=(const S21MatrixView& other);
+
+  /* Core methods --------------------------------------------------------*/
+  bool EqMatrix(const S21MatrixView& other) const;
+  void SumMatrix(const S21MatrixView& other);
+  void SubMatrix(const S21MatrixView& other);
+  void MulNumber(const double num);
+  void MulMatrix(const S21MatrixView& other);
+  S21MatrixView Transpose() const;
+  S21MatrixView Block(int row, int col, int rows, int cols) const;
+  S21MatrixView RowRange(int row, int rows) const;
+  S21MatrixView ColRange(int col, int cols) const;
+
+  /* Accessors and mutators ---------------------------------------------*/
+  int GetRows() const { return rows_; }
+  int GetCols() const { return cols_; }
+  double GetVal(int row, int col) const { return *At(row, col); }
+  double* data() const { return data_; }
+  std::ptrdiff_t row_stride() const { return row_stride_; }
+  std::ptrdiff_t col_stride() const { return col_stride_; }
+};
+
+/**
+ * @brief Calls body(row) for every row, large views on S21ThreadPool
+ */
+template <typename Body>
+void S21MatrixView::ForEachRow(const Body& body) const {
+  S21Matrix::ForEachRow(rows_, cols_, [&body](int begin, int end) {
+    for (int i = begin; i < end; ++i) body(i);
+  });
+}
+
+/**
+ * @brief Evaluates an expression into the elements of the view
+ * @param expr - the expression of the same size as the view
+ * @return reference to the view
+ */
+template <typename E>
+S21MatrixView& S21MatrixView::operator=(const S21MatrixExpr<E>& expr) {
+  const E& self = expr.Self();
+  S21Matrix::CheckSizesFor(ASSIGNMENT, rows_, cols_, self.GetRows(),
+                           self.GetCols());
+  ForEachRow([this, &self](int i) {
+    double* row = At(i, 0);
+    for (int j = 0; j < cols_; ++j) {
+      row[j * col_stride_] = self.GetVal(i, j);
+    }
+  });
+  return *this;
+}
+
+#endif  // SRC_S21_MATRIX_VIEW_H_
@@ -0,0 +1,148 @@
+/*
+ * Copyright 2023 Gleb Tolstenev
+ * yonnarge@student.21-school.ru
+ *
+ * s21_pool_resource.cc is the source code file for the pooled memory
+ * resource of s21_matrix_oop library
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "s21_pool_resource.h"
+
+namespace {
+
+constexpr int kNumClasses = 7;  // 64, 128, ..., 4096 bytes
+
+/**
+ * @brief Freed block, the link is stored inside the block itself
+ */
+struct FreeBlock {
+  FreeBlock* next;
+};
+
+/**
+ * @brief Free lists of one thread
+ */
+struct ThreadCache {
+  FreeBlock* heads[kNumClasses] = {};
+  std::size_t counts[kNumClasses] = {};
+
+  ~ThreadCache();
+};
+
+/* Set when the cache of the current thread has been destroyed */
+thread_local bool cache_destroyed = false;
+
+/**
+ * @brief Returns the size class index for a request of 'bytes'
+ */
+int ClassOf(std::size_t bytes) {
+  int index = 0;
+  std::size_t size = S21PoolResource::kMinPooledBytes;
+  while (size < bytes) {
+    size <<= 1;
+    ++index;
+  }
+  return index;
+}
+
+std::size_t ClassSize(int index) {
+  return S21PoolResource::kMinPooledBytes << index;
+}
+
+std::pmr::memory_resource* Upstream() {
+  return std::pmr::new_delete_resource();
+}
+
+ThreadCache::~ThreadCache() {
+  cache_destroyed = true;
+  for (int i = 0; i < kNumClasses; ++i) {
+    while (heads[i]) {
+      FreeBlock* block = heads[i];
+      heads[i] = block->next;
+      Upstream()->deallocate(block, ClassSize(i),
+                             S21PoolResource::kMinPooledBytes);
+    }
+  }
+}
+
+/**
+ * @brief Returns the cache of the calling thread, nullptr during its exit
+ */
+ThreadCache* Cache() {
+  if (cache_destroyed) return nullptr;
+  thread_local ThreadCache cache;
+  return &cache;
+}
+
+bool IsPooled(std::size_t bytes, std::size_t alignment) {
+  return bytes <= S21PoolResource::kMaxPooledBytes &&
+         alignment <= S21PoolResource::kMinPooledBytes;
+}
+
+}  // namespace
+
+/**
+ * @brief Returns the pool shared by the library
+ */
+S21PoolResource* S21PoolResource::Instance() {
+  static S21PoolResource pool;
+  return &pool;
+}
+
+/**
+ * @brief Takes a block from the free list of the size class or from the
+ * upstream resource
+ */
+void* S21PoolResource::do_allocate(std::size_t bytes, std::size_t alignment) {
+  if (!IsPooled(bytes, alignment)) {
+    return Upstream()->allocate(bytes, alignment);
+  }
+  int index = ClassOf(bytes);
+  ThreadCache* cache = Cache();
+  if (FreeBlock* block = cache ? cache->heads[index] : nullptr) {
+    cache->heads[index] = block->next;
+    --cache->counts[index];
+    return block;
+  }
+  return Upstream()->allocate(ClassSize(index), kMinPooledBytes);
+}
+
+/**
+ * @brief Puts a block into the free list of the calling thread
+ * @details Blocks beyond kMaxCachedBlocks per class, and blocks freed while
+ * the thread is shutting down, go back to the upstream resource
+ */
+void S21PoolResource::do_deallocate(void* ptr, std::size_t bytes,
+                                    std::size_t alignment) {
+  if (!IsPooled(bytes, alignment)) {
+    Upstream()->deallocate(ptr, bytes, alignment);
+    return;
+  }
+  int index = ClassOf(bytes);
+  ThreadCache* cache = Cache();
+  if (!cache || cache->counts[index] >= kMaxCachedBlocks) {
+    Upstream()->deallocate(ptr, ClassSize(index), kMinPooledBytes);
+    return;
+  }
+  FreeBlock* block = static_cast<FreeBlock*>(ptr);
+  block->next = cache->heads[index];
+  cache->heads[index] = block;
+  ++cache->counts[index];
+}
+
+bool S21PoolResource::do_is_equal(
+    const std::pmr::memory_resource& other) const noexcept {
+  return this == &other;
+}
@@ -0,0 +1,59 @@
+/*
+ * Copyright 2023 Gleb Tolstenev
+ * yonnarge@student.21-school.ru
+ *
+ * s21_pool_resource.h is the header file for the pooled memory resource of
+ * s21_matrix_oop library
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef SRC_S21_POOL_RESOURCE_H_
+#define SRC_S21_POOL_RESOURCE_H_
+
+#include <cstddef>
+#include <memory_resource>
+
+/**
+ * @brief Memory resource with thread-local caches of small blocks
+ * @details Requests up to kMaxPooledBytes are rounded up to a power of two
+ * size class starting at kMinPooledBytes. Freed blocks are kept in a free
+ * list of the calling thread and handed out again without locking, so
+ * creating and destroying many small matrices never reaches the global
+ * allocator once the caches are warm. Every thread keeps at most
+ * kMaxCachedBlocks blocks per size class and returns its cache when it
+ * exits. Larger or over-aligned requests go straight to the upstream
+ * resource.
+ *
+ * Use it for single matrices with S21Matrix(rows, cols, resource) or for
+ * all of them with std::pmr::set_default_resource().
+ */
+class S21PoolResource : public std::pmr::memory_resource {
+ public:
+  static constexpr std::size_t kMinPooledBytes = 64;
+  static constexpr std::size_t kMaxPooledBytes = 4096;
+  static constexpr std::size_t kMaxCachedBlocks = 1024;
+
+  static S21PoolResource* Instance();
+
+ private:
+  S21PoolResource() = default;
+
+  void* do_allocate(std::size_t bytes, std::size_t alignment) override;
+  void do_deallocate(void* ptr, std::size_t bytes,
+                     std::size_t alignment) override;
+  bool do_is_equal(
+      const std::pmr::memory_resource& other) const noexcept override;
+};
+
+#endif  // SRC_S21_POOL_RESOURCE_H_
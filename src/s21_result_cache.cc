@@ -0,0 +1,136 @@
+/*
+ * Copyright 2023 Gleb Tolstenev
+ * yonnarge@student.21-school.ru
+ *
+ * s21_result_cache.cc is the source code file for the result cache of
+ * s21_matrix_oop library
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "s21_result_cache.h"
+
+namespace {
+
+/* Operations that are cached */
+enum cached_operations {
+  CACHED_MUL_MATRIX = 1,
+  CACHED_TRANSPOSE = 2,
+  CACHED_INVERSE_MATRIX = 3
+};
+
+}  // namespace
+
+/**
+ * @brief Creates an empty cache
+ * @param max_bytes - limit on the elements of the kept results, in bytes
+ */
+S21ResultCache::S21ResultCache(std::size_t max_bytes) : max_bytes_(max_bytes) {}
+
+/**
+ * @brief Returns lhs * rhs, computed once for the same operands
+ * @details Throws like the multiplication of the matrices
+ */
+std::shared_ptr<const S21Matrix> S21ResultCache::MulMatrix(
+    const S21Matrix& lhs, const S21Matrix& rhs) {
+  return Find({CACHED_MUL_MATRIX, lhs.Fingerprint(), rhs.Fingerprint()},
+              [&lhs, &rhs] { return lhs * rhs; });
+}
+
+/**
+ * @brief Returns the transpose of the matrix, computed once for the same
+ * elements
+ */
+std::shared_ptr<const S21Matrix> S21ResultCache::Transpose(
+    const S21Matrix& matrix) {
+  return Find({CACHED_TRANSPOSE, matrix.Fingerprint(), 0},
+              [&matrix] { return matrix.Transpose(); });
+}
+
+/**
+ * @brief Returns the inverse of the matrix, computed once for the same
+ * elements
+ * @details Throws like S21Matrix::InverseMatrix(), a failure is not kept
+ */
+std::shared_ptr<const S21Matrix> S21ResultCache::InverseMatrix(
+    const S21Matrix& matrix) {
+  return Find({CACHED_INVERSE_MATRIX, matrix.Fingerprint(), 0},
+              [&matrix] { return matrix.InverseMatrix(); });
+}
+
+/**
+ * @brief Returns a copy of the counters
+ */
+S21ResultCacheStats S21ResultCache::GetStats() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return {hits_, misses_, evictions_, index_.size(), bytes_};
+}
+
+/**
+ * @brief Drops all kept results, the counters of hits and misses stay
+ */
+void S21ResultCache::Clear() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  entries_.clear();
+  index_.clear();
+  bytes_ = 0;
+}
+
+/**
+ * @brief Looks up a result and computes and keeps it when it is missing
+ * @param key - operation and fingerprints of the operands
+ * @param compute - returns the result as an S21Matrix
+ */
+template <typename Compute>
+std::shared_ptr<const S21Matrix> S21ResultCache::Find(const Key& key,
+                                                      const Compute& compute) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto found = index_.find(key);
+    if (found != index_.end()) {
+      ++hits_;
+      entries_.splice(entries_.begin(), entries_, found->second);
+      return found->second->result;
+    }
+    ++misses_;
+  }
+  auto result = std::make_shared<const S21Matrix>(compute());
+  std::size_t bytes = static_cast<std::size_t>(result->GetRows()) *
+                      result->GetCols() * sizeof(double);
+  if (bytes > max_bytes_) return result;
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto found = index_.find(key);
+  if (found != index_.end()) {  // Computed by another thread meanwhile
+    entries_.splice(entries_.begin(), entries_, found->second);
+    return found->second->result;
+  }
+  EvictFor(bytes);
+  entries_.push_front({key, result, bytes});
+  index_.emplace(key, entries_.begin());
+  bytes_ += bytes;
+  return result;
+}
+
+/**
+ * @brief Drops the least recently used results until 'bytes' more fit,
+ * mutex_ must be held
+ */
+void S21ResultCache::EvictFor(std::size_t bytes) {
+  while (!entries_.empty() && bytes_ + bytes > max_bytes_) {
+    const Entry& last = entries_.back();
+    bytes_ -= last.bytes;
+    index_.erase(last.key);
+    entries_.pop_back();
+    ++evictions_;
+  }
+}
@@ -0,0 +1,121 @@
+/*
+ * Copyright 2023 Gleb Tolstenev
+ * yonnarge@student.21-school.ru
+ *
+ * s21_result_cache.h is the header file for the result cache of
+ * s21_matrix_oop library
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef SRC_S21_RESULT_CACHE_H_
+#define SRC_S21_RESULT_CACHE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+#include "s21_matrix_oop.h"
+
+/**
+ * @brief Counters of S21ResultCache
+ */
+struct S21ResultCacheStats {
+  std::uint64_t hits;
+  std::uint64_t misses;
+  std::uint64_t evictions;
+  std::size_t entries;
+  std::size_t bytes;  // Elements of the cached results, in bytes
+};
+
+/**
+ * @brief Least recently used cache of the results of expensive operations
+ * @details Results are found by the operation and the fingerprints of the
+ * operands (see S21Matrix::Fingerprint()), so asking again for the product,
+ * transpose or inverse of matrices with the same elements returns the
+ * stored result instead of computing it. Fingerprinting an operand reads
+ * it once, later lookups of the unchanged operand take no pass over it.
+ *
+ * The fingerprint of an operand is not updated by writes through element
+ * references, pointers or views taken before it was computed; after such
+ * writes the cache may return the result for the old elements. Take the
+ * reference, pointer or view again (or copy the matrix) before the next
+ * lookup.
+ *
+ * The elements of the results are kept up to max_bytes in total; the least
+ * recently used results are dropped to make room for new ones, and results
+ * larger than max_bytes are returned without being kept. The results are
+ * shared and immutable, so they stay valid after they are dropped or the
+ * cache is cleared.
+ *
+ * All methods may be called from several threads at once. Results are
+ * computed outside of the lock; two threads that miss the same result at
+ * once both compute it.
+ */
+class S21ResultCache {
+ public:
+  static constexpr std::size_t kDefaultMaxBytes = std::size_t{256} << 20;
+
+  explicit S21ResultCache(std::size_t max_bytes = kDefaultMaxBytes);
+  S21ResultCache(const S21ResultCache&) = delete;
+  S21ResultCache& operator=(const S21ResultCache&) = delete;
+
+  std::shared_ptr<const S21Matrix> MulMatrix(const S21Matrix& lhs,
+                                             const S21Matrix& rhs);
+  std::shared_ptr<const S21Matrix> Transpose(const S21Matrix& matrix);
+  std::shared_ptr<const S21Matrix> InverseMatrix(const S21Matrix& matrix);
+
+  S21ResultCacheStats GetStats() const;
+  std::size_t GetMaxBytes() const { return max_bytes_; }
+  void Clear();
+
+ private:
+  struct Key {
+    int operation;
+    std::uint64_t lhs, rhs;  // Fingerprints of the operands, rhs 0 if unary
+
+    bool operator==(const Key& other) const {
+      return operation == other.operation && lhs == other.lhs &&
+             rhs == other.rhs;
+    }
+  };
+
+  struct KeyHash {
+    std::size_t operator()(const Key& key) const {
+      return key.lhs ^ (key.rhs * 31 + key.operation);
+    }
+  };
+
+  struct Entry {
+    Key key;
+    std::shared_ptr<const S21Matrix> result;
+    std::size_t bytes;
+  };
+
+  template <typename Compute>
+  std::shared_ptr<const S21Matrix> Find(const Key& key,
+                                        const Compute& compute);
+  void EvictFor(std::size_t bytes);
+
+  const std::size_t max_bytes_;
+  mutable std::mutex mutex_;
+  std::list<Entry> entries_;  // Most recently used first
+  std::unordered_map<Key, std::list<Entry>::iterator, KeyHash> index_;
+  std::size_t bytes_ = 0;
+  std::uint64_t hits_ = 0, misses_ = 0, evictions_ = 0;
+};
+
+#endif  // SRC_S21_RESULT_CACHE_H_
@@ -0,0 +1,720 @@
+/*
+ * Copyright 2023 Gleb Tolstenev
+ * yonnarge@student.21-school.ru
+ *
+ * s21_simd.cc is the source code file for the vectorized element-wise
+ * kernels of s21_matrix_oop library
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "s21_simd.h"
+
+#include <math.h>
+
+#include <atomic>
+#include <stdexcept>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define S21_SIMD_X86 1
+#endif
+
+namespace {
+
+/* Elements compared between two checks for an early exit in Equal() */
+constexpr std::size_t kEqualBlock = 64;
+
+/* Independent partial sums of Dot(), enough to fill the registers of the
+ * widest level and hide the latency of the additions */
+constexpr std::size_t kDotLanes = 32;
+
+/**
+ * @brief Table of the kernels compiled for one instruction set level
+ */
+struct Kernels {
+  void (*add)(double*, const double*, std::size_t);
+  void (*sub)(double*, const double*, std::size_t);
+  void (*scale)(double*, double, std::size_t);
+  bool (*equal)(const double*, const double*, std::size_t, double);
+  void (*transpose)(const double*, std::ptrdiff_t, double*, std::ptrdiff_t,
+                    int, int);
+  void (*axpy)(double*, double, const double*, std::size_t);
+  double (*dot)(const double*, const double*, std::size_t);
+  void (*add_float)(float*, const float*, std::size_t);
+  void (*sub_float)(float*, const float*, std::size_t);
+  void (*scale_float)(float*, float, std::size_t);
+  bool (*equal_float)(const float*, const float*, std::size_t, float);
+};
+
+/* Portable kernels --------------------------------------------------------*/
+
+void AddScalar(double* dst, const double* src, std::size_t count) {
+  for (std::size_t i = 0; i < count; ++i) dst[i] += src[i];
+}
+
+void SubScalar(double* dst, const double* src, std::size_t count) {
+  for (std::size_t i = 0; i < count; ++i) dst[i] -= src[i];
+}
+
+void ScaleScalar(double* dst, double num, std::size_t count) {
+  for (std::size_t i = 0; i < count; ++i) dst[i] *= num;
+}
+
+bool EqualScalar(const double* lhs, const double* rhs, std::size_t count,
+                 double eps) {
+  for (std::size_t i = 0; i < count; ++i) {
+    if (fabs(lhs[i] - rhs[i]) > eps) return false;
+  }
+  return true;
+}
+
+void TransposeScalar(const double* src, std::ptrdiff_t src_rs, double* dst,
+                     std::ptrdiff_t dst_rs, int rows, int cols) {
+  for (int j = 0; j < cols; ++j) {
+    for (int i = 0; i < rows; ++i) {
+      dst[j * dst_rs + i] = src[i * src_rs + j];
+    }
+  }
+}
+
+/**
+ * @brief Transposes the block tile by tile with 'tile' (a kernel for full
+ * Size x Size tiles) and finishes the edges with the scalar kernel
+ */
+template <int Size, typename Tile>
+void TransposeTiles(const double* src, std::ptrdiff_t src_rs, double* dst,
+                    std::ptrdiff_t dst_rs, int rows, int cols, Tile tile) {
+  int full_rows = rows - rows % Size;
+  int full_cols = cols - cols % Size;
+  for (int i = 0; i < full_rows; i += Size) {
+    for (int j = 0; j < full_cols; j += Size) {
+      tile(src + i * src_rs + j, src_rs, dst + j * dst_rs + i, dst_rs);
+    }
+  }
+  TransposeScalar(src + full_cols, src_rs, dst + full_cols * dst_rs, dst_rs,
+                  full_rows, cols - full_cols);
+  TransposeScalar(src + full_rows * src_rs, src_rs, dst + full_rows, dst_rs,
+                  rows - full_rows, cols);
+}
+
+#ifdef S21_SIMD_X86
+
+/* SSE2 kernels ------------------------------------------------------------*/
+
+__attribute__((target("sse2"))) void AddSse2(double* dst, const double* src,
+                                             std::size_t count) {
+  std::size_t i = 0;
+  for (; i + 2 <= count; i += 2) {
+    _mm_storeu_pd(dst + i,
+                  _mm_add_pd(_mm_loadu_pd(dst + i), _mm_loadu_pd(src + i)));
+  }
+  AddScalar(dst + i, src + i, count - i);
+}
+
+__attribute__((target("sse2"))) void SubSse2(double* dst, const double* src,
+                                             std::size_t count) {
+  std::size_t i = 0;
+  for (; i + 2 <= count; i += 2) {
+    _mm_storeu_pd(dst + i,
+                  _mm_sub_pd(_mm_loadu_pd(dst + i), _mm_loadu_pd(src + i)));
+  }
+  SubScalar(dst + i, src + i, count - i);
+}
+
+__attribute__((target("sse2"))) void ScaleSse2(double* dst, double num,
+                                               std::size_t count) {
+  __m128d factor = _mm_set1_pd(num);
+  std::size_t i = 0;
+  for (; i + 2 <= count; i += 2) {
+    _mm_storeu_pd(dst + i, _mm_mul_pd(_mm_loadu_pd(dst + i), factor));
+  }
+  ScaleScalar(dst + i, num, count - i);
+}
+
+__attribute__((target("sse2"))) bool EqualSse2(const double* lhs,
+                                               const double* rhs,
+                                               std::size_t count, double eps) {
+  const __m128d abs_mask = _mm_castsi128_pd(_mm_set1_epi64x(~(1LL << 63)));
+  const __m128d limit = _mm_set1_pd(eps);
+  std::size_t i = 0;
+  while (i + kEqualBlock <= count) {
+    __m128d differ = _mm_setzero_pd();
+    for (std::size_t end = i + kEqualBlock; i < end; i += 2) {
+      __m128d diff = _mm_sub_pd(_mm_loadu_pd(lhs + i), _mm_loadu_pd(rhs + i));
+      differ =
+          _mm_or_pd(differ, _mm_cmpgt_pd(_mm_and_pd(diff, abs_mask), limit));
+    }
+    if (_mm_movemask_pd(differ)) return false;
+  }
+  return EqualScalar(lhs + i, rhs + i, count - i, eps);
+}
+
+__attribute__((target("sse2"))) void TransposeSse2(const double* src,
+                                                   std::ptrdiff_t src_rs,
+                                                   double* dst,
+                                                   std::ptrdiff_t dst_rs,
+                                                   int rows, int cols) {
+  auto tile = [](const double* s, std::ptrdiff_t s_rs, double* d,
+                 std::ptrdiff_t d_rs) __attribute__((target("sse2"))) {
+    __m128d r0 = _mm_loadu_pd(s);
+    __m128d r1 = _mm_loadu_pd(s + s_rs);
+    _mm_storeu_pd(d, _mm_unpacklo_pd(r0, r1));
+    _mm_storeu_pd(d + d_rs, _mm_unpackhi_pd(r0, r1));
+  };
+  TransposeTiles<2>(src, src_rs, dst, dst_rs, rows, cols, tile);
+}
+
+/* AVX2 kernels ------------------------------------------------------------*/
+
+__attribute__((target("avx2"))) void AddAvx2(double* dst, const double* src,
+                                             std::size_t count) {
+  std::size_t i = 0;
+  for (; i + 4 <= count; i += 4) {
+    _mm256_storeu_pd(dst + i, _mm256_add_pd(_mm256_loadu_pd(dst + i),
+                                            _mm256_loadu_pd(src + i)));
+  }
+  AddScalar(dst + i, src + i, count - i);
+}
+
+__attribute__((target("avx2"))) void SubAvx2(double* dst, const double* src,
+                                             std::size_t count) {
+  std::size_t i = 0;
+  for (; i + 4 <= count; i += 4) {
+    _mm256_storeu_pd(dst + i, _mm256_sub_pd(_mm256_loadu_pd(dst + i),
+                                            _mm256_loadu_pd(src + i)));
+  }
+  SubScalar(dst + i, src + i, count - i);
+}
+
+__attribute__((target("avx2"))) void ScaleAvx2(double* dst, double num,
+                                               std::size_t count) {
+  __m256d factor = _mm256_set1_pd(num);
+  std::size_t i = 0;
+  for (; i + 4 <= count; i += 4) {
+    _mm256_storeu_pd(dst + i, _mm256_mul_pd(_mm256_loadu_pd(dst + i), factor));
+  }
+  ScaleScalar(dst + i, num, count - i);
+}
+
+__attribute__((target("avx2"))) bool EqualAvx2(const double* lhs,
+                                               const double* rhs,
+                                               std::size_t count, double eps) {
+  const __m256d abs_mask =
+      _mm256_castsi256_pd(_mm256_set1_epi64x(~(1LL << 63)));
+  const __m256d limit = _mm256_set1_pd(eps);
+  std::size_t i = 0;
+  while (i + kEqualBlock <= count) {
+    __m256d differ = _mm256_setzero_pd();
+    for (std::size_t end = i + kEqualBlock; i < end; i += 4) {
+      __m256d diff =
+          _mm256_sub_pd(_mm256_loadu_pd(lhs + i), _mm256_loadu_pd(rhs + i));
+      differ = _mm256_or_pd(
+          differ,
+          _mm256_cmp_pd(_mm256_and_pd(diff, abs_mask), limit, _CMP_GT_OQ));
+    }
+    if (_mm256_movemask_pd(differ)) return false;
+  }
+  return EqualScalar(lhs + i, rhs + i, count - i, eps);
+}
+
+__attribute__((target("avx2"))) void TransposeAvx2(const double* src,
+                                                   std::ptrdiff_t src_rs,
+                                                   double* dst,
+                                                   std::ptrdiff_t dst_rs,
+                                                   int rows, int cols) {
+  auto tile = [](const double* s, std::ptrdiff_t s_rs, double* d,
+                 std::ptrdiff_t d_rs) __attribute__((target("avx2"))) {
+    __m256d t0 = _mm256_loadu_pd(s);
+    __m256d t1 = _mm256_loadu_pd(s + s_rs);
+    __m256d t2 = _mm256_loadu_pd(s + 2 * s_rs);
+    __m256d t3 = _mm256_loadu_pd(s + 3 * s_rs);
+    __m256d u0 = _mm256_unpacklo_pd(t0, t1);
+    __m256d u1 = _mm256_unpackhi_pd(t0, t1);
+    __m256d u2 = _mm256_unpacklo_pd(t2, t3);
+    __m256d u3 = _mm256_unpackhi_pd(t2, t3);
+    _mm256_storeu_pd(d, _mm256_permute2f128_pd(u0, u2, 0x20));
+    _mm256_storeu_pd(d + d_rs, _mm256_permute2f128_pd(u1, u3, 0x20));
+    _mm256_storeu_pd(d + 2 * d_rs, _mm256_permute2f128_pd(u0, u2, 0x31));
+    _mm256_storeu_pd(d + 3 * d_rs, _mm256_permute2f128_pd(u1, u3, 0x31));
+  };
+  TransposeTiles<4>(src, src_rs, dst, dst_rs, rows, cols, tile);
+}
+
+/* AVX-512 kernels ---------------------------------------------------------*/
+
+__attribute__((target("avx512f"))) void AddAvx512(double* dst,
+                                                  const double* src,
+                                                  std::size_t count) {
+  std::size_t i = 0;
+  for (; i + 8 <= count; i += 8) {
+    _mm512_storeu_pd(dst + i, _mm512_add_pd(_mm512_loadu_pd(dst + i),
+                                            _mm512_loadu_pd(src + i)));
+  }
+  if (i < count) {
+    __mmask8 tail = static_cast<__mmask8>((1u << (count - i)) - 1);
+    _mm512_mask_storeu_pd(
+        dst + i, tail,
+        _mm512_add_pd(_mm512_maskz_loadu_pd(tail, dst + i),
+                      _mm512_maskz_loadu_pd(tail, src + i)));
+  }
+}
+
+__attribute__((target("avx512f"))) void SubAvx512(double* dst,
+                                                  const double* src,
+                                                  std::size_t count) {
+  std::size_t i = 0;
+  for (; i + 8 <= count; i += 8) {
+    _mm512_storeu_pd(dst + i, _mm512_sub_pd(_mm512_loadu_pd(dst + i),
+                                            _mm512_loadu_pd(src + i)));
+  }
+  if (i < count) {
+    __mmask8 tail = static_cast<__mmask8>((1u << (count - i)) - 1);
+    _mm512_mask_storeu_pd(
+        dst + i, tail,
+        _mm512_sub_pd(_mm512_maskz_loadu_pd(tail, dst + i),
+                      _mm512_maskz_loadu_pd(tail, src + i)));
+  }
+}
+
+__attribute__((target("avx512f"))) void ScaleAvx512(double* dst, double num,
+                                                    std::size_t count) {
+  __m512d factor = _mm512_set1_pd(num);
+  std::size_t i = 0;
+  for (; i + 8 <= count; i += 8) {
+    _mm512_storeu_pd(dst + i, _mm512_mul_pd(_mm512_loadu_pd(dst + i), factor));
+  }
+  if (i < count) {
+    __mmask8 tail = static_cast<__mmask8>((1u << (count - i)) - 1);
+    _mm512_mask_storeu_pd(
+        dst + i, tail,
+        _mm512_mul_pd(_mm512_maskz_loadu_pd(tail, dst + i), factor));
+  }
+}
+
+__attribute__((target("avx512f"))) bool EqualAvx512(const double* lhs,
+                                                    const double* rhs,
+                                                    std::size_t count,
+                                                    double eps) {
+  const __m512d limit = _mm512_set1_pd(eps);
+  std::size_t i = 0;
+  while (i + kEqualBlock <= count) {
+    __mmask8 differ = 0;
+    for (std::size_t end = i + kEqualBlock; i < end; i += 8) {
+      __m512d diff =
+          _mm512_sub_pd(_mm512_loadu_pd(lhs + i), _mm512_loadu_pd(rhs + i));
+      differ |= _mm512_cmp_pd_mask(_mm512_abs_pd(diff), limit, _CMP_GT_OQ);
+    }
+    if (differ) return false;
+  }
+  return EqualScalar(lhs + i, rhs + i, count - i, eps);
+}
+
+__attribute__((target("avx512f"))) void TransposeAvx512(
+    const double* src, std::ptrdiff_t src_rs, double* dst,
+    std::ptrdiff_t dst_rs, int rows, int cols) {
+  auto tile = [](const double* s, std::ptrdiff_t s_rs, double* d,
+                 std::ptrdiff_t d_rs) __attribute__((target("avx512f"))) {
+    // The maskz forms avoid a false -Wuninitialized of GCC 12 in the
+    // unmasked intrinsics, a full mask compiles to the same instruction
+    const __mmask8 all = 0xFF;
+    __m512d t[8], u[8];
+    for (int i = 0; i < 8; i += 2) {
+      __m512d r0 = _mm512_loadu_pd(s + i * s_rs);
+      __m512d r1 = _mm512_loadu_pd(s + (i + 1) * s_rs);
+      t[i] = _mm512_maskz_unpacklo_pd(all, r0, r1);  // Even columns
+      t[i + 1] = _mm512_maskz_unpackhi_pd(all, r0, r1);  // Odd columns
+    }
+    for (int i = 0; i < 8; i += 4) {
+      u[i] = _mm512_maskz_shuffle_f64x2(all, t[i], t[i + 2], 0x88);  // 0, 4
+      u[i + 1] = _mm512_maskz_shuffle_f64x2(all, t[i], t[i + 2], 0xDD);  // 2, 6
+      u[i + 2] = _mm512_maskz_shuffle_f64x2(all, t[i + 1], t[i + 3], 0x88);
+      u[i + 3] = _mm512_maskz_shuffle_f64x2(all, t[i + 1], t[i + 3], 0xDD);
+    }
+    static constexpr int kColumn[4] = {0, 2, 1, 3};
+    for (int i = 0; i < 4; ++i) {
+      _mm512_storeu_pd(d + kColumn[i] * d_rs,
+                       _mm512_maskz_shuffle_f64x2(all, u[i], u[i + 4], 0x88));
+      _mm512_storeu_pd(d + (kColumn[i] + 4) * d_rs,
+                       _mm512_maskz_shuffle_f64x2(all, u[i], u[i + 4], 0xDD));
+    }
+  };
+  TransposeTiles<8>(src, src_rs, dst, dst_rs, rows, cols, tile);
+}
+
+#endif  // S21_SIMD_X86
+
+/* Axpy and dot kernels ----------------------------------------------------*/
+
+/* Like the float kernels below, the loops are written once and vectorized
+ * by the compiler for every level. The partial sums of Dot() are what lets
+ * it vectorize without reordering the additions of the source. */
+
+inline __attribute__((always_inline)) void AxpyLoop(double* dst, double num,
+                                                     const double* src,
+                                                     std::size_t count) {
+  for (std::size_t i = 0; i < count; ++i) dst[i] += num * src[i];
+}
+
+inline __attribute__((always_inline)) double DotLoop(const double* lhs,
+                                                      const double* rhs,
+                                                      std::size_t count) {
+  if (count < kDotLanes) {
+    double sum = 0.0;
+    for (std::size_t i = 0; i < count; ++i) sum += lhs[i] * rhs[i];
+    return sum;
+  }
+  double sums[kDotLanes] = {};
+  std::size_t i = 0;
+  for (; i + kDotLanes <= count; i += kDotLanes) {
+    for (std::size_t k = 0; k < kDotLanes; ++k) {
+      sums[k] += lhs[i + k] * rhs[i + k];
+    }
+  }
+  for (std::size_t k = 0; i < count; ++i, ++k) sums[k] += lhs[i] * rhs[i];
+  for (std::size_t width = kDotLanes / 2; width > 0; width /= 2) {
+    for (std::size_t k = 0; k < width; ++k) sums[k] += sums[k + width];
+  }
+  return sums[0];
+}
+
+void AxpyScalar(double* dst, double num, const double* src,
+                std::size_t count) {
+  AxpyLoop(dst, num, src, count);
+}
+
+double DotScalar(const double* lhs, const double* rhs, std::size_t count) {
+  return DotLoop(lhs, rhs, count);
+}
+
+#ifdef S21_SIMD_X86
+
+__attribute__((target("avx2,fma"))) void AxpyAvx2(double* dst, double num,
+                                                  const double* src,
+                                                  std::size_t count) {
+  AxpyLoop(dst, num, src, count);
+}
+
+__attribute__((target("avx2,fma"))) double DotAvx2(const double* lhs,
+                                                   const double* rhs,
+                                                   std::size_t count) {
+  return DotLoop(lhs, rhs, count);
+}
+
+__attribute__((target("avx512f"))) void AxpyAvx512(double* dst, double num,
+                                                   const double* src,
+                                                   std::size_t count) {
+  AxpyLoop(dst, num, src, count);
+}
+
+__attribute__((target("avx512f"))) double DotAvx512(const double* lhs,
+                                                    const double* rhs,
+                                                    std::size_t count) {
+  return DotLoop(lhs, rhs, count);
+}
+
+#endif  // S21_SIMD_X86
+
+/* Float kernels -----------------------------------------------------------*/
+
+/* The loops are written once and compiled for every level by the wrappers
+ * below, the compiler vectorizes them to the width of the target */
+
+inline __attribute__((always_inline)) void AddFloatLoop(float* dst,
+                                                         const float* src,
+                                                         std::size_t count) {
+  for (std::size_t i = 0; i < count; ++i) dst[i] += src[i];
+}
+
+inline __attribute__((always_inline)) void SubFloatLoop(float* dst,
+                                                         const float* src,
+                                                         std::size_t count) {
+  for (std::size_t i = 0; i < count; ++i) dst[i] -= src[i];
+}
+
+inline __attribute__((always_inline)) void ScaleFloatLoop(float* dst,
+                                                           float num,
+                                                           std::size_t count) {
+  for (std::size_t i = 0; i < count; ++i) dst[i] *= num;
+}
+
+inline __attribute__((always_inline)) bool EqualFloatLoop(const float* lhs,
+                                                           const float* rhs,
+                                                           std::size_t count,
+                                                           float eps) {
+  std::size_t i = 0;
+  while (i + kEqualBlock <= count) {
+    int differ = 0;
+    for (std::size_t end = i + kEqualBlock; i < end; ++i) {
+      differ |= fabsf(lhs[i] - rhs[i]) > eps;
+    }
+    if (differ) return false;
+  }
+  for (; i < count; ++i) {
+    if (fabsf(lhs[i] - rhs[i]) > eps) return false;
+  }
+  return true;
+}
+
+void AddFloat(float* dst, const float* src, std::size_t count) {
+  AddFloatLoop(dst, src, count);
+}
+
+void SubFloat(float* dst, const float* src, std::size_t count) {
+  SubFloatLoop(dst, src, count);
+}
+
+void ScaleFloat(float* dst, float num, std::size_t count) {
+  ScaleFloatLoop(dst, num, count);
+}
+
+bool EqualFloat(const float* lhs, const float* rhs, std::size_t count,
+                float eps) {
+  return EqualFloatLoop(lhs, rhs, count, eps);
+}
+
+#ifdef S21_SIMD_X86
+
+__attribute__((target("avx2"))) void AddFloatAvx2(float* dst,
+                                                  const float* src,
+                                                  std::size_t count) {
+  AddFloatLoop(dst, src, count);
+}
+
+__attribute__((target("avx2"))) void SubFloatAvx2(float* dst,
+                                                  const float* src,
+                                                  std::size_t count) {
+  SubFloatLoop(dst, src, count);
+}
+
+__attribute__((target("avx2"))) void ScaleFloatAvx2(float* dst, float num,
+                                                    std::size_t count) {
+  ScaleFloatLoop(dst, num, count);
+}
+
+__attribute__((target("avx2"))) bool EqualFloatAvx2(const float* lhs,
+                                                    const float* rhs,
+                                                    std::size_t count,
+                                                    float eps) {
+  return EqualFloatLoop(lhs, rhs, count, eps);
+}
+
+__attribute__((target("avx512f"))) void AddFloatAvx512(float* dst,
+                                                       const float* src,
+                                                       std::size_t count) {
+  AddFloatLoop(dst, src, count);
+}
+
+__attribute__((target("avx512f"))) void SubFloatAvx512(float* dst,
+                                                       const float* src,
+                                                       std::size_t count) {
+  SubFloatLoop(dst, src, count);
+}
+
+__attribute__((target("avx512f"))) void ScaleFloatAvx512(float* dst,
+                                                         float num,
+                                                         std::size_t count) {
+  ScaleFloatLoop(dst, num, count);
+}
+
+__attribute__((target("avx512f"))) bool EqualFloatAvx512(const float* lhs,
+                                                         const float* rhs,
+                                                         std::size_t count,
+                                                         float eps) {
+  return EqualFloatLoop(lhs, rhs, count, eps);
+}
+
+#endif  // S21_SIMD_X86
+
+/**
+ * @brief Returns the kernels compiled for 'level'
+ */
+const Kernels& KernelsFor(int level) {
+  static const Kernels kScalar = {
+      AddScalar, SubScalar, ScaleScalar, EqualScalar, TransposeScalar,
+      AxpyScalar, DotScalar, AddFloat,   SubFloat,    ScaleFloat,
+      EqualFloat};
+#ifdef S21_SIMD_X86
+  static const Kernels kSse2 = {
+      AddSse2,    SubSse2,   ScaleSse2, EqualSse2,  TransposeSse2,
+      AxpyScalar, DotScalar, AddFloat,  SubFloat,   ScaleFloat,
+      EqualFloat};
+  static const Kernels kAvx2 = {
+      AddAvx2,  SubAvx2,      ScaleAvx2,    EqualAvx2,      TransposeAvx2,
+      AxpyAvx2, DotAvx2,      AddFloatAvx2, SubFloatAvx2,   ScaleFloatAvx2,
+      EqualFloatAvx2};
+  static const Kernels kAvx512 = {
+      AddAvx512,        SubAvx512,        ScaleAvx512,    EqualAvx512,
+      TransposeAvx512,  AxpyAvx512,       DotAvx512,      AddFloatAvx512,
+      SubFloatAvx512,   ScaleFloatAvx512, EqualFloatAvx512};
+  if (level == SIMD_AVX512) return kAvx512;
+  if (level == SIMD_AVX2) return kAvx2;
+  if (level == SIMD_SSE2) return kSse2;
+#endif
+  return kScalar;
+}
+
+/**
+ * @brief Asks the CPU for the widest supported level
+ */
+int Detect() {
+  int level = SIMD_SCALAR;
+#ifdef S21_SIMD_X86
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("sse2")) level = SIMD_SSE2;
+  if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) {
+    level = SIMD_AVX2;
+  }
+  if (__builtin_cpu_supports("avx512f")) level = SIMD_AVX512;
+#endif
+  return level;
+}
+
+std::atomic<int>& ActiveLevel() {
+  static std::atomic<int> level(S21Simd::DetectedLevel());
+  return level;
+}
+
+const Kernels& Active() {
+  return KernelsFor(ActiveLevel().load(std::memory_order_relaxed));
+}
+
+}  // namespace
+
+/* Dispatch -----------------------------------------------------------------*/
+
+/**
+ * @brief Returns the widest level of 'simd_levels' supported by the CPU
+ */
+int S21Simd::DetectedLevel() {
+  static const int level = Detect();
+  return level;
+}
+
+/**
+ * @brief Returns the level used by the kernels
+ */
+int S21Simd::GetLevel() { return ActiveLevel().load(); }
+
+/**
+ * @brief Forces the kernels of the library to use 'level'
+ * @details Affects the element-wise kernels and the micro-kernel of the
+ * matrix multiplication
+ * @param level - one of 'simd_levels' not wider than DetectedLevel()
+ */
+void S21Simd::SetLevel(int level) {
+  if (level < SIMD_SCALAR || level >= NUMBER_OF_SIMD_LEVELS) {
+    throw std::invalid_argument("Unknown SIMD level");
+  }
+  if (level > DetectedLevel()) {
+    throw std::invalid_argument("The SIMD level is not supported by the CPU");
+  }
+  ActiveLevel().store(level);
+}
+
+/* Kernels ------------------------------------------------------------------*/
+
+/**
+ * @brief dst[i] += src[i] for i in [0, count)
+ */
+void S21Simd::Add(double* dst, const double* src, std::size_t count) {
+  Active().add(dst, src, count);
+}
+
+/**
+ * @brief dst[i] -= src[i] for i in [0, count)
+ */
+void S21Simd::Sub(double* dst, const double* src, std::size_t count) {
+  Active().sub(dst, src, count);
+}
+
+/**
+ * @brief dst[i] *= num for i in [0, count)
+ */
+void S21Simd::Scale(double* dst, double num, std::size_t count) {
+  Active().scale(dst, num, count);
+}
+
+/**
+ * @brief Checks that |lhs[i] - rhs[i]| <= eps for i in [0, count)
+ * @details Differences are accumulated branch-free over blocks of
+ * kEqualBlock elements, the scan stops after the first differing block.
+ * NaN differences compare as equal, like in the scalar comparison.
+ */
+bool S21Simd::Equal(const double* lhs, const double* rhs, std::size_t count,
+                    double eps) {
+  return Active().equal(lhs, rhs, count, eps);
+}
+
+/**
+ * @brief Writes the transpose of a block into another block
+ * @details The rows x cols block at 'src' becomes the cols x rows block at
+ * 'dst'. Full tiles (2 x 2, 4 x 4 or 8 x 8 depending on the level) are
+ * transposed in registers, the edges element by element. Meant for blocks
+ * that fit into the L1 cache, see S21Matrix::Transpose().
+ * @param src, src_rs - first element and row stride of the source block
+ * @param dst, dst_rs - first element and row stride of the destination
+ * @param rows, cols - size of the source block
+ */
+void S21Simd::Transpose(const double* src, std::ptrdiff_t src_rs, double* dst,
+                        std::ptrdiff_t dst_rs, int rows, int cols) {
+  Active().transpose(src, src_rs, dst, dst_rs, rows, cols);
+}
+
+/**
+ * @brief dst[i] += num * src[i] for i in [0, count)
+ */
+void S21Simd::Axpy(double* dst, double num, const double* src,
+                   std::size_t count) {
+  Active().axpy(dst, num, src, count);
+}
+
+/**
+ * @brief Returns the sum of lhs[i] * rhs[i] for i in [0, count)
+ * @details The products are added into kDotLanes partial sums that are
+ * combined pairwise at the end, which is also more accurate than a single
+ * running sum
+ */
+double S21Simd::Dot(const double* lhs, const double* rhs, std::size_t count) {
+  return Active().dot(lhs, rhs, count);
+}
+
+/**
+ * @brief dst[i] += src[i] for i in [0, count), for floats
+ */
+void S21Simd::Add(float* dst, const float* src, std::size_t count) {
+  Active().add_float(dst, src, count);
+}
+
+/**
+ * @brief dst[i] -= src[i] for i in [0, count), for floats
+ */
+void S21Simd::Sub(float* dst, const float* src, std::size_t count) {
+  Active().sub_float(dst, src, count);
+}
+
+/**
+ * @brief dst[i] *= num for i in [0, count), for floats
+ */
+void S21Simd::Scale(float* dst, float num, std::size_t count) {
+  Active().scale_float(dst, num, count);
+}
+
+/**
+ * @brief Checks that |lhs[i] - rhs[i]| <= eps for i in [0, count), for
+ * floats
+ */
+bool S21Simd::Equal(const float* lhs, const float* rhs, std::size_t count,
+                    float eps) {
+  return Active().equal_float(lhs, rhs, count, eps);
+}
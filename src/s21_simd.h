@@ -0,0 +1,68 @@
+/*
+ * Copyright 2023 Gleb Tolstenev
+ * yonnarge@student.21-school.ru
+ *
+ * s21_simd.h is the header file for the vectorized element-wise kernels of
+ * s21_matrix_oop library
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef SRC_S21_SIMD_H_
+#define SRC_S21_SIMD_H_
+
+#include <cstddef>
+
+/**
+ * @brief Instruction set levels of the vectorized kernels
+ */
+enum simd_levels {
+  SIMD_SCALAR = 0,
+  SIMD_SSE2 = 1,
+  SIMD_AVX2 = 2,
+  SIMD_AVX512 = 3,
+  NUMBER_OF_SIMD_LEVELS  // To get amount of elements of enum
+};
+
+/**
+ * @brief Element-wise kernels over contiguous arrays of doubles and floats
+ * @details Every kernel is compiled for each level of 'simd_levels' and
+ * the widest level supported by the CPU is picked on first use, so one
+ * build of the library runs on any x86-64 processor. SetLevel() forces a
+ * lower level, e.g. to compare the results of different paths.
+ */
+class S21Simd {
+ public:
+  static int DetectedLevel();
+  static int GetLevel();
+  static void SetLevel(int level);
+
+  static void Add(double* dst, const double* src, std::size_t count);
+  static void Sub(double* dst, const double* src, std::size_t count);
+  static void Scale(double* dst, double num, std::size_t count);
+  static bool Equal(const double* lhs, const double* rhs, std::size_t count,
+                    double eps);
+  static void Transpose(const double* src, std::ptrdiff_t src_rs, double* dst,
+                        std::ptrdiff_t dst_rs, int rows, int cols);
+  static void Axpy(double* dst, double num, const double* src,
+                   std::size_t count);
+  static double Dot(const double* lhs, const double* rhs, std::size_t count);
+
+  static void Add(float* dst, const float* src, std::size_t count);
+  static void Sub(float* dst, const float* src, std::size_t count);
+  static void Scale(float* dst, float num, std::size_t count);
+  static bool Equal(const float* lhs, const float* rhs, std::size_t count,
+                    float eps);
+};
+
+#endif  // SRC_S21_SIMD_H_
@@ -0,0 +1,356 @@
+/*
+ * Copyright 2023 Gleb Tolstenev
+ * yonnarge@student.21-school.ru
+ *
+ * s21_sparse_matrix.cc is the source code file for the sparse matrix of
+ * s21_matrix_oop library
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "s21_sparse_matrix.h"
+
+#include <algorithm>
+#include <climits>
+#include <numeric>
+#include <utility>
+
+/* Constructors and destructors ---------------------------------------------*/
+
+/**
+ * @brief Sparse matrix without stored elements, all zeros
+ * @param rows - number of rows
+ * @param cols - number of columns
+ */
+S21SparseMatrix::S21SparseMatrix(int rows, int cols)
+    : rows_(rows), cols_(cols), row_offsets_(rows > 0 ? rows + 1 : 0, 0) {
+  if (rows < 1) {
+    throw std::invalid_argument("The number of rows is lower than 1");
+  } else if (cols < 1) {
+    throw std::invalid_argument("The number of columns is lower than 1");
+  }
+}
+
+/**
+ * @brief Sparse matrix from elements given in any order
+ * @details Elements with the same position are added up
+ * @param rows, cols - size of the matrix
+ * @param triplets - the elements
+ */
+S21SparseMatrix::S21SparseMatrix(int rows, int cols,
+                                 const std::vector<Triplet>& triplets)
+    : S21SparseMatrix(rows, cols) {
+  for (const Triplet& triplet : triplets) {
+    CheckIndex(triplet.row, triplet.col);
+    ++row_offsets_[triplet.row + 1];
+  }
+  std::partial_sum(row_offsets_.begin(), row_offsets_.end(),
+                   row_offsets_.begin());
+  std::vector<std::pair<int, double>> elements(triplets.size());
+  std::vector<std::size_t> next(row_offsets_.begin(), row_offsets_.end() - 1);
+  for (const Triplet& triplet : triplets) {
+    elements[next[triplet.row]++] = {triplet.col, triplet.value};
+  }
+
+  col_indices_.reserve(triplets.size());
+  values_.reserve(triplets.size());
+  std::size_t begin = 0;
+  for (int i = 0; i < rows_; ++i) {
+    std::size_t end = row_offsets_[i + 1];
+    std::sort(elements.begin() + begin, elements.begin() + end,
+              [](const std::pair<int, double>& lhs,
+                 const std::pair<int, double>& rhs) {
+                return lhs.first < rhs.first;
+              });
+    row_offsets_[i] = values_.size();
+    for (std::size_t p = begin; p < end; ++p) {
+      if (p > begin && elements[p].first == elements[p - 1].first) {
+        values_.back() += elements[p].second;
+      } else {
+        col_indices_.push_back(elements[p].first);
+        values_.push_back(elements[p].second);
+      }
+    }
+    begin = end;
+  }
+  row_offsets_[rows_] = values_.size();
+}
+
+/**
+ * @brief Sparse matrix from ready CSR arrays, which are checked
+ * @param rows, cols - size of the matrix
+ * @param row_offsets - rows + 1 offsets of the rows, from 0 to the number
+ * of elements
+ * @param col_indices - increasing column indexes within every row
+ * @param values - the elements
+ */
+S21SparseMatrix::S21SparseMatrix(int rows, int cols,
+                                 std::vector<std::size_t> row_offsets,
+                                 std::vector<int> col_indices,
+                                 std::vector<double> values)
+    : S21SparseMatrix(rows, cols) {
+  if (row_offsets.size() != static_cast<std::size_t>(rows) + 1 ||
+      row_offsets.front() != 0 || row_offsets.back() != values.size() ||
+      col_indices.size() != values.size()) {
+    throw std::invalid_argument(
+        "The sizes of the arrays of the sparse matrix do not match");
+  }
+  for (int i = 0; i < rows; ++i) {
+    if (row_offsets[i] > row_offsets[i + 1]) {
+      throw std::invalid_argument(
+          "The row offsets of the sparse matrix are decreasing");
+    }
+    for (std::size_t p = row_offsets[i]; p < row_offsets[i + 1]; ++p) {
+      if (col_indices[p] < 0 || col_indices[p] >= cols ||
+          (p > row_offsets[i] && col_indices[p] <= col_indices[p - 1])) {
+        throw std::invalid_argument(
+            "The column indexes of the sparse matrix are not increasing "
+            "within the range");
+      }
+    }
+  }
+  row_offsets_ = std::move(row_offsets);
+  col_indices_ = std::move(col_indices);
+  values_ = std::move(values);
+}
+
+/**
+ * @brief Stores the nonzero elements of a dense matrix
+ * @param dense - the matrix that will be converted
+ */
+S21SparseMatrix::S21SparseMatrix(const S21Matrix& dense)
+    : S21SparseMatrix(dense.GetRows(), dense.GetCols()) {
+  for (int i = 0; i < rows_; ++i) {
+    const double* row = dense.data() + static_cast<std::ptrdiff_t>(i) *
+                                           dense.stride();
+    for (int j = 0; j < cols_; ++j) {
+      if (row[j] != 0.0) {
+        col_indices_.push_back(j);
+        values_.push_back(row[j]);
+      }
+    }
+    row_offsets_[i + 1] = values_.size();
+  }
+}
+
+/* Overloads ----------------------------------------------------------------*/
+
+S21Matrix S21SparseMatrix::operator*(const S21Matrix& dense) const {
+  return MulDense(dense);
+}
+
+S21SparseMatrix S21SparseMatrix::operator*(
+    const S21SparseMatrix& other) const {
+  return MulSparse(other);
+}
+
+S21Matrix S21SparseMatrix::operator+(const S21Matrix& dense) const {
+  return SumDense(dense);
+}
+
+bool S21SparseMatrix::operator==(const S21SparseMatrix& other) const {
+  return EqMatrix(other);
+}
+
+/**
+ * @brief Overload of '+' for a dense and a sparse matrix
+ * @return Dense matrix with result of addition
+ */
+S21Matrix operator+(const S21Matrix& dense, const S21SparseMatrix& sparse) {
+  return sparse.SumDense(dense);
+}
+
+/* Core methods -------------------------------------------------------------*/
+
+/**
+ * @brief Checks the matrices for equality up to EPS
+ * @details A missing element equals a stored zero
+ */
+bool S21SparseMatrix::EqMatrix(const S21SparseMatrix& other) const {
+  if (rows_ != other.rows_ || cols_ != other.cols_) return false;
+  for (int i = 0; i < rows_; ++i) {
+    std::size_t p = row_offsets_[i], q = other.row_offsets_[i];
+    std::size_t p_end = row_offsets_[i + 1], q_end = other.row_offsets_[i + 1];
+    while (p < p_end || q < q_end) {
+      int col = std::min(p < p_end ? col_indices_[p] : cols_,
+                         q < q_end ? other.col_indices_[q] : cols_);
+      double lhs = p < p_end && col_indices_[p] == col ? values_[p++] : 0.0;
+      double rhs =
+          q < q_end && other.col_indices_[q] == col ? other.values_[q++] : 0.0;
+      if (fabs(lhs - rhs) > EPS) return false;
+    }
+  }
+  return true;
+}
+
+/**
+ * @brief Product of the sparse matrix by a dense one
+ * @details Row i of the result is the sum of the rows of 'dense' picked by
+ * the stored elements of row i, each scaled by its element, so the time is
+ * proportional to the stored elements times dense.GetCols(). Rows of the
+ * result run on S21ThreadPool.
+ * @param dense - the matrix with as many rows as this matrix has columns
+ * @return Dense matrix with the product
+ */
+S21Matrix S21SparseMatrix::MulDense(const S21Matrix& dense) const {
+  if (cols_ != dense.GetRows()) {
+    throw std::logic_error(
+        "The multiplication of matrices was rejected. Matrices have "
+        "different sizes");
+  }
+  int n = dense.GetCols();
+  S21Matrix result(rows_, n, dense.GetResource());
+  const double* b = dense.data();
+  std::ptrdiff_t b_rs = dense.stride();
+  double* c = result.data();
+  std::ptrdiff_t c_rs = result.stride();
+  long work_per_row = static_cast<long>(
+      (GetNonZeros() * static_cast<std::size_t>(n)) / rows_ + 1);
+  S21Matrix::ForEachRow(
+      rows_, static_cast<int>(std::min<long>(work_per_row, INT_MAX)),
+      [&](int begin, int end) {
+        for (int i = begin; i < end; ++i) {
+          double* c_i = c + i * c_rs;
+          for (std::size_t p = row_offsets_[i]; p < row_offsets_[i + 1];
+               ++p) {
+            double value = values_[p];
+            const double* b_k = b + col_indices_[p] * b_rs;
+            for (int j = 0; j < n; ++j) c_i[j] += value * b_k[j];
+          }
+        }
+      });
+  return result;
+}
+
+/**
+ * @brief Product of two sparse matrices (Gustavson's algorithm)
+ * @details Every row of the result is gathered in a dense accumulator of
+ * other.GetCols() elements, only the touched positions are visited
+ * @param other - the matrix with as many rows as this matrix has columns
+ * @return Sparse matrix with the product
+ */
+S21SparseMatrix S21SparseMatrix::MulSparse(
+    const S21SparseMatrix& other) const {
+  if (cols_ != other.rows_) {
+    throw std::logic_error(
+        "The multiplication of matrices was rejected. Matrices have "
+        "different sizes");
+  }
+  S21SparseMatrix result(rows_, other.cols_);
+  std::vector<double> accumulator(other.cols_);
+  std::vector<int> last_row(other.cols_, -1);
+  std::vector<int> touched;
+  for (int i = 0; i < rows_; ++i) {
+    touched.clear();
+    for (std::size_t p = row_offsets_[i]; p < row_offsets_[i + 1]; ++p) {
+      int k = col_indices_[p];
+      for (std::size_t q = other.row_offsets_[k];
+           q < other.row_offsets_[k + 1]; ++q) {
+        int j = other.col_indices_[q];
+        if (last_row[j] != i) {
+          last_row[j] = i;
+          accumulator[j] = 0.0;
+          touched.push_back(j);
+        }
+        accumulator[j] += values_[p] * other.values_[q];
+      }
+    }
+    std::sort(touched.begin(), touched.end());
+    for (int j : touched) {
+      result.col_indices_.push_back(j);
+      result.values_.push_back(accumulator[j]);
+    }
+    result.row_offsets_[i + 1] = result.values_.size();
+  }
+  return result;
+}
+
+/**
+ * @brief Sum of the sparse matrix and a dense one
+ * @param dense - the matrix of the same size
+ * @return Dense matrix with result of addition
+ */
+S21Matrix S21SparseMatrix::SumDense(const S21Matrix& dense) const {
+  S21Matrix::CheckSizesFor(SUM, rows_, cols_, dense.GetRows(),
+                           dense.GetCols());
+  S21Matrix result(dense, dense.GetResource());
+  double* c = result.data();
+  std::ptrdiff_t c_rs = result.stride();
+  for (int i = 0; i < rows_; ++i) {
+    for (std::size_t p = row_offsets_[i]; p < row_offsets_[i + 1]; ++p) {
+      c[i * c_rs + col_indices_[p]] += values_[p];
+    }
+  }
+  return result;
+}
+
+/**
+ * @brief Transposed matrix, which is also the CSC form of this one
+ * @details A counting sort of the elements by column, the rows of the
+ * result come out increasing
+ */
+S21SparseMatrix S21SparseMatrix::Transpose() const {
+  S21SparseMatrix result(cols_, rows_);
+  for (int col : col_indices_) ++result.row_offsets_[col + 1];
+  std::partial_sum(result.row_offsets_.begin(), result.row_offsets_.end(),
+                   result.row_offsets_.begin());
+  result.col_indices_.resize(GetNonZeros());
+  result.values_.resize(GetNonZeros());
+  std::vector<std::size_t> next(result.row_offsets_.begin(),
+                                result.row_offsets_.end() - 1);
+  for (int i = 0; i < rows_; ++i) {
+    for (std::size_t p = row_offsets_[i]; p < row_offsets_[i + 1]; ++p) {
+      std::size_t q = next[col_indices_[p]]++;
+      result.col_indices_[q] = i;
+      result.values_[q] = values_[p];
+    }
+  }
+  return result;
+}
+
+/**
+ * @brief Dense matrix with the same elements
+ */
+S21Matrix S21SparseMatrix::ToDense() const {
+  S21Matrix result(rows_, cols_);
+  double* c = result.data();
+  std::ptrdiff_t c_rs = result.stride();
+  for (int i = 0; i < rows_; ++i) {
+    for (std::size_t p = row_offsets_[i]; p < row_offsets_[i + 1]; ++p) {
+      c[i * c_rs + col_indices_[p]] = values_[p];
+    }
+  }
+  return result;
+}
+
+/* Accessors and mutators ---------------------------------------------------*/
+
+/**
+ * @brief Element (row, col), zero when it is not stored
+ * @details A binary search in the row
+ */
+double S21SparseMatrix::GetVal(int row, int col) const {
+  CheckIndex(row, col);
+  auto begin = col_indices_.begin() + row_offsets_[row];
+  auto end = col_indices_.begin() + row_offsets_[row + 1];
+  auto it = std::lower_bound(begin, end, col);
+  return it != end && *it == col ? values_[it - col_indices_.begin()] : 0.0;
+}
+
+/* Help methods -------------------------------------------------------------*/
+
+void S21SparseMatrix::CheckIndex(int row, int col) const {
+  if (row < 0 || row >= rows_ || col < 0 || col >= cols_)
+    throw std::out_of_range(
+        "Attempt to access to element of matrix by index outside of the range");
+}
@@ -0,0 +1,95 @@
+/*
+ * Copyright 2023 Gleb Tolstenev
+ * yonnarge@student.21-school.ru
+ *
+ * s21_sparse_matrix.h is the header file for the sparse matrix of
+ * s21_matrix_oop library
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef SRC_S21_SPARSE_MATRIX_H_
+#define SRC_S21_SPARSE_MATRIX_H_
+
+#include <cstddef>
+#include <vector>
+
+#include "s21_matrix_oop.h"
+
+/**
+ * @brief Sparse matrix in the compressed sparse row (CSR) format
+ * @details Only the stored elements take memory: the values and column
+ * indexes of row i are at [row_offsets()[i], row_offsets()[i + 1]) of
+ * values() and col_indices(), the indexes of a row are increasing and
+ * never repeat. Every operation takes time in proportion to the stored
+ * elements rather than to rows * cols.
+ *
+ * The compressed sparse column (CSC) form of a matrix is the CSR form of
+ * its transpose, so Transpose() converts between the two.
+ */
+class S21SparseMatrix {
+ public:
+  /**
+   * @brief Element given by its position, see the constructor from
+   * triplets
+   */
+  struct Triplet {
+    int row, col;
+    double value;
+  };
+
+ private:
+  int rows_, cols_;
+  std::vector<std::size_t> row_offsets_;  // rows_ + 1 offsets
+  std::vector<int> col_indices_;
+  std::vector<double> values_;
+
+ private:
+  /* Help methods --------------------------------------------------------*/
+  void CheckIndex(int row, int col) const;
+
+ public:
+  /* Constructors and destructors ----------------------------------------*/
+  S21SparseMatrix(int rows, int cols);
+  S21SparseMatrix(int rows, int cols, const std::vector<Triplet>& triplets);
+  S21SparseMatrix(int rows, int cols, std::vector<std::size_t> row_offsets,
+                  std::vector<int> col_indices, std::vector<double> values);
+  explicit S21SparseMatrix(const S21Matrix& dense);
+
+  /* Overloads -----------------------------------------------------------*/
+  S21Matrix operator*(const S21Matrix& dense) const;
+  S21SparseMatrix operator*(const S21SparseMatrix& other) const;
+  S21Matrix operator+(const S21Matrix& dense) const;
+  bool operator==(const S21SparseMatrix& other) const;
+
+  /* Core methods --------------------------------------------------------*/
+  bool EqMatrix(const S21SparseMatrix& other) const;
+  S21Matrix MulDense(const S21Matrix& dense) const;
+  S21SparseMatrix MulSparse(const S21SparseMatrix& other) const;
+  S21Matrix SumDense(const S21Matrix& dense) const;
+  S21SparseMatrix Transpose() const;
+  S21Matrix ToDense() const;
+
+  /* Accessors and mutators ---------------------------------------------*/
+  int GetRows() const { return rows_; }
+  int GetCols() const { return cols_; }
+  std::size_t GetNonZeros() const { return values_.size(); }
+  double GetVal(int row, int col) const;
+  const std::vector<std::size_t>& row_offsets() const { return row_offsets_; }
+  const std::vector<int>& col_indices() const { return col_indices_; }
+  const std::vector<double>& values() const { return values_; }
+};
+
+S21Matrix operator+(const S21Matrix& dense, const S21SparseMatrix& sparse);
+
+#endif  // SRC_S21_SPARSE_MATRIX_H_
@@ -0,0 +1,289 @@
+/*
+ * Copyright 2023 Gleb Tolstenev
+ * yonnarge@student.21-school.ru
+ *
+ * s21_strassen.cc is the fast matrix multiplication of s21_matrix_oop
+ * library
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "s21_strassen.h"
+
+#include <algorithm>
+#include <new>
+#include <stdexcept>
+
+#include "s21_gemm.h"
+#include "s21_thread_pool.h"
+
+namespace {
+
+/* Doubles in a cache line, every temporary starts on a new line */
+constexpr std::size_t kLine = 8;
+
+/* Additions with fewer elements than this stay on one thread */
+constexpr long kParallelElements = 1L << 16;
+
+/**
+ * @brief Aligned workspace of the whole recursion, allocated once
+ */
+class Workspace {
+ public:
+  explicit Workspace(std::size_t count)
+      : data_(count ? static_cast<double*>(::operator new(
+                          count * sizeof(double), std::align_val_t(kAlign)))
+                    : nullptr) {}
+  Workspace(const Workspace&) = delete;
+  Workspace& operator=(const Workspace&) = delete;
+  ~Workspace() {
+    if (data_) ::operator delete(data_, std::align_val_t(kAlign));
+  }
+
+  double* Get() const { return data_; }
+
+ private:
+  static constexpr std::size_t kAlign = 64;
+  double* data_;
+};
+
+std::size_t Lines(long rows, long cols) {
+  return (static_cast<std::size_t>(rows) * cols + kLine - 1) / kLine * kLine;
+}
+
+bool IsLeaf(int m, int n, int k, int crossover) {
+  return m <= crossover || n <= crossover || k <= crossover;
+}
+
+/**
+ * @brief z = x + y, or z = x - y when Subtract, over a rows x cols block
+ * @details z may be x or y, every element only reads its own position
+ */
+template <bool Subtract>
+void Combine(int rows, int cols, const double* x, std::ptrdiff_t x_rs,
+             const double* y, std::ptrdiff_t y_rs, double* z,
+             std::ptrdiff_t z_rs) {
+  auto body = [=](long begin, long end) {
+    for (long i = begin; i < end; ++i) {
+      const double* x_row = x + i * x_rs;
+      const double* y_row = y + i * y_rs;
+      double* z_row = z + i * z_rs;
+      for (int j = 0; j < cols; ++j) {
+        z_row[j] = Subtract ? x_row[j] - y_row[j] : x_row[j] + y_row[j];
+      }
+    }
+  };
+  if (static_cast<long>(rows) * cols < kParallelElements) {
+    body(0, rows);
+  } else {
+    long grain = std::max(1L, kParallelElements / cols);
+    S21ThreadPool::Instance().ParallelFor(rows, grain, body);
+  }
+}
+
+void Add(int rows, int cols, const double* x, std::ptrdiff_t x_rs,
+         const double* y, std::ptrdiff_t y_rs, double* z, std::ptrdiff_t z_rs) {
+  Combine<false>(rows, cols, x, x_rs, y, y_rs, z, z_rs);
+}
+
+void Sub(int rows, int cols, const double* x, std::ptrdiff_t x_rs,
+         const double* y, std::ptrdiff_t y_rs, double* z, std::ptrdiff_t z_rs) {
+  Combine<true>(rows, cols, x, x_rs, y, y_rs, z, z_rs);
+}
+
+/**
+ * @brief Workspace of Winograd() for a product of the given dimensions
+ */
+std::size_t SerialWorkspace(int m, int n, int k, int crossover) {
+  if (IsLeaf(m, n, k, crossover)) return 0;
+  int hm = m / 2, hn = n / 2, hk = k / 2;
+  return Lines(hm, std::max(hk, hn)) + Lines(hk, hn) +
+         SerialWorkspace(hm, hn, hk, crossover);
+}
+
+/**
+ * @brief Workspace of WinogradParallel() for a product of the given
+ * dimensions
+ */
+std::size_t ParallelWorkspace(int m, int n, int k, int crossover) {
+  int hm = m / 2, hn = n / 2, hk = k / 2;
+  return 4 * Lines(hm, hk) + 4 * Lines(hk, hn) + 3 * Lines(hm, hn) +
+         7 * SerialWorkspace(hm, hn, hk, crossover);
+}
+
+/**
+ * @brief Adds the parts of an odd-sized product left out of the recursion
+ * @details The recursion computed the even mm x nn part of C over the even
+ * kk inner indices. The last inner index is added to that part, the last
+ * column and the last row of C are computed over all inner indices.
+ */
+void Peel(int m, int n, int k, int mm, int nn, int kk, const double* a,
+          std::ptrdiff_t a_rs, const double* b, std::ptrdiff_t b_rs, double* c,
+          std::ptrdiff_t c_rs) {
+  if (k > kk) {
+    S21Gemm(mm, nn, k - kk, 1.0, a + kk, a_rs, 1, b + kk * b_rs, b_rs, 1, 1.0,
+            c, c_rs);
+  }
+  if (n > nn) {
+    S21Gemm(mm, n - nn, k, 1.0, a, a_rs, 1, b + nn, b_rs, 1, 0.0, c + nn,
+            c_rs);
+  }
+  if (m > mm) {
+    S21Gemm(m - mm, n, k, 1.0, a + mm * a_rs, a_rs, 1, b, b_rs, 1, 0.0,
+            c + mm * c_rs, c_rs);
+  }
+}
+
+/**
+ * @brief Strassen-Winograd recursion on the calling thread
+ * @details Follows the schedule of Douglas et al. (GEMMW), which needs only
+ * two temporaries per level: X for the sums of A (and the product P1) and
+ * Y for the sums of B. The other products are computed straight into the
+ * quadrants of C and combined there.
+ * @param work - SerialWorkspace(m, n, k, crossover) elements
+ */
+void Winograd(int m, int n, int k, const double* a, std::ptrdiff_t a_rs,
+              const double* b, std::ptrdiff_t b_rs, double* c,
+              std::ptrdiff_t c_rs, int crossover, double* work) {
+  if (IsLeaf(m, n, k, crossover)) {
+    S21Gemm(m, n, k, 1.0, a, a_rs, 1, b, b_rs, 1, 0.0, c, c_rs);
+    return;
+  }
+  int hm = m / 2, hn = n / 2, hk = k / 2;
+  const double *a11 = a, *a12 = a + hk, *a21 = a + hm * a_rs, *a22 = a21 + hk;
+  const double *b11 = b, *b12 = b + hn, *b21 = b + hk * b_rs, *b22 = b21 + hn;
+  double *c11 = c, *c12 = c + hn, *c21 = c + hm * c_rs, *c22 = c21 + hn;
+  double* x = work;
+  double* y = x + Lines(hm, std::max(hk, hn));
+  double* rest = y + Lines(hk, hn);
+  auto product = [&](const double* p, std::ptrdiff_t p_rs, const double* q,
+                     std::ptrdiff_t q_rs, double* r, std::ptrdiff_t r_rs) {
+    Winograd(hm, hn, hk, p, p_rs, q, q_rs, r, r_rs, crossover, rest);
+  };
+
+  Sub(hm, hk, a11, a_rs, a21, a_rs, x, hk);      // S3 = A11 - A21
+  Sub(hk, hn, b22, b_rs, b12, b_rs, y, hn);      // T3 = B22 - B12
+  product(x, hk, y, hn, c21, c_rs);              // P7 = S3 * T3
+  Add(hm, hk, a21, a_rs, a22, a_rs, x, hk);      // S1 = A21 + A22
+  Sub(hk, hn, b12, b_rs, b11, b_rs, y, hn);      // T1 = B12 - B11
+  product(x, hk, y, hn, c22, c_rs);              // P5 = S1 * T1
+  Sub(hm, hk, x, hk, a11, a_rs, x, hk);          // S2 = S1 - A11
+  Sub(hk, hn, b22, b_rs, y, hn, y, hn);          // T2 = B22 - T1
+  product(x, hk, y, hn, c12, c_rs);              // P6 = S2 * T2
+  Sub(hm, hk, a12, a_rs, x, hk, x, hk);          // S4 = A12 - S2
+  product(x, hk, b22, b_rs, c11, c_rs);          // P3 = S4 * B22
+  product(a11, a_rs, b11, b_rs, x, hn);          // P1 = A11 * B11
+  Add(hm, hn, x, hn, c12, c_rs, c12, c_rs);      // U2 = P1 + P6
+  Add(hm, hn, c12, c_rs, c21, c_rs, c21, c_rs);  // U3 = U2 + P7
+  Add(hm, hn, c12, c_rs, c22, c_rs, c12, c_rs);  // U4 = U2 + P5
+  Add(hm, hn, c21, c_rs, c22, c_rs, c22, c_rs);  // C22 = U3 + P5
+  Add(hm, hn, c12, c_rs, c11, c_rs, c12, c_rs);  // C12 = U4 + P3
+  Sub(hk, hn, y, hn, b21, b_rs, y, hn);          // T4 = T2 - B21
+  product(a22, a_rs, y, hn, c11, c_rs);          // P4 = A22 * T4
+  Sub(hm, hn, c21, c_rs, c11, c_rs, c21, c_rs);  // C21 = U3 - P4
+  product(a12, a_rs, b21, b_rs, c11, c_rs);      // P2 = A12 * B21
+  Add(hm, hn, x, hn, c11, c_rs, c11, c_rs);      // C11 = P1 + P2
+
+  Peel(m, n, k, 2 * hm, 2 * hn, 2 * hk, a, a_rs, b, b_rs, c, c_rs);
+}
+
+/**
+ * @brief First level of the recursion with the seven products running on
+ * S21ThreadPool
+ * @details All the sums of A and B are formed first, so that the products
+ * are independent. Four products go straight into the quadrants of C and
+ * three into temporaries, every product recurses serially in its own part
+ * of the workspace.
+ * @param work - ParallelWorkspace(m, n, k, crossover) elements
+ */
+void WinogradParallel(int m, int n, int k, const double* a,
+                      std::ptrdiff_t a_rs, const double* b,
+                      std::ptrdiff_t b_rs, double* c, std::ptrdiff_t c_rs,
+                      int crossover, double* work) {
+  int hm = m / 2, hn = n / 2, hk = k / 2;
+  const double *a11 = a, *a12 = a + hk, *a21 = a + hm * a_rs, *a22 = a21 + hk;
+  const double *b11 = b, *b12 = b + hn, *b21 = b + hk * b_rs, *b22 = b21 + hn;
+  double *c11 = c, *c12 = c + hn, *c21 = c + hm * c_rs, *c22 = c21 + hn;
+  double *s[4], *t[4], *p[3];
+  for (int i = 0; i < 4; ++i) s[i] = work + i * Lines(hm, hk);
+  work += 4 * Lines(hm, hk);
+  for (int i = 0; i < 4; ++i) t[i] = work + i * Lines(hk, hn);
+  work += 4 * Lines(hk, hn);
+  for (int i = 0; i < 3; ++i) p[i] = work + i * Lines(hm, hn);
+  work += 3 * Lines(hm, hn);
+  std::size_t serial = SerialWorkspace(hm, hn, hk, crossover);
+
+  Add(hm, hk, a21, a_rs, a22, a_rs, s[0], hk);  // S1 = A21 + A22
+  Sub(hm, hk, s[0], hk, a11, a_rs, s[1], hk);   // S2 = S1 - A11
+  Sub(hm, hk, a11, a_rs, a21, a_rs, s[2], hk);  // S3 = A11 - A21
+  Sub(hm, hk, a12, a_rs, s[1], hk, s[3], hk);   // S4 = A12 - S2
+  Sub(hk, hn, b12, b_rs, b11, b_rs, t[0], hn);  // T1 = B12 - B11
+  Sub(hk, hn, b22, b_rs, t[0], hn, t[1], hn);   // T2 = B22 - T1
+  Sub(hk, hn, b22, b_rs, b12, b_rs, t[2], hn);  // T3 = B22 - B12
+  Sub(hk, hn, t[1], hn, b21, b_rs, t[3], hn);   // T4 = T2 - B21
+
+  struct Product {
+    const double* lhs;
+    std::ptrdiff_t lhs_rs;
+    const double* rhs;
+    std::ptrdiff_t rhs_rs;
+    double* result;
+    std::ptrdiff_t result_rs;
+  };
+  const Product products[7] = {
+      {a11, a_rs, b11, b_rs, p[0], hn},   // P1 = A11 * B11
+      {a12, a_rs, b21, b_rs, c11, c_rs},  // P2 = A12 * B21
+      {s[3], hk, b22, b_rs, c12, c_rs},   // P3 = S4 * B22
+      {a22, a_rs, t[3], hn, c21, c_rs},   // P4 = A22 * T4
+      {s[0], hk, t[0], hn, c22, c_rs},    // P5 = S1 * T1
+      {s[1], hk, t[1], hn, p[1], hn},     // P6 = S2 * T2
+      {s[2], hk, t[2], hn, p[2], hn}};    // P7 = S3 * T3
+  S21ThreadPool::Instance().ParallelFor(7, 1, [&](long begin, long end) {
+    for (long i = begin; i < end; ++i) {
+      const Product& product = products[i];
+      Winograd(hm, hn, hk, product.lhs, product.lhs_rs, product.rhs,
+               product.rhs_rs, product.result, product.result_rs, crossover,
+               work + i * serial);
+    }
+  });
+
+  Add(hm, hn, p[0], hn, p[1], hn, p[1], hn);     // U2 = P1 + P6
+  Add(hm, hn, c11, c_rs, p[0], hn, c11, c_rs);   // C11 = P2 + P1
+  Add(hm, hn, p[1], hn, p[2], hn, p[2], hn);     // U3 = U2 + P7
+  Add(hm, hn, c12, c_rs, p[1], hn, c12, c_rs);   // P3 + U2
+  Add(hm, hn, c12, c_rs, c22, c_rs, c12, c_rs);  // C12 = P3 + U2 + P5
+  Sub(hm, hn, p[2], hn, c21, c_rs, c21, c_rs);   // C21 = U3 - P4
+  Add(hm, hn, c22, c_rs, p[2], hn, c22, c_rs);   // C22 = P5 + U3
+
+  Peel(m, n, k, 2 * hm, 2 * hn, 2 * hk, a, a_rs, b, b_rs, c, c_rs);
+}
+
+}  // namespace
+
+void S21Strassen(int m, int n, int k, const double* a, std::ptrdiff_t a_rs,
+                 const double* b, std::ptrdiff_t b_rs, double* c,
+                 std::ptrdiff_t c_rs, int crossover) {
+  if (crossover < 1) {
+    throw std::invalid_argument("The crossover size is lower than 1");
+  }
+  if (IsLeaf(m, n, k, crossover)) {
+    S21Gemm(m, n, k, 1.0, a, a_rs, 1, b, b_rs, 1, 0.0, c, c_rs);
+  } else if (S21ThreadPool::Instance().GetNumThreads() > 1) {
+    Workspace work(ParallelWorkspace(m, n, k, crossover));
+    WinogradParallel(m, n, k, a, a_rs, b, b_rs, c, c_rs, crossover,
+                     work.Get());
+  } else {
+    Workspace work(SerialWorkspace(m, n, k, crossover));
+    Winograd(m, n, k, a, a_rs, b, b_rs, c, c_rs, crossover, work.Get());
+  }
+}
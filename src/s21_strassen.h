@@ -0,0 +1,58 @@
+/*
+ * Copyright 2023 Gleb Tolstenev
+ * yonnarge@student.21-school.ru
+ *
+ * s21_strassen.h is the header file for the fast matrix multiplication of
+ * s21_matrix_oop library
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef SRC_S21_STRASSEN_H_
+#define SRC_S21_STRASSEN_H_
+
+#include <cstddef>
+
+/* Products with a dimension up to this size are left to S21Gemm */
+constexpr int kStrassenCrossover = 1024;
+
+/**
+ * @brief Computes C = A * B by the Strassen-Winograd recursion
+ * @details Every level splits the operands into quadrants and replaces
+ * eight products of quadrants by seven and fifteen additions. The recursion
+ * stops when a dimension is not larger than 'crossover' and the rest is
+ * multiplied by S21Gemm. Odd dimensions are peeled: the even part goes
+ * down the recursion and the last row, column or inner index is added by
+ * S21Gemm, so nothing is padded.
+ *
+ * The workspace is allocated once, before the recursion. Serially every
+ * level needs two quadrant-sized temporaries, less than
+ * (m * max(k, n) + k * n) / 3 elements in total. With several threads in
+ * S21ThreadPool the seven products of the first level run in parallel,
+ * which keeps eight operand and three product quadrants alive at once:
+ * about 4 * n * n elements for square products.
+ *
+ * Every level multiplies the error bound by a constant, so the result is
+ * close to, not equal to, the one of S21Gemm; the difference grows with
+ * the depth of the recursion.
+ * @param m, n, k - dimensions of the product
+ * @param a, a_rs - first element and row stride of the row-major A (m x k)
+ * @param b, b_rs - first element and row stride of the row-major B (k x n)
+ * @param c, c_rs - first element and row stride of the row-major C (m x n)
+ * @param crossover - largest dimension multiplied by S21Gemm, at least 1
+ */
+void S21Strassen(int m, int n, int k, const double* a, std::ptrdiff_t a_rs,
+                 const double* b, std::ptrdiff_t b_rs, double* c,
+                 std::ptrdiff_t c_rs, int crossover = kStrassenCrossover);
+
+#endif  // SRC_S21_STRASSEN_H_
@@ -0,0 +1,245 @@
+/*
+ * Copyright 2023 Gleb Tolstenev
+ * yonnarge@student.21-school.ru
+ *
+ * s21_thread_pool.cc is the source code file for the thread pool of
+ * s21_matrix_oop library
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "s21_thread_pool.h"
+
+#include <algorithm>
+#include <exception>
+#include <stdexcept>
+
+namespace {
+
+/* Set while the current thread executes a task of the pool */
+thread_local bool in_pool_task = false;
+
+/* Upper bound of chunks per thread in one parallel loop */
+constexpr long kChunksPerThread = 8;
+
+}  // namespace
+
+/**
+ * @brief State of one parallel loop, lives on the stack of its caller
+ */
+struct S21ThreadPool::Job {
+  const RangeFunction* body;
+  std::atomic<long> remaining;
+  std::mutex error_mutex;
+  std::exception_ptr error;
+};
+
+/* Constructors and destructors ---------------------------------------------*/
+
+/**
+ * @brief Creates a pool sized to the number of hardware threads
+ */
+S21ThreadPool::S21ThreadPool() : queued_(0), stop_(false) {
+  unsigned hardware = std::thread::hardware_concurrency();
+  num_threads_ = hardware > 0 ? static_cast<int>(hardware) : 1;
+}
+
+/**
+ * @brief Destructor, joins the workers
+ */
+S21ThreadPool::~S21ThreadPool() { Stop(); }
+
+/**
+ * @brief Returns the pool used by the library
+ */
+S21ThreadPool &S21ThreadPool::Instance() {
+  static S21ThreadPool pool;
+  return pool;
+}
+
+/* Configuration ------------------------------------------------------------*/
+
+/**
+ * @brief Sets the number of threads taking part in parallel loops
+ * @details 1 makes every operation serial. Running workers are joined and
+ * the new ones are started on the next parallel loop.
+ * @param num_threads - number of threads including the calling one
+ */
+void S21ThreadPool::SetNumThreads(int num_threads) {
+  if (num_threads < 1) {
+    throw std::invalid_argument("The number of threads is lower than 1");
+  }
+  std::unique_lock<std::shared_mutex> lock(config_mutex_);
+  if (num_threads != num_threads_) {
+    Stop();
+    num_threads_ = num_threads;
+  }
+}
+
+/**
+ * @brief Starts num_threads_ - 1 workers with empty deques
+ */
+void S21ThreadPool::Start() {
+  stop_ = false;
+  int count = num_threads_ - 1;
+  for (int i = 0; i < count; ++i) {
+    workers_.push_back(std::make_unique<Worker>());
+  }
+  for (int i = 0; i < count; ++i) {
+    threads_.emplace_back(&S21ThreadPool::WorkerLoop, this, i);
+  }
+}
+
+/**
+ * @brief Wakes and joins all workers
+ */
+void S21ThreadPool::Stop() {
+  {
+    std::lock_guard<std::mutex> lock(sleep_mutex_);
+    stop_ = true;
+  }
+  wake_up_.notify_all();
+  for (auto &thread : threads_) thread.join();
+  threads_.clear();
+  workers_.clear();
+}
+
+/* Parallel loops -----------------------------------------------------------*/
+
+/**
+ * @brief Calls body on disjoint subranges that cover [0, count)
+ * @details Subranges hold at least 'grain' iterations. The call returns when
+ * all of them have finished and rethrows the first exception thrown by body.
+ * @param count - number of iterations
+ * @param grain - minimal number of iterations worth sending to a thread
+ * @param body - function called with the bounds [begin, end) of a subrange
+ */
+void S21ThreadPool::ParallelFor(long count, long grain,
+                                const RangeFunction &body) {
+  if (count <= 0) return;
+  if (grain < 1) grain = 1;
+  int threads = num_threads_;
+  if (in_pool_task || threads < 2 || count <= grain) {
+    body(0, count);
+    return;
+  }
+  {
+    std::unique_lock<std::shared_mutex> lock(config_mutex_);
+    if (threads_.empty() && num_threads_ > 1) Start();
+  }
+
+  std::shared_lock<std::shared_mutex> lock(config_mutex_);
+  int num_workers = static_cast<int>(workers_.size());
+  if (num_workers == 0) {
+    body(0, count);
+    return;
+  }
+  long max_chunks = kChunksPerThread * (num_workers + 1);
+  long chunks = std::min((count + grain - 1) / grain, max_chunks);
+  long chunk = (count + chunks - 1) / chunks;
+  chunks = (count + chunk - 1) / chunk;
+
+  Job job;
+  job.body = &body;
+  job.remaining = chunks;
+  for (long i = 0; i < chunks; ++i) {
+    Worker &worker = *workers_[i % num_workers];
+    std::lock_guard<std::mutex> worker_lock(worker.mutex);
+    worker.tasks.push_back(
+        {&job, i * chunk, std::min(count, (i + 1) * chunk)});
+  }
+  {
+    std::lock_guard<std::mutex> sleep_lock(sleep_mutex_);
+    queued_ += chunks;
+  }
+  wake_up_.notify_all();
+
+  Task task;
+  while (job.remaining.load(std::memory_order_acquire) > 0) {
+    if (StealTask(-1, &task)) {
+      RunTask(task);
+    } else {
+      std::this_thread::yield();
+    }
+  }
+  if (job.error) std::rethrow_exception(job.error);
+}
+
+/* Workers ------------------------------------------------------------------*/
+
+/**
+ * @brief Main loop of a worker: run own tasks, steal, otherwise sleep
+ * @param index - index of the worker and its deque
+ */
+void S21ThreadPool::WorkerLoop(int index) {
+  Task task;
+  while (true) {
+    if (PopTask(index, &task) || StealTask(index, &task)) {
+      RunTask(task);
+      continue;
+    }
+    std::unique_lock<std::mutex> lock(sleep_mutex_);
+    wake_up_.wait(lock, [this] { return stop_ || queued_ > 0; });
+    if (stop_ && queued_ == 0) return;
+  }
+}
+
+/**
+ * @brief Takes the most recently pushed task from the own deque
+ */
+bool S21ThreadPool::PopTask(int index, Task *task) {
+  Worker &worker = *workers_[index];
+  std::lock_guard<std::mutex> lock(worker.mutex);
+  if (worker.tasks.empty()) return false;
+  *task = worker.tasks.back();
+  worker.tasks.pop_back();
+  --queued_;
+  return true;
+}
+
+/**
+ * @brief Takes the oldest task from the deque of another worker
+ * @param thief - index of the stealing worker, -1 for the calling thread
+ */
+bool S21ThreadPool::StealTask(int thief, Task *task) {
+  int count = static_cast<int>(workers_.size());
+  for (int i = 1; i <= count; ++i) {
+    int victim = (thief + i + count) % count;
+    if (victim == thief) continue;
+    Worker &worker = *workers_[victim];
+    std::lock_guard<std::mutex> lock(worker.mutex);
+    if (!worker.tasks.empty()) {
+      *task = worker.tasks.front();
+      worker.tasks.pop_front();
+      --queued_;
+      return true;
+    }
+  }
+  return false;
+}
+
+/**
+ * @brief Runs one chunk of a loop and reports its completion
+ */
+void S21ThreadPool::RunTask(const Task &task) {
+  Job *job = task.job;
+  in_pool_task = true;
+  try {
+    (*job->body)(task.begin, task.end);
+  } catch (...) {
+    std::lock_guard<std::mutex> lock(job->error_mutex);
+    if (!job->error) job->error = std::current_exception();
+  }
+  in_pool_task = false;
+  job->remaining.fetch_sub(1, std::memory_order_release);
+}
@@ -0,0 +1,88 @@
+/*
+ * Copyright 2023 Gleb Tolstenev
+ * yonnarge@student.21-school.ru
+ *
+ * s21_thread_pool.h is the header file for the thread pool of
+ * s21_matrix_oop library
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef SRC_S21_THREAD_POOL_H_
+#define SRC_S21_THREAD_POOL_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Work-stealing thread pool shared by all matrix operations
+ * @details Every worker owns a deque of tasks. A parallel loop spreads its
+ * chunks over the deques, each worker pops from the back of its own deque
+ * and steals from the front of the others when it runs dry. The calling
+ * thread takes part in the loop too, so a pool of N threads starts N - 1
+ * workers. Workers are started lazily on the first parallel loop. Loops
+ * started from inside a task run serially on the calling worker.
+ */
+class S21ThreadPool {
+ public:
+  using RangeFunction = std::function<void(long begin, long end)>;
+
+  static S21ThreadPool& Instance();
+
+  S21ThreadPool(const S21ThreadPool&) = delete;
+  S21ThreadPool& operator=(const S21ThreadPool&) = delete;
+  ~S21ThreadPool();
+
+  void SetNumThreads(int num_threads);
+  int GetNumThreads() const { return num_threads_; }
+
+  void ParallelFor(long count, long grain, const RangeFunction& body);
+
+ private:
+  struct Job;
+  struct Task {
+    Job* job;
+    long begin, end;
+  };
+  struct Worker {
+    std::mutex mutex;
+    std::deque<Task> tasks;
+  };
+
+  S21ThreadPool();
+
+  void Start();
+  void Stop();
+  void WorkerLoop(int index);
+  bool PopTask(int index, Task* task);
+  bool StealTask(int thief, Task* task);
+  void RunTask(const Task& task);
+
+  std::atomic<int> num_threads_;
+  std::vector<std::unique_ptr<Worker>> workers_;
+  std::vector<std::thread> threads_;
+  std::shared_mutex config_mutex_;  // Loops share it, resizing is exclusive
+  std::mutex sleep_mutex_;
+  std::condition_variable wake_up_;
+  std::atomic<long> queued_;
+  bool stop_;
+};
+
+#endif  // SRC_S21_THREAD_POOL_H_
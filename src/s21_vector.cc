@@ -0,0 +1,345 @@
+/*
+ * Copyright 2023 Gleb Tolstenev
+ * yonnarge@student.21-school.ru
+ *
+ * s21_vector.cc is the source code file for the vector of s21_matrix_oop
+ * library
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "s21_vector.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#include "s21_simd.h"
+#include "s21_thread_pool.h"
+
+namespace {
+
+/* Products over fewer matrix elements than this stay serial */
+constexpr long kParallelElements = 1L << 16;
+
+/* Elements of y updated together by the transposed product, they stay in
+ * L1 while the rows of the matrix stream past them */
+constexpr int kTransposedColumns = 512;
+
+}  // namespace
+
+/* Constructors and destructors ---------------------------------------------*/
+
+/**
+ * @brief Creates a vector of zeros
+ * @param size - number of elements
+ * @param resource - memory resource for the elements
+ */
+S21Vector::S21Vector(int size, std::pmr::memory_resource* resource) {
+  if (size < 1) {
+    throw std::invalid_argument("The size of the vector is lower than 1");
+  } else if (!resource) {
+    throw std::invalid_argument("The memory resource is null");
+  }
+  size_ = size;
+  resource_ = resource;
+  vector_ = NewArrayOfElements(size);
+}
+
+/**
+ * @brief Copies the elements of a matrix with one column or one row
+ * @param matrix - n x 1 or 1 x n matrix
+ * @param resource - memory resource for the elements
+ */
+S21Vector::S21Vector(const S21Matrix& matrix,
+                     std::pmr::memory_resource* resource)
+    : S21Vector(std::max(matrix.GetRows(), matrix.GetCols()), resource) {
+  if (matrix.GetCols() == 1) {
+    for (int i = 0; i < size_; ++i) vector_[i] = matrix.GetVal(i, 0);
+  } else if (matrix.GetRows() == 1) {
+    std::memcpy(vector_, matrix.data(), size_ * sizeof(double));
+  } else {
+    throw std::invalid_argument("The matrix is neither a row nor a column");
+  }
+}
+
+/**
+ * @brief Copy constructor
+ * @details The copy takes its storage from the default resource, like the
+ * copies of S21Matrix. A copy of a moved-from vector is empty as well.
+ * @param other - the vector that will be copied
+ */
+S21Vector::S21Vector(const S21Vector& other)
+    : size_(other.size_),
+      resource_(std::pmr::get_default_resource()),
+      vector_(other.vector_ ? NewArrayOfElements(other.size_) : nullptr) {
+  if (vector_) std::memcpy(vector_, other.vector_, size_ * sizeof(double));
+}
+
+/**
+ * @brief Move constructor, takes over the storage and its resource
+ * @param other - the vector that will be moved, it is left empty
+ */
+S21Vector::S21Vector(S21Vector&& other) noexcept
+    : size_(other.size_), resource_(other.resource_), vector_(other.vector_) {
+  other.size_ = 0;
+  other.resource_ = std::pmr::get_default_resource();
+  other.vector_ = nullptr;
+}
+
+/**
+ * @brief Destructor
+ */
+S21Vector::~S21Vector() { DeleteArrayOfElements(); }
+
+/* Memory management functions ----------------------------------------------*/
+
+/**
+ * @brief Allocates a zero-initialized block of 'size' elements
+ */
+double* S21Vector::NewArrayOfElements(int size) const {
+  std::size_t bytes = static_cast<std::size_t>(size) * sizeof(double);
+  auto elements = static_cast<double*>(
+      resource_->allocate(bytes, S21Matrix::kAlignment));
+  S21_INSTRUMENT_ALLOCATION(bytes);
+  std::memset(elements, 0, bytes);
+  return elements;
+}
+
+/**
+ * @brief Releases the elements, must be called before size_ changes
+ */
+void S21Vector::DeleteArrayOfElements() {
+  if (vector_) {
+    resource_->deallocate(vector_, size_ * sizeof(double),
+                          S21Matrix::kAlignment);
+  }
+}
+
+/* Overloads ----------------------------------------------------------------*/
+
+/**
+ * @brief Copy assignment, reuses the storage when the sizes match
+ * @details Assigning a moved-from vector releases the storage and leaves
+ * the vector empty too
+ * @param other - the vector that will be assigned
+ */
+S21Vector& S21Vector::operator=(const S21Vector& other) {
+  if (this != &other) {
+    if (!other.vector_) {
+      DeleteArrayOfElements();
+      size_ = 0;
+      vector_ = nullptr;
+    } else if (size_ != other.size_ || !vector_) {
+      double* elements = NewArrayOfElements(other.size_);
+      DeleteArrayOfElements();
+      size_ = other.size_;
+      vector_ = elements;
+    }
+    if (vector_) std::memcpy(vector_, other.vector_, size_ * sizeof(double));
+  }
+  return *this;
+}
+
+/**
+ * @brief Move assignment, takes over the storage and its resource
+ * @param other - the vector that will be moved, it is left empty
+ */
+S21Vector& S21Vector::operator=(S21Vector&& other) noexcept {
+  if (this != &other) {
+    DeleteArrayOfElements();
+    size_ = other.size_;
+    resource_ = other.resource_;
+    vector_ = other.vector_;
+    other.size_ = 0;
+    other.resource_ = std::pmr::get_default_resource();
+    other.vector_ = nullptr;
+  }
+  return *this;
+}
+
+/**
+ * @brief Adds another vector of the same size
+ */
+S21Vector& S21Vector::operator+=(const S21Vector& other) {
+  if (size_ != other.size_) {
+    throw std::logic_error(
+        "The addition was rejected. Vectors have different sizes");
+  }
+  S21Simd::Add(vector_, other.vector_, size_);
+  return *this;
+}
+
+/**
+ * @brief Subtracts another vector of the same size
+ */
+S21Vector& S21Vector::operator-=(const S21Vector& other) {
+  if (size_ != other.size_) {
+    throw std::logic_error(
+        "The subtraction was rejected. Vectors have different sizes");
+  }
+  S21Simd::Sub(vector_, other.vector_, size_);
+  return *this;
+}
+
+/**
+ * @brief Multiplies every element by a number
+ */
+S21Vector& S21Vector::operator*=(const double num) {
+  S21Simd::Scale(vector_, num, size_);
+  return *this;
+}
+
+/**
+ * @brief Checks vectors for equality, see EqVector()
+ */
+bool S21Vector::operator==(const S21Vector& other) const {
+  return EqVector(other);
+}
+
+/**
+ * @brief Element of the vector
+ * @param index - position in [0, GetSize())
+ */
+double& S21Vector::operator()(int index) {
+  if (index < 0 || index >= size_) {
+    throw std::out_of_range(
+        "Attempt to access to element of vector by index outside of the range");
+  }
+  return vector_[index];
+}
+
+double S21Vector::operator()(int index) const {
+  if (index < 0 || index >= size_) {
+    throw std::out_of_range(
+        "Attempt to access to element of vector by index outside of the range");
+  }
+  return vector_[index];
+}
+
+/* Core methods -------------------------------------------------------------*/
+
+/**
+ * @brief Checks that the sizes match and the elements differ by EPS at most
+ */
+bool S21Vector::EqVector(const S21Vector& other) const {
+  return size_ == other.size_ &&
+         S21Simd::Equal(vector_, other.vector_, size_, EPS);
+}
+
+/**
+ * @brief Adds alpha * x to the vector
+ */
+void S21Vector::Axpy(double alpha, const S21Vector& x) {
+  if (size_ != x.size_) {
+    throw std::logic_error(
+        "The addition was rejected. Vectors have different sizes");
+  }
+  S21Simd::Axpy(vector_, alpha, x.vector_, size_);
+}
+
+/**
+ * @brief Returns the dot product with another vector of the same size
+ */
+double S21Vector::Dot(const S21Vector& other) const {
+  if (size_ != other.size_) {
+    throw std::logic_error(
+        "The dot product was rejected. Vectors have different sizes");
+  }
+  return S21Simd::Dot(vector_, other.vector_, size_);
+}
+
+/**
+ * @brief Returns the Euclidean norm of the vector
+ */
+double S21Vector::Norm() const { return sqrt(Dot(*this)); }
+
+/**
+ * @brief Computes the vector as alpha * op(A) * x + beta * it
+ * @details op(A) is A or, when 'transpose_a' is set, A transposed; both are
+ * read row by row, so the matrix is streamed from memory once. Without the
+ * transpose every element is a dot product of a row of A with x. With it
+ * the rows of A scaled by the elements of x are added to kTransposedColumns
+ * elements of the vector at a time. Large matrices are split between the
+ * threads of S21ThreadPool by rows or by those column ranges. When beta is 0
+ * the previous elements are never read. x may be the vector itself; it is
+ * then copied first.
+ * @param alpha - scale of the product
+ * @param a, transpose_a - the matrix, op(A) has as many rows as the vector
+ * @param x - vector with as many elements as op(A) has columns
+ * @param beta - scale of the current elements
+ */
+void S21Vector::Gemv(double alpha, const S21Matrix& a, bool transpose_a,
+                     const S21Vector& x, double beta) {
+  int m = transpose_a ? a.GetCols() : a.GetRows();
+  int k = transpose_a ? a.GetRows() : a.GetCols();
+  if (x.size_ != k || size_ != m) {
+    throw std::logic_error(
+        "The matrix-vector product was rejected. Sizes do not match");
+  }
+  if (&x == this) {
+    S21Vector copy(x);
+    Gemv(alpha, a, transpose_a, copy, beta);
+    return;
+  }
+
+  S21_INSTRUMENT(INSTRUMENT_GEMV, 2.0 * m * k,
+                 8.0 * (static_cast<double>(m) * k + k + 2.0 * m));
+  const double* a_data = a.data();
+  std::ptrdiff_t a_rs = a.stride();
+  const double* x_data = x.vector_;
+  double* y = vector_;
+  auto rows = [=](long begin, long end) {
+    for (long i = begin; i < end; ++i) {
+      double dot = S21Simd::Dot(a_data + i * a_rs, x_data,
+                                static_cast<std::size_t>(k));
+      y[i] = beta == 0.0 ? alpha * dot : alpha * dot + beta * y[i];
+    }
+  };
+  auto columns = [=](long begin, long end) {
+    int je = std::min(static_cast<int>(end) * kTransposedColumns, m);
+    for (int jb = static_cast<int>(begin) * kTransposedColumns; jb < je;
+         jb += kTransposedColumns) {
+      std::size_t width = std::min(kTransposedColumns, je - jb);
+      if (beta == 0.0) {
+        std::fill(y + jb, y + jb + width, 0.0);
+      } else if (beta != 1.0) {
+        S21Simd::Scale(y + jb, beta, width);
+      }
+      for (int i = 0; i < k; ++i) {
+        S21Simd::Axpy(y + jb, alpha * x_data[i], a_data + i * a_rs + jb,
+                      width);
+      }
+    }
+  };
+  long blocks = (m + kTransposedColumns - 1) / kTransposedColumns;
+  if (static_cast<long>(m) * k < kParallelElements) {
+    transpose_a ? columns(0, blocks) : rows(0, m);
+  } else if (!transpose_a) {
+    S21ThreadPool::Instance().ParallelFor(
+        m, std::max(1L, kParallelElements / k), rows);
+  } else {
+    S21ThreadPool::Instance().ParallelFor(
+        blocks, std::max(1L, kParallelElements / kTransposedColumns / k),
+        columns);
+  }
+}
+
+/**
+ * @brief Copies the vector into a matrix with one column
+ */
+S21Matrix S21Vector::ToMatrix() const {
+  S21Matrix result(size_, 1, resource_);
+  for (int i = 0; i < size_; ++i) result(i, 0) = vector_[i];
+  return result;
+}
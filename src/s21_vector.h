@@ -0,0 +1,83 @@
+/*
+ * Copyright 2023 Gleb Tolstenev
+ * yonnarge@student.21-school.ru
+ *
+ * s21_vector.h is the header file for the vector of s21_matrix_oop library
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef SRC_S21_VECTOR_H_
+#define SRC_S21_VECTOR_H_
+
+#include <cstddef>
+#include <memory_resource>
+
+#include "s21_matrix_oop.h"
+
+/**
+ * @brief Dense vector of doubles
+ * @details The elements are one contiguous block aligned to
+ * S21Matrix::kAlignment and allocated from a memory resource, like the
+ * storage of S21Matrix. Use it instead of an n x 1 matrix: Gemv() and
+ * S21Matrix::Ger() stream the matrix once through the SIMD kernels of
+ * S21Simd and split large matrices between the threads of S21ThreadPool.
+ */
+class S21Vector {
+ private:
+  int size_;
+  std::pmr::memory_resource* resource_;  // Source of the elements buffer
+  double* vector_;
+
+  /* Memory management functions -----------------------------------------*/
+  double* NewArrayOfElements(int size) const;
+  void DeleteArrayOfElements();
+
+ public:
+  /* Constructors and destructors ----------------------------------------*/
+  explicit S21Vector(int size, std::pmr::memory_resource* resource =
+                                   std::pmr::get_default_resource());
+  explicit S21Vector(const S21Matrix& matrix,
+                     std::pmr::memory_resource* resource =
+                         std::pmr::get_default_resource());
+  S21Vector(const S21Vector& other);
+  S21Vector(S21Vector&& other) noexcept;
+  ~S21Vector();
+
+  /* Overloads -----------------------------------------------------------*/
+  S21Vector& operator=(const S21Vector& other);
+  S21Vector& operator=(S21Vector&& other) noexcept;
+  S21Vector& operator+=(const S21Vector& other);
+  S21Vector& operator-=(const S21Vector& other);
+  S21Vector& operator*=(const double num);
+  bool operator==(const S21Vector& other) const;
+  double& operator()(int index);
+  double operator()(int index) const;
+
+  /* Core methods --------------------------------------------------------*/
+  bool EqVector(const S21Vector& other) const;
+  void Axpy(double alpha, const S21Vector& x);
+  double Dot(const S21Vector& other) const;
+  double Norm() const;
+  void Gemv(double alpha, const S21Matrix& a, bool transpose_a,
+            const S21Vector& x, double beta);
+  S21Matrix ToMatrix() const;
+
+  /* Accessors and mutators ---------------------------------------------*/
+  int GetSize() const { return size_; }
+  double* data() { return vector_; }
+  const double* data() const { return vector_; }
+  std::pmr::memory_resource* GetResource() const { return resource_; }
+};
+
+#endif  // SRC_S21_VECTOR_H_